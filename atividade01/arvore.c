@@ -0,0 +1,684 @@
+/*
+ * Instituição: Universidade Federal da Paraíba
+ * Disciplina: Sistemas Operacionais I
+ * Unidade 1 - Atividade 1
+ *
+ * Autor: Rodrigo Monteiro Fortes de Oliveira, 20240097664
+ *
+ * Nome do Programa: arvore.c
+ *
+ * Descrição:
+ *     Generaliza a árvore da Atividade 1 (P1 -> F1, F2 -> N1..N4): a
+ *     forma da árvore vem de um arquivo de configuração (-a) ou é uma
+ *     árvore completa de profundidade -p e grau -g cujas folhas executam
+ *     o comando -c. Cada nó interno é um processo, criado com fork() pelo
+ *     pai, que cria os próprios filhos e os aguarda (como criarFilho);
+ *     cada folha executa um comando, lançado pelo mecanismo de -l (ver
+ *     lancador.h), como criarNeto.
+ *
+ *     Cada processo da árvore coleta os filhos com o supervisor de
+ *     supervisor.h (pidfds em um epoll), na ordem em que terminarem. A
+ *     saída padrão e a de erros de cada folha são capturadas por pipes e
+ *     movidas com splice: para buffers em memória, exibidos inteiros
+ *     quando a folha termina, ou com -o para diretorio/nome.saida e
+ *     nome.erros. Uma folha que passar do prazo (-T, ou limite= na
+ *     linha) é encerrada com SIGKILL e conta como falha.
+ *
+ *     No arquivo, cada linha descreve um nó ('#' inicia comentário):
+ *
+ *         nome  pai  [apos=irmão1,irmão2]  [limite=ms]  [/caminho/comando [argumentos]]
+ *
+ *     O nome identifica o nó no rastro, na saída capturada e nos arquivos
+ *     de -o: deve ser único e usar só letras, dígitos, '.', '_' e '-'
+ *     (sem começar por '.' ou '-'). Na árvore gerada por -p/-g o nome
+ *     traz o caminho desde a raiz: I1.0 é o primeiro filho do lançador e
+ *     F2.0.1 o segundo filho de I1.0.
+ *
+ *     O pai "-" é o próprio lançador. Sem comando o nó é interno. Com
+ *     apos= o nó só começa depois que os irmãos citados (declarados
+ *     antes, com o mesmo pai) terminarem: cada grupo de irmãos é um DAG,
+ *     e a ordem do arquivo já é uma ordem topológica.
+ *
+ *     -j limita as folhas em execução ao mesmo tempo na árvore inteira
+ *     (padrão: uma por núcleo), com um semáforo em memória
+ *     compartilhada: o processo que quer lançar uma folha toma uma vaga
+ *     e a devolve ao coletá-la. Um nó que não conseguiu vaga coleta
+ *     primeiro as próprias folhas; só bloqueia no semáforo quando não
+ *     tem nenhuma em execução, o que evita o impasse entre processos.
+ *
+ *     Ao final são exibidos o makespan (do início até a coleta do
+ *     último nó) e, por nível, a latência de lançamento (fork ou
+ *     lancar), a espera por vaga e o instante médio de início.
+ *
+ *     Com ESTATISTICAS_RASTRO=arquivo.json no ambiente, grava a linha do
+ *     tempo da árvore (rastro.h da Atividade 2).
+ *
+ * Uso:
+ *     ./arvore -a arvore.txt [-j folhas] [-l lançador] [-T prazo_ms] [-o diretório]
+ *     ./arvore -p profundidade -g grau [-c "comando argumentos"] [-j folhas] [-l lançador]
+ *              [-T prazo_ms] [-o diretório]
+ *
+ * Compilação:
+ *     gcc -O2 -pthread arvore.c lancador.c supervisor.c ../atividade02/src/rastro.c -o arvore
+ */
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <ctype.h>
+#include <errno.h>
+#include <signal.h>
+#include <unistd.h>
+#include <semaphore.h>
+#include <sys/mman.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include "lancador.h"
+#include "supervisor.h"
+#include "../atividade02/src/rastro.h"
+#include "../atividade02/src/tempo.h"
+
+#define MAX_NOME 64
+#define MAX_DEPENDENCIAS 8
+#define MAX_LINHA 4096
+#define MAX_ARGUMENTOS 64
+
+// Estados de um filho durante a supervisão
+#define PENDENTE 0
+#define EXECUTANDO 1
+#define CONCLUIDO 2
+
+// Nó da árvore (o nó 0 é o próprio lançador)
+typedef struct {
+    char nome[MAX_NOME];
+    int pai;
+    int nivel;                              // 0 no lançador
+    char *caminho;                          // NULL: nó interno
+    char **argumentos;                      // terminados em NULL
+    double prazo_ms;                        // 0: o de -T
+    int dependencias[MAX_DEPENDENCIAS];     // irmãos que devem terminar antes
+    int n_dependencias;
+    int *filhos;
+    int n_filhos;
+    int capacidade_filhos;
+} No;
+
+// Instantes de um nó, gravados pelo processo pai dele
+typedef struct {
+    uint64_t pronto_ns;     // dependências satisfeitas
+    uint64_t vaga_ns;       // vaga obtida (nós internos não esperam)
+    uint64_t lancado_ns;    // fork ou lancar retornou
+    uint64_t fim_ns;        // coletado
+    int falhou;
+    int expirou;            // encerrado ao estourar o prazo
+} RegistroNo;
+
+// Área compartilhada por todos os processos da árvore
+typedef struct {
+    sem_t vagas;            // folhas que ainda podem ser lançadas
+    int folhas_ativas;
+    int pico_folhas;
+    RegistroNo registros[];
+} AreaArvore;
+
+static No *nos = NULL;
+static int n_nos = 0;
+static int capacidade_nos = 0;
+static int profundidade_maxima = 0;
+static AreaArvore *area = NULL;
+static Lancador lancador = LANCADOR_FORK;
+static double prazo_padrao_ms = 0;
+static const char *diretorio_saida = NULL;
+
+// Supervisor do processo atual (cada nó interno cria o seu)
+static Supervisor *supervisor = NULL;
+
+static uint64_t agora_ns(void) {
+    struct timespec instante;
+    marcar_instante(&instante);
+    return (uint64_t)instante.tv_sec * 1000000000ULL + instante.tv_nsec;
+}
+
+// Índice do nó com o nome dado (-1 se não existir)
+static int procurar_no(const char *nome) {
+    for (int i = 0; i < n_nos; i++) {
+        if (strcmp(nos[i].nome, nome) == 0) return i;
+    }
+    return -1;
+}
+
+// Verdadeiro se o nome serve como nome de arquivo (diretorio/nome.saida)
+// sem ambiguidade: letras, dígitos, '.', '_' e '-', sem começar por '.' ou '-'
+static int nome_valido(const char *nome) {
+    if (nome[0] == '\0' || nome[0] == '.' || nome[0] == '-') return 0;
+    for (const char *c = nome; *c != '\0'; c++) {
+        if (!isalnum((unsigned char)*c) && *c != '.' && *c != '_' && *c != '-') return 0;
+    }
+    return 1;
+}
+
+// Acrescenta um nó como último filho de 'pai'; retorna o índice ou -1
+static int adicionar_no(const char *nome, int pai, char *caminho, char **argumentos) {
+    if (n_nos == capacidade_nos) {
+        int capacidade = capacidade_nos > 0 ? capacidade_nos * 2 : 64;
+        No *novos = (No*)realloc(nos, capacidade * sizeof(No));
+        if (novos == NULL) {
+            fprintf(stderr, "Erro ao alocar memória para os nós\n");
+            return -1;
+        }
+        nos = novos;
+        capacidade_nos = capacidade;
+    }
+
+    No *no = &nos[n_nos];
+    memset(no, 0, sizeof(No));
+    snprintf(no->nome, sizeof(no->nome), "%s", nome);
+    no->pai = pai;
+    no->nivel = pai >= 0 ? nos[pai].nivel + 1 : 0;
+    no->caminho = caminho;
+    no->argumentos = argumentos;
+    if (no->nivel > profundidade_maxima) profundidade_maxima = no->nivel;
+
+    if (pai >= 0) {
+        No *p = &nos[pai];
+        if (p->n_filhos == p->capacidade_filhos) {
+            int capacidade = p->capacidade_filhos > 0 ? p->capacidade_filhos * 2 : 4;
+            int *filhos = (int*)realloc(p->filhos, capacidade * sizeof(int));
+            if (filhos == NULL) {
+                fprintf(stderr, "Erro ao alocar memória para os nós\n");
+                return -1;
+            }
+            p->filhos = filhos;
+            p->capacidade_filhos = capacidade;
+        }
+        p->filhos[p->n_filhos++] = n_nos;
+    }
+    return n_nos++;
+}
+
+// Vetor de argumentos do execv: nome do comando seguido de 'n' argumentos
+static char** montar_argumentos(char *caminho, char **extras, int n) {
+    char **argumentos = (char**)malloc((n + 2) * sizeof(char*));
+    if (argumentos == NULL) return NULL;
+
+    char *barra = strrchr(caminho, '/');
+    argumentos[0] = barra != NULL ? barra + 1 : caminho;
+    for (int i = 0; i < n; i++) {
+        argumentos[i + 1] = extras[i];
+    }
+    argumentos[n + 1] = NULL;
+    return argumentos;
+}
+
+// Lê o arquivo de configuração; retorna 0 em caso de sucesso
+static int ler_configuracao(const char *arquivo_configuracao) {
+    FILE *arquivo = fopen(arquivo_configuracao, "r");
+    if (arquivo == NULL) {
+        perror("Erro ao abrir o arquivo de configuração");
+        return -1;
+    }
+
+    char linha[MAX_LINHA];
+    int numero = 0;
+    while (fgets(linha, sizeof(linha), arquivo) != NULL) {
+        numero++;
+        char *comentario = strchr(linha, '#');
+        if (comentario != NULL) *comentario = '\0';
+
+        // Os textos dos campos ficam vivos até o fim (e nos processos filhos)
+        char *copia = strdup(linha);
+        char *campos[MAX_ARGUMENTOS + 4];
+        int n_campos = 0;
+        char *contexto;
+        for (char *campo = strtok_r(copia, " \t\r\n", &contexto);
+             campo != NULL && n_campos < MAX_ARGUMENTOS + 4;
+             campo = strtok_r(NULL, " \t\r\n", &contexto)) {
+            campos[n_campos++] = campo;
+        }
+        if (n_campos == 0) {
+            free(copia);
+            continue;
+        }
+        if (n_campos < 2) {
+            fprintf(stderr, "Linha %d: esperado \"nome pai [apos=...] [comando]\"\n", numero);
+            fclose(arquivo);
+            return -1;
+        }
+
+        const char *nome = campos[0];
+        int pai = strcmp(campos[1], "-") == 0 ? 0 : procurar_no(campos[1]);
+        if (strlen(nome) >= MAX_NOME || !nome_valido(nome) || procurar_no(nome) >= 0) {
+            fprintf(stderr, "Linha %d: nome inválido ou repetido: %s\n", numero, nome);
+            fclose(arquivo);
+            return -1;
+        }
+        if (pai < 0 || nos[pai].caminho != NULL) {
+            fprintf(stderr, "Linha %d: pai inexistente ou com comando: %s\n", numero, campos[1]);
+            fclose(arquivo);
+            return -1;
+        }
+
+        int proximo = 2;
+        char *apos = NULL;
+        double prazo_ms = 0;
+        for (; proximo < n_campos; proximo++) {
+            if (strncmp(campos[proximo], "apos=", 5) == 0) {
+                apos = campos[proximo] + 5;
+            } else if (strncmp(campos[proximo], "limite=", 7) == 0) {
+                prazo_ms = atof(campos[proximo] + 7);
+            } else {
+                break;
+            }
+        }
+
+        char *caminho = NULL;
+        char **argumentos = NULL;
+        if (proximo < n_campos) {
+            caminho = campos[proximo];
+            argumentos = montar_argumentos(caminho, &campos[proximo + 1], n_campos - proximo - 1);
+            if (argumentos == NULL) {
+                fprintf(stderr, "Erro ao alocar memória para os argumentos\n");
+                fclose(arquivo);
+                return -1;
+            }
+        }
+
+        int indice = adicionar_no(nome, pai, caminho, argumentos);
+        if (indice < 0) {
+            fclose(arquivo);
+            return -1;
+        }
+        nos[indice].prazo_ms = prazo_ms;
+
+        // Dependências: irmãos já declarados
+        for (char *dependencia = apos != NULL ? strtok_r(apos, ",", &contexto) : NULL;
+             dependencia != NULL; dependencia = strtok_r(NULL, ",", &contexto)) {
+            int irmao = procurar_no(dependencia);
+            if (irmao < 0 || irmao == indice || nos[irmao].pai != pai ||
+                nos[indice].n_dependencias == MAX_DEPENDENCIAS) {
+                fprintf(stderr, "Linha %d: dependência inválida: %s (deve ser um irmão declarado antes)\n",
+                        numero, dependencia);
+                fclose(arquivo);
+                return -1;
+            }
+            nos[indice].dependencias[nos[indice].n_dependencias++] = irmao;
+        }
+
+        // Sem comando, nada aponta para os campos da linha
+        if (caminho == NULL) free(copia);
+    }
+
+    fclose(arquivo);
+    return 0;
+}
+
+// Árvore completa: 'grau' filhos por nó interno e folhas no nível 'profundidade'.
+// O nome leva os índices desde a raiz (I1.0, F2.0.1...), único na árvore.
+static int gerar_arvore(int pai, int profundidade, int grau, char *caminho, char **argumentos) {
+    // Caminho do pai: o que vem depois do primeiro '.' do nome dele
+    // (copiado, pois adicionar_no pode realocar os nós)
+    char caminho_pai[MAX_NOME] = "";
+    if (pai > 0) snprintf(caminho_pai, sizeof(caminho_pai), "%s", strchr(nos[pai].nome, '.') + 1);
+    int nivel = nos[pai].nivel + 1;
+
+    for (int i = 0; i < grau; i++) {
+        char nome[MAX_NOME];
+        int tamanho = pai > 0
+            ? snprintf(nome, sizeof(nome), "%c%d.%s.%d", nivel == profundidade ? 'F' : 'I', nivel,
+                       caminho_pai, i)
+            : snprintf(nome, sizeof(nome), "%c%d.%d", nivel == profundidade ? 'F' : 'I', nivel, i);
+        if (tamanho >= MAX_NOME) {
+            fprintf(stderr, "Árvore profunda demais para os nomes dos nós (máximo %d caracteres)\n",
+                    MAX_NOME - 1);
+            return -1;
+        }
+
+        int folha = nivel == profundidade;
+        int indice = adicionar_no(nome, pai, folha ? caminho : NULL, folha ? argumentos : NULL);
+        if (indice < 0) return -1;
+        if (!folha && gerar_arvore(indice, profundidade, grau, caminho, argumentos) != 0) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+// Verdadeiro se os irmãos dos quais o filho depende já terminaram
+static int dependencias_concluidas(const No *no, int f, const char *estado) {
+    const No *filho = &nos[no->filhos[f]];
+    for (int d = 0; d < filho->n_dependencias; d++) {
+        for (int g = 0; g < f; g++) {
+            if (no->filhos[g] == filho->dependencias[d] && estado[g] != CONCLUIDO) return 0;
+        }
+    }
+    return 1;
+}
+
+static int supervisionar(int indice);
+
+// Lança o filho f do nó e passa a acompanhá-lo: folha pelo supervisor
+// (com a saída capturada), nó interno com fork()
+static pid_t lancar_filho(const No *no, int f) {
+    int indice = no->filhos[f];
+    const No *filho = &nos[indice];
+    void *contexto = (void*)(intptr_t)f;
+
+    if (filho->caminho != NULL) {
+        double prazo_ms = filho->prazo_ms > 0 ? filho->prazo_ms : prazo_padrao_ms;
+        return supervisor_lancar(supervisor, lancador, filho->nome, filho->caminho,
+                                 filho->argumentos, prazo_ms, contexto);
+    }
+
+    pid_t pid = fork();
+    if (pid == 0) {
+        // --- Nó interno: cria e aguarda os próprios filhos ---
+        rastro_nomear(filho->nome);
+        rastro_comecar(filho->nome);
+
+        // A cópia herdada do supervisor do pai não é usada aqui
+        supervisor_destruir(supervisor);
+        supervisor = supervisor_criar(diretorio_saida != NULL ? CAPTURA_ARQUIVO : CAPTURA_MEMORIA,
+                                      diretorio_saida);
+        int falhas = supervisor != NULL ? supervisionar(indice) : no->n_filhos;
+        rastro_terminar(filho->nome);
+        fflush(stdout);
+        _exit(falhas == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
+    }
+
+    if (pid > 0 && supervisor_acompanhar(supervisor, pid, filho->nome, 0, contexto) != 0) {
+        int erro = errno;
+        kill(pid, SIGKILL);
+        waitpid(pid, NULL, 0);
+        errno = erro;
+        return -1;
+    }
+    return pid;
+}
+
+// Registra uma folha a mais em execução e atualiza o pico
+static void contar_folha(void) {
+    int ativas = __atomic_add_fetch(&area->folhas_ativas, 1, __ATOMIC_RELAXED);
+    int pico = __atomic_load_n(&area->pico_folhas, __ATOMIC_RELAXED);
+    while (ativas > pico &&
+           !__atomic_compare_exchange_n(&area->pico_folhas, &pico, ativas, 0,
+                                        __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+    }
+}
+
+// Cria os filhos do nó na ordem do arquivo, respeitando as dependências e
+// o limite de folhas, e coleta cada um quando terminar, em qualquer ordem
+// (supervisor do processo atual). Retorna quantos filhos falharam.
+static int supervisionar(int indice) {
+    const No *no = &nos[indice];
+    int n = no->n_filhos;
+    char *estado = (char*)calloc(n > 0 ? n : 1, 1);
+    if (estado == NULL) {
+        fprintf(stderr, "Erro ao alocar memória para a supervisão de %s\n", no->nome);
+        return n;
+    }
+
+    int concluidos = 0, executando = 0, folhas_executando = 0, falhas = 0;
+    while (concluidos < n) {
+        // Duas passagens: nós internos (sem vaga) primeiro, depois as folhas
+        for (int passagem = 0; passagem < 2; passagem++) {
+            for (int f = 0; f < n; f++) {
+                int filho = no->filhos[f];
+                int folha = nos[filho].caminho != NULL;
+                if (estado[f] != PENDENTE || folha != passagem) continue;
+                if (!dependencias_concluidas(no, f, estado)) continue;
+
+                RegistroNo *registro = &area->registros[filho];
+                if (registro->pronto_ns == 0) registro->pronto_ns = agora_ns();
+
+                if (folha && sem_trywait(&area->vagas) != 0) {
+                    // Sem vaga: se houver folhas próprias, coleta uma antes
+                    if (folhas_executando > 0) continue;
+                    while (sem_wait(&area->vagas) == -1 && errno == EINTR) {
+                    }
+                }
+                registro->vaga_ns = agora_ns();
+
+                pid_t pid = lancar_filho(no, f);
+                registro->lancado_ns = agora_ns();
+                if (pid < 0) {
+                    fprintf(stderr, "Erro ao lançar %s: %s\n", nos[filho].nome, strerror(errno));
+                    if (folha) sem_post(&area->vagas);
+                    registro->falhou = 1;
+                    registro->fim_ns = registro->lancado_ns;
+                    estado[f] = CONCLUIDO;
+                    concluidos++;
+                    falhas++;
+                    continue;
+                }
+                rastro_marcar("fork", pid);
+
+                if (folha) {
+                    folhas_executando++;
+                    contar_folha();
+                }
+                estado[f] = EXECUTANDO;
+                executando++;
+            }
+        }
+        if (executando == 0) continue;
+
+        // Coleta o primeiro filho que terminar
+        Termino termino;
+        if (supervisor_proximo(supervisor, &termino) != 0) {
+            fprintf(stderr, "Erro ao aguardar os filhos de %s\n", no->nome);
+            break;
+        }
+        rastro_marcar("coletado", termino.pid);
+
+        int f = (int)(intptr_t)termino.contexto;
+        int filho = no->filhos[f];
+        RegistroNo *registro = &area->registros[filho];
+        registro->fim_ns = agora_ns();
+        registro->falhou = termino.codigo != 0;
+        registro->expirou = termino.expirou;
+        if (registro->falhou) falhas++;
+
+        if (nos[filho].caminho != NULL) {
+            folhas_executando--;
+            __atomic_sub_fetch(&area->folhas_ativas, 1, __ATOMIC_RELAXED);
+            sem_post(&area->vagas);
+
+            // Saída inteira da folha, sem mistura com a das outras
+            supervisor_travar_saida();
+            if (termino.expirou) {
+                printf("--- %s: encerrado após %.0f ms (prazo esgotado) ---\n", termino.nome,
+                       termino.duracao_ms);
+            }
+            supervisor_exibir(&termino);
+            supervisor_destravar_saida();
+            supervisor_liberar(&termino);
+        }
+        estado[f] = CONCLUIDO;
+        executando--;
+        concluidos++;
+    }
+
+    free(estado);
+    return falhas;
+}
+
+// Latências de lançamento, espera por vaga e início, agregadas por nível
+static void exibir_niveis(uint64_t inicio_ns) {
+    printf("--- LANÇAMENTO POR NÍVEL ---\n");
+    printf("%-6s %7s %16s %16s %16s %16s\n", "Nível", "Nós", "Lançamento (ms)",
+           "Lançamento máx", "Espera vaga (ms)", "Início (ms)");
+
+    for (int nivel = 1; nivel <= profundidade_maxima; nivel++) {
+        int quantidade = 0;
+        double lancamento = 0.0, lancamento_maximo = 0.0, espera = 0.0, inicio = 0.0;
+        for (int i = 1; i < n_nos; i++) {
+            const RegistroNo *registro = &area->registros[i];
+            if (nos[i].nivel != nivel || registro->lancado_ns == 0) continue;
+
+            double duracao = (registro->lancado_ns - registro->vaga_ns) / 1e6;
+            lancamento += duracao;
+            if (duracao > lancamento_maximo) lancamento_maximo = duracao;
+            espera += (registro->vaga_ns - registro->pronto_ns) / 1e6;
+            inicio += (registro->lancado_ns - inicio_ns) / 1e6;
+            quantidade++;
+        }
+        if (quantidade == 0) continue;
+
+        printf("%-6d %7d %16.3f %16.3f %16.3f %16.3f\n", nivel, quantidade,
+               lancamento / quantidade, lancamento_maximo, espera / quantidade, inicio / quantidade);
+    }
+}
+
+int main(int argc, char *argv[]) {
+    const char *arquivo_configuracao = NULL;
+    int profundidade = 0;
+    int grau = 0;
+    char comando_padrao[] = "/bin/true";
+    char *comando = comando_padrao;
+    long nucleos = sysconf(_SC_NPROCESSORS_ONLN);
+    int limite_folhas = nucleos > 0 ? (int)nucleos : 1;
+
+    // Lê as opções da linha de comando
+    int opcao;
+    while ((opcao = getopt(argc, argv, "a:p:g:c:j:l:T:o:")) != -1) {
+        switch (opcao) {
+            case 'a':
+                arquivo_configuracao = optarg;
+                break;
+            case 'p':
+                profundidade = atoi(optarg);
+                break;
+            case 'g':
+                grau = atoi(optarg);
+                break;
+            case 'c':
+                comando = optarg;
+                break;
+            case 'j':
+                limite_folhas = atoi(optarg);
+                break;
+            case 'l':
+                if (lancador_ler(optarg, &lancador) != 0) {
+                    fprintf(stderr, "Lançador inválido: %s (fork, vfork, posix_spawn ou clone)\n", optarg);
+                    return EXIT_FAILURE;
+                }
+                break;
+            case 'T':
+                prazo_padrao_ms = atof(optarg);
+                break;
+            case 'o':
+                diretorio_saida = optarg;
+                break;
+            default:
+                fprintf(stderr, "Uso: %s (-a arvore.txt | -p profundidade -g grau [-c \"comando argumentos\"]) "
+                        "[-j folhas] [-l lançador] [-T prazo_ms] [-o diretório]\n", argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+
+    if (limite_folhas < 1) {
+        fprintf(stderr, "Limite de folhas inválido: %d\n", limite_folhas);
+        return EXIT_FAILURE;
+    }
+
+    // Nó 0: o próprio lançador
+    if (adicionar_no("lancador", -1, NULL, NULL) != 0) {
+        return EXIT_FAILURE;
+    }
+    if (arquivo_configuracao != NULL) {
+        if (ler_configuracao(arquivo_configuracao) != 0) {
+            return EXIT_FAILURE;
+        }
+    } else if (profundidade >= 1 && grau >= 1) {
+        // Comando das folhas: caminho seguido dos argumentos
+        char *campos[MAX_ARGUMENTOS];
+        int n_campos = 0;
+        for (char *campo = strtok(comando, " "); campo != NULL && n_campos < MAX_ARGUMENTOS;
+             campo = strtok(NULL, " ")) {
+            campos[n_campos++] = campo;
+        }
+        char **argumentos = n_campos > 0 ? montar_argumentos(campos[0], &campos[1], n_campos - 1) : NULL;
+        if (argumentos == NULL) {
+            fprintf(stderr, "Comando das folhas inválido\n");
+            return EXIT_FAILURE;
+        }
+        if (gerar_arvore(0, profundidade, grau, campos[0], argumentos) != 0) {
+            return EXIT_FAILURE;
+        }
+    } else {
+        fprintf(stderr, "Informe -a arquivo ou -p profundidade e -g grau (ambos >= 1)\n");
+        return EXIT_FAILURE;
+    }
+
+    int internos = 0;
+    for (int i = 1; i < n_nos; i++) {
+        if (nos[i].caminho == NULL) internos++;
+    }
+
+    // Registros e semáforo visíveis para todos os processos da árvore
+    size_t bytes = sizeof(AreaArvore) + n_nos * sizeof(RegistroNo);
+    area = (AreaArvore*)mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (area == MAP_FAILED) {
+        perror("Erro ao mapear a área compartilhada");
+        return EXIT_FAILURE;
+    }
+    if (sem_init(&area->vagas, 1, limite_folhas) == -1) {
+        perror("Erro ao criar o semáforo de vagas");
+        return EXIT_FAILURE;
+    }
+
+    // Supervisor do lançador; a saída das folhas vai para buffers ou para -o
+    supervisor = supervisor_criar(diretorio_saida != NULL ? CAPTURA_ARQUIVO : CAPTURA_MEMORIA,
+                                  diretorio_saida);
+    if (supervisor == NULL) {
+        return EXIT_FAILURE;
+    }
+
+    // Rastro opcional: liga com ESTATISTICAS_RASTRO e é gravado ao sair
+    rastro_iniciar();
+    rastro_nomear("lancador");
+
+    printf("========================================\n");
+    printf("  ÁRVORE DE PROCESSOS\n");
+    printf("========================================\n\n");
+    printf("Nós: %d (%d internos, %d folhas), profundidade %d\n", n_nos - 1, internos,
+           n_nos - 1 - internos, profundidade_maxima);
+    printf("Lançador: %s, até %d folhas ao mesmo tempo\n", lancador_nome(lancador), limite_folhas);
+    if (diretorio_saida != NULL) {
+        printf("Saída das folhas: %s/<nome>.saida e .erros\n", diretorio_saida);
+    }
+    if (prazo_padrao_ms > 0) {
+        printf("Prazo por folha: %.0f ms\n", prazo_padrao_ms);
+    }
+    printf("\n");
+
+    // Nada pendente no buffer: os nós internos herdam a saída no fork
+    fflush(stdout);
+
+    uint64_t inicio_ns = agora_ns();
+    int falhas = supervisionar(0);
+    uint64_t fim_ns = agora_ns();
+
+    supervisor_destruir(supervisor);
+
+    // Falhas de comando: folhas com erro no lançamento, status diferente de 0
+    // ou encerradas pelo prazo
+    int comandos_falhos = 0, comandos_expirados = 0;
+    for (int i = 1; i < n_nos; i++) {
+        if (nos[i].caminho == NULL) continue;
+        if (area->registros[i].falhou) comandos_falhos++;
+        if (area->registros[i].expirou) comandos_expirados++;
+    }
+
+    printf("\n");
+    exibir_niveis(inicio_ns);
+    printf("\n--- MÉTRICAS DE TEMPO ---\n");
+    printf("Makespan: %.3f ms\n", (fim_ns - inicio_ns) / 1e6);
+    printf("Pico de folhas simultâneas: %d\n", area->pico_folhas);
+    printf("Comandos com falha: %d (%d por prazo)\n", comandos_falhos, comandos_expirados);
+
+    sem_destroy(&area->vagas);
+    return falhas == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
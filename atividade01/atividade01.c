@@ -10,10 +10,27 @@
  * 1 Processo Pai (P1) -> 2 Processos Filhos (F1, F2) -> 4 Processos Netos (N1, N2, N3, N4).
  * 
  * Funcionalidade:
- * - Os processos Netos (N1, N2, N3, N4) utilizam a função execl() para substituir sua imagem 
+ * - Os processos Netos (N1, N2, N3, N4) utilizam a função execv() para substituir sua imagem 
  *   por comandos do terminal Linux (ls, pwd, date, whoami).
+ * - A opção -l escolhe como os Netos são criados: fork (padrão), vfork, posix_spawn ou
+ *   clone (ver lancador.h). Os mecanismos sem fork não copiam as tabelas de páginas do
+ *   Filho só para descartá-las no exec; benchmark_lancamento.c compara os quatro.
  * - Os processos Filhos (F1, F2) aguardam o término de seus respectivos netos antes 
  *   de imprimirem seus PIDs e o PID do pai (P1).
+ * - A espera usa o supervisor de supervisor.h em vez de wait(NULL) em ordem fixa: cada
+ *   filho tem um pidfd em um epoll e é coletado assim que termina. A saída de cada Neto
+ *   é capturada por pipes (movida com splice para um buffer em memória) e exibida de uma
+ *   vez quando ele termina, sem se misturar à dos outros. Com -T, um Neto que passar do
+ *   prazo (em ms) é encerrado com SIGKILL.
+ * - Com ESTATISTICAS_RASTRO=arquivo.json no ambiente, grava a linha do tempo da árvore
+ *   (fork, execução, exec e coleta de cada processo) no formato Chrome trace, usando o
+ *   módulo de rastro da Atividade 2; o arquivo abre no Perfetto (ui.perfetto.dev).
+ *
+ * Uso:
+ *     ./atividade01 [-l fork|vfork|posix_spawn|clone] [-T prazo_ms]
+ *
+ * Compilação:
+ *     gcc -O2 -pthread atividade01.c lancador.c supervisor.c ../atividade02/src/rastro.c -o atividade01
  */
 
  #include <stdio.h>
@@ -21,45 +38,46 @@
  #include <unistd.h>
  #include <sys/wait.h>
  #include <sys/types.h>
+ #include "lancador.h"
+ #include "supervisor.h"
+ #include "../atividade02/src/rastro.h"
+ 
+ // Mecanismo de criação dos Netos (opção -l; padrão: fork + execv)
+ Lancador lancador = LANCADOR_FORK;
+ 
+ // Prazo de cada Neto em ms (opção -T; 0: sem prazo)
+ double prazo_ms = 0;
  
  /**
   * Função: criarNeto
   * -----------------
   * Responsável por criar um processo folha (Neto) na árvore de processos.
-  * Este processo utiliza execl para executar um comando do sistema.
+  * Este processo executa um comando do sistema, criado pelo mecanismo escolhido
+  * com -l (fork + execv, vfork, posix_spawn ou clone; ver lancador.h).
   *
+  * supervisor: supervisor do Filho, que captura a saída e coleta o Neto.
+  * nome: nome do processo na linha do tempo do rastro (ex: "N1").
   * comando: string contendo o caminho do comando a ser executado (ex: "/bin/ls", "/bin/date").
   * arg1: primeiro argumento do comando (pode ser NULL ou o nome do comando).
   * arg2: segundo argumento do comando (pode ser NULL).
   */
- void criarNeto(const char* comando, const char* arg1, const char* arg2) {
-     pid_t pid = fork(); // Chamada de sistema para duplicar o processo atual
+ void criarNeto(Supervisor* supervisor, const char* nome, const char* comando,
+                const char* arg1, const char* arg2) {
+     // Vetor de argumentos no formato do execv: argv[0] é o nome do comando
+     char* argumentos[3] = { (char*)(arg1 != NULL ? arg1 : comando), (char*)arg2, NULL };
+     
+     // Só retorna depois que o Neto substituiu sua imagem pelo comando (ou
+     // falhou: nesse caso o Neto já terminou e foi coletado)
+     pid_t pid = supervisor_lancar(supervisor, lancador, nome, comando, argumentos, prazo_ms, NULL);
      
      if (pid < 0) {
-         // Erro crítico na criação do processo
-         perror("Erro ao executar fork para o Neto");
-         exit(EXIT_FAILURE);
-     } 
-     else if (pid == 0) {
-         // --- Área do Processo Neto (N) ---
-         
-         // A função execl substitui a imagem do processo atual pelo comando especificado.
-         // Formato: execl(caminho_do_comando, nome_do_comando, arg1, arg2, NULL)
-         if (arg2 != NULL) {
-             execl(comando, arg1, arg2, (char*)NULL);
-         } else if (arg1 != NULL) {
-             execl(comando, arg1, (char*)NULL);
-         } else {
-             execl(comando, comando, (char*)NULL);
-         }
-         
-         // Se o execl funcionar, o código abaixo NUNCA será executado.
-         // Se chegou aqui, houve erro na substituição da imagem.
-         perror("Erro na execução do execl");
-         exit(EXIT_FAILURE);
+         // O Filho segue: o outro Neto ainda deve ser aguardado
+         perror("Erro ao executar o comando do Neto");
+         return;
      }
      
-     // Se pid > 0, estamos no processo Filho (pai do Neto), a função retorna para continuar o fluxo.
+     // Estamos no processo Filho (pai do Neto), a função retorna para continuar o fluxo.
+     rastro_marcar("fork", pid);
  }
  
  /**
@@ -67,6 +85,8 @@
   * ------------------
   * Responsável por criar um processo intermediário (Filho) que gerencia dois Netos.
   *
+  * supervisorPai: supervisor de P1, que passa a acompanhar o Filho.
+  * nome: nome do Filho no rastro; os Netos recebem nomeNetoA e nomeNetoB.
   * cmdNetoA: Caminho do primeiro comando a ser executado por um dos netos.
   * arg1A: Primeiro argumento do primeiro comando.
   * arg2A: Segundo argumento do primeiro comando (pode ser NULL).
@@ -74,8 +94,12 @@
   * arg1B: Primeiro argumento do segundo comando.
   * arg2B: Segundo argumento do segundo comando (pode ser NULL).
   */
- void criarFilho(const char* cmdNetoA, const char* arg1A, const char* arg2A,
-                 const char* cmdNetoB, const char* arg1B, const char* arg2B) {
+ void criarFilho(Supervisor* supervisorPai, const char* nome,
+                 const char* nomeNetoA, const char* cmdNetoA, const char* arg1A, const char* arg2A,
+                 const char* nomeNetoB, const char* cmdNetoB, const char* arg1B, const char* arg2B) {
+     // Esvazia o buffer da saída: o Filho não deve herdar e repetir o que P1 já imprimiu
+     fflush(stdout);
+     
      pid_t pid = fork(); // Criação do processo F1 ou F2
      
      if (pid < 0) {
@@ -84,24 +108,54 @@
      } 
      else if (pid == 0) {
          // --- Área do Processo Filho (F) ---
+         rastro_nomear(nome);
+         rastro_comecar(nome);
+         
+         // A cópia herdada do supervisor de P1 não é usada aqui
+         supervisor_destruir(supervisorPai);
+         Supervisor* supervisor = supervisor_criar(CAPTURA_MEMORIA, NULL);
+         if (supervisor == NULL) {
+             exit(EXIT_FAILURE);
+         }
          
          // O Filho cria seus dois processos Netos (N)
-         criarNeto(cmdNetoA, arg1A, arg2A);
-         criarNeto(cmdNetoB, arg1B, arg2B);
+         criarNeto(supervisor, nomeNetoA, cmdNetoA, arg1A, arg2A);
+         criarNeto(supervisor, nomeNetoB, cmdNetoB, arg1B, arg2B);
          
-         // Sincronização: O Filho aguarda o término dos seus dois Netos
-         wait(NULL);
-         wait(NULL);
+         // Sincronização: O Filho aguarda o término dos seus dois Netos, na
+         // ordem em que terminarem, e exibe a saída de cada um
+         Termino termino;
+         while (supervisor_proximo(supervisor, &termino) == 0) {
+             rastro_marcar("coletado", termino.pid);
+             supervisor_travar_saida();
+             if (termino.expirou) {
+                 printf("-> [Processo Neto %s] Encerrado após %.0f ms (prazo esgotado)\n",
+                        termino.nome, termino.duracao_ms);
+             }
+             supervisor_exibir(&termino);
+             supervisor_destravar_saida();
+             supervisor_liberar(&termino);
+         }
+         supervisor_destruir(supervisor);
          
          // Após os netos terminarem, o Filho imprime suas informações conforme solicitado
+         // (com a saída travada, para não cair no meio da saída de um Neto do outro Filho)
+         supervisor_travar_saida();
          printf("-> [Processo Filho] Finalizado. Meu PID: %d | PID do meu Pai (P1): %d\n", 
                 getpid(), getppid());
+         supervisor_destravar_saida();
          
          // O processo Filho encerra com sucesso
+         rastro_terminar(nome);
          exit(EXIT_SUCCESS);
      }
      
      // Se pid > 0, estamos no processo Pai (P1), a função retorna.
+     rastro_marcar("fork", pid);
+     if (supervisor_acompanhar(supervisorPai, pid, nome, 0, NULL) != 0) {
+         perror("Erro ao acompanhar o Filho");
+         exit(EXIT_FAILURE);
+     }
  }
  
  /**
@@ -109,18 +163,42 @@
   * ------------
   * Ponto de entrada do Processo Pai (P1).
   */
- int main() {
+ int main(int argc, char *argv[]) {
+     // Lê as opções -l (mecanismo de criação dos Netos) e -T (prazo dos Netos)
+     int opcao;
+     while ((opcao = getopt(argc, argv, "l:T:")) != -1) {
+         if (opcao == 'T') {
+             prazo_ms = atof(optarg);
+         } else if (opcao != 'l' || lancador_ler(optarg, &lancador) != 0) {
+             fprintf(stderr, "Uso: %s [-l fork|vfork|posix_spawn|clone] [-T prazo_ms]\n", argv[0]);
+             return EXIT_FAILURE;
+         }
+     }
+     
+     // Rastro opcional: liga com ESTATISTICAS_RASTRO e é gravado ao sair de P1
+     rastro_iniciar();
+     rastro_nomear("P1");
+     
      printf("Iniciando a árvore de processos...\n\n");
      
+     // Supervisor de P1: acompanha F1 e F2 (a saída deles não é capturada)
+     Supervisor* supervisor = supervisor_criar(CAPTURA_NENHUMA, NULL);
+     if (supervisor == NULL) {
+         return EXIT_FAILURE;
+     }
+     
      // P1 cria o primeiro filho (F1), que gerenciará N1 (ls) e N2 (pwd)
-     criarFilho("/bin/ls", "ls", "-l", "/bin/pwd", "pwd", NULL);
+     criarFilho(supervisor, "F1", "N1", "/bin/ls", "ls", "-l", "N2", "/bin/pwd", "pwd", NULL);
      
      // P1 cria o segundo filho (F2), que gerenciará N3 (date) e N4 (whoami)
-     criarFilho("/bin/date", "date", NULL, "/usr/bin/whoami", "whoami", NULL);
+     criarFilho(supervisor, "F2", "N3", "/bin/date", "date", NULL, "N4", "/usr/bin/whoami", "whoami", NULL);
      
-     // Sincronização: O Pai (P1) deve esperar F1 e F2 terminarem
-     wait(NULL);
-     wait(NULL);
+     // Sincronização: O Pai (P1) deve esperar F1 e F2 terminarem, em qualquer ordem
+     Termino termino;
+     while (supervisor_proximo(supervisor, &termino) == 0) {
+         rastro_marcar("coletado", termino.pid);
+     }
+     supervisor_destruir(supervisor);
      
      // Mensagem final exigida pelo enunciado
      printf("\nSou o processo pai P1. Meu PID: %d\n", getpid());
@@ -143,19 +221,20 @@
   *    garantida. O sistema operacional pode executar N1 antes de N2, ou vice-versa,
   *    dependendo da carga do sistema e do algoritmo de escalonamento.
   * 
-  * 3. O uso de wait() garante apenas que:
+  * 3. A coleta pelo supervisor (o equivalente a wait()) garante apenas que:
   *    - F1 espera N1 e N2 terminarem antes de imprimir sua mensagem
   *    - F2 espera N3 e N4 terminarem antes de imprimir sua mensagem
   *    - P1 espera F1 e F2 terminarem antes de imprimir sua mensagem final
   * 
   * 4. A saída dos comandos (ls, pwd, date, whoami) pode aparecer em qualquer ordem,
-  *    mas as mensagens de sincronização (dos processos F1, F2 e P1) sempre aparecerão
-  *    na ordem correta devido ao uso de wait().
+  *    mas cada uma aparece inteira, na ordem de término dos Netos, e as mensagens de
+  *    sincronização (dos processos F1, F2 e P1) sempre aparecerão na ordem correta
+  *    devido à coleta.
   * 
   * Exemplo de possível ordem de execução:
   *    N1 -> N2 -> N3 -> N4 (ou qualquer outra permutação)
   *    Mas a ordem de finalização das mensagens será sempre:
-  *    F1 -> F2 -> P1 (devido ao wait())
+  *    F1 -> F2 -> P1 (devido à coleta)
   */
  
  
\ No newline at end of file
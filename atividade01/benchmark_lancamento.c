@@ -0,0 +1,265 @@
+/*
+ * Instituição: Universidade Federal da Paraíba
+ * Disciplina: Sistemas Operacionais I
+ * Unidade 1 - Atividade 1
+ *
+ * Autor: Rodrigo Monteiro Fortes de Oliveira, 20240097664
+ *
+ * Nome do Programa: benchmark_lancamento.c
+ *
+ * Descrição:
+ *     Compara os mecanismos de lançamento de lancador.h (fork + execv,
+ *     vfork, posix_spawn e clone) à medida que o RSS do processo pai
+ *     cresce. Para cada tamanho de memória tocada (-m, em MB) e cada
+ *     mecanismo, lança R vezes o comando (-c, padrão /bin/true) e mede:
+ *
+ *       - a latência de cada lançamento até o exec (lancar() só
+ *         retorna depois da troca de imagem): mínimo, mediana e p99;
+ *       - a vazão em lançamentos por segundo, com os filhos coletados
+ *         só depois do laço de lançamentos.
+ *
+ *     O custo do fork cresce com o RSS (cópia das tabelas de páginas);
+ *     o dos demais, não. Os resultados também vão para um CSV.
+ *
+ * Uso:
+ *     ./benchmark_lancamento [-m 0,64,256,1024] [-r lançamentos] [-w aquecimento]
+ *                            [-l fork,vfork,...] [-c comando] [-o saida.csv]
+ *
+ * Compilação:
+ *     gcc -O2 -pthread benchmark_lancamento.c lancador.c ../atividade02/src/rastro.c -o benchmark_lancamento -lm
+ */
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include "lancador.h"
+#include "../atividade02/src/tempo.h"
+
+#define MAX_LISTA 32
+
+// Lê uma lista de inteiros não negativos separados por vírgula; retorna
+// quantos leu ou -1 se o texto for inválido
+int ler_lista(const char *texto, long *lista, int maximo) {
+    int quantidade = 0;
+    const char *p = texto;
+    
+    while (*p != '\0' && quantidade < maximo) {
+        char *fim;
+        long valor = strtol(p, &fim, 10);
+        if (fim == p || valor < 0) {
+            return -1;
+        }
+        lista[quantidade++] = valor;
+        p = (*fim == ',') ? fim + 1 : fim;
+    }
+    
+    return quantidade;
+}
+
+// Lê uma lista de mecanismos separados por vírgula
+int ler_lancadores(const char *texto, Lancador *lista) {
+    char copia[256];
+    snprintf(copia, sizeof(copia), "%s", texto);
+    
+    int quantidade = 0;
+    for (char *parte = strtok(copia, ","); parte != NULL; parte = strtok(NULL, ",")) {
+        if (quantidade == N_LANCADORES || lancador_ler(parte, &lista[quantidade]) != 0) {
+            return -1;
+        }
+        quantidade++;
+    }
+    return quantidade;
+}
+
+// Memória residente do processo, em MB (/proc/self/statm)
+double rss_mb(void) {
+    FILE *arquivo = fopen("/proc/self/statm", "r");
+    if (arquivo == NULL) return NAN;
+    
+    long total, residentes;
+    int lidos = fscanf(arquivo, "%ld %ld", &total, &residentes);
+    fclose(arquivo);
+    if (lidos != 2) return NAN;
+    
+    return (double)residentes * sysconf(_SC_PAGESIZE) / (1024.0 * 1024.0);
+}
+
+// Aumenta a memória tocada pelo processo para 'mb' MB (lastro acumulado)
+int crescer_lastro(size_t mb) {
+    static size_t lastro_mb = 0;
+    if (mb <= lastro_mb) return 0;
+    
+    size_t bytes = (mb - lastro_mb) * 1024 * 1024;
+    void *area = mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (area == MAP_FAILED) {
+        perror("Erro ao alocar o lastro de memória");
+        return -1;
+    }
+    
+    // Escreve em todas as páginas: entram no RSS e nas tabelas de páginas
+    memset(area, 1, bytes);
+    lastro_mb = mb;
+    return 0;
+}
+
+int comparar_double(const void *a, const void *b) {
+    double da = *((const double*)a);
+    double db = *((const double*)b);
+    
+    if (da < db) return -1;
+    if (da > db) return 1;
+    return 0;
+}
+
+// Lança o comando 'n' vezes; grava a latência de cada lançamento (us) e
+// retorna a duração do laço (ms) ou -1 em caso de erro
+double medir(Lancador lancador, const char *comando, char *const argumentos[], int n,
+             double *latencias, pid_t *pids) {
+    struct timespec inicio, antes, depois;
+    marcar_instante(&inicio);
+    
+    int lancados = 0;
+    for (int i = 0; i < n; i++) {
+        marcar_instante(&antes);
+        pids[i] = lancar(lancador, "lancado", comando, argumentos);
+        marcar_instante(&depois);
+        if (pids[i] < 0) {
+            fprintf(stderr, "Erro ao lançar %s com %s: %s\n", comando,
+                    lancador_nome(lancador), strerror(errno));
+            break;
+        }
+        latencias[i] = diferenca_ms(antes, depois) * 1000.0;
+        lancados++;
+    }
+    
+    struct timespec fim;
+    marcar_instante(&fim);
+    
+    // Coleta fora da medição
+    for (int i = 0; i < lancados; i++) {
+        waitpid(pids[i], NULL, 0);
+    }
+    
+    return lancados == n ? diferenca_ms(inicio, fim) : -1.0;
+}
+
+int main(int argc, char *argv[]) {
+    long tamanhos[MAX_LISTA] = { 0, 64, 256, 1024 };
+    int n_tamanhos = 4;
+    Lancador lancadores[N_LANCADORES] = { LANCADOR_FORK, LANCADOR_VFORK,
+                                          LANCADOR_POSIX_SPAWN, LANCADOR_CLONE };
+    int n_lancadores = N_LANCADORES;
+    int repeticoes = 200;
+    int aquecimento = 10;
+    const char *comando = "/bin/true";
+    const char *arquivo_saida = "resultados_lancamento.csv";
+    
+    // Lê as opções da linha de comando
+    int opcao;
+    while ((opcao = getopt(argc, argv, "m:r:w:l:c:o:")) != -1) {
+        switch (opcao) {
+            case 'm':
+                n_tamanhos = ler_lista(optarg, tamanhos, MAX_LISTA);
+                break;
+            case 'r':
+                repeticoes = atoi(optarg);
+                break;
+            case 'w':
+                aquecimento = atoi(optarg);
+                break;
+            case 'l':
+                n_lancadores = ler_lancadores(optarg, lancadores);
+                break;
+            case 'c':
+                comando = optarg;
+                break;
+            case 'o':
+                arquivo_saida = optarg;
+                break;
+            default:
+                fprintf(stderr, "Uso: %s [-m MB1,MB2,...] [-r lançamentos] [-w aquecimento] "
+                        "[-l fork,vfork,posix_spawn,clone] [-c comando] [-o saida.csv]\n", argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+    
+    if (n_tamanhos <= 0 || n_lancadores <= 0 || repeticoes < 1 || aquecimento < 0) {
+        fprintf(stderr, "Opções inválidas\n");
+        return EXIT_FAILURE;
+    }
+    
+    // O comando recebe só o próprio nome como argumento
+    const char *barra = strrchr(comando, '/');
+    char *argumentos[2] = { (char*)(barra != NULL ? barra + 1 : comando), NULL };
+    
+    int maximo = repeticoes > aquecimento ? repeticoes : aquecimento;
+    double *latencias = (double*)malloc(maximo * sizeof(double));
+    pid_t *pids = (pid_t*)malloc(maximo * sizeof(pid_t));
+    if (latencias == NULL || pids == NULL) {
+        fprintf(stderr, "Erro ao alocar memória para as amostras\n");
+        return EXIT_FAILURE;
+    }
+    
+    FILE *csv = fopen(arquivo_saida, "w");
+    if (csv == NULL) {
+        perror("Erro ao abrir o arquivo de saída");
+        return EXIT_FAILURE;
+    }
+    fprintf(csv, "Lancador,RSS_MB,Lancamentos,Latencia_Min_us,Latencia_Mediana_us,"
+                 "Latencia_P99_us,Lancamentos_por_s\n");
+    
+    printf("%-12s %9s %12s %12s %12s %14s\n", "Lançador", "RSS (MB)", "Mín (us)",
+           "Mediana (us)", "p99 (us)", "Lançamentos/s");
+    
+    int falhas = 0;
+    for (int t = 0; t < n_tamanhos; t++) {
+        if (crescer_lastro((size_t)tamanhos[t]) != 0) {
+            falhas++;
+            break;
+        }
+        double rss = rss_mb();
+    
+        for (int l = 0; l < n_lancadores; l++) {
+            // Aquecimento: binário do comando e caches do núcleo já carregados
+            if (aquecimento > 0 &&
+                medir(lancadores[l], comando, argumentos, aquecimento, latencias, pids) < 0) {
+                falhas++;
+                continue;
+            }
+    
+            double duracao = medir(lancadores[l], comando, argumentos, repeticoes, latencias, pids);
+            if (duracao < 0) {
+                falhas++;
+                continue;
+            }
+    
+            // Percentis pelo posto mais próximo
+            qsort(latencias, repeticoes, sizeof(double), comparar_double);
+            double mediana = (repeticoes % 2 == 0)
+                             ? (latencias[repeticoes/2 - 1] + latencias[repeticoes/2]) / 2.0
+                             : latencias[repeticoes/2];
+            int posto = (int)ceil(0.99 * repeticoes) - 1;
+            double p99 = latencias[posto < 0 ? 0 : posto];
+            double vazao = repeticoes / (duracao / 1000.0);
+    
+            printf("%-12s %9.1f %12.1f %12.1f %12.1f %14.0f\n", lancador_nome(lancadores[l]),
+                   rss, latencias[0], mediana, p99, vazao);
+            fprintf(csv, "%s,%.1f,%d,%.3f,%.3f,%.3f,%.1f\n", lancador_nome(lancadores[l]),
+                    rss, repeticoes, latencias[0], mediana, p99, vazao);
+            fflush(csv);
+        }
+    }
+    
+    free(latencias);
+    free(pids);
+    fclose(csv);
+    
+    printf("\nResultados gravados em %s\n", arquivo_saida);
+    return falhas == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,156 @@
+/*
+ * Instituição: Universidade Federal da Paraíba
+ * Disciplina: Sistemas Operacionais I
+ * Unidade 1 - Atividade 1
+ *
+ * Autor: Rodrigo Monteiro Fortes de Oliveira, 20240097664
+ *
+ * Nome do Módulo: lancador.c
+ *
+ * Descrição:
+ *     Implementação dos mecanismos de lançamento declarados em
+ *     lancador.h. Depois de vfork() e de clone(CLONE_VM) o filho só
+ *     chama dup2, execv, write e _exit, pois escreve na memória do pai.
+ */
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <sched.h>
+#include <signal.h>
+#include <spawn.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include "lancador.h"
+#include "../atividade02/src/rastro.h"
+
+// Pilha do filho do clone (usada só até o exec)
+#define PILHA_CLONE (64 * 1024)
+
+extern char **environ;
+
+static const char *const NOMES[N_LANCADORES] = { "fork", "vfork", "posix_spawn", "clone" };
+
+// O que o filho executa, para onde vai a saída e por onde avisa a falha do exec
+typedef struct {
+    const char *caminho;
+    char *const *argumentos;
+    int saida_fd;
+    int erros_fd;
+    int aviso_fd;
+} Execucao;
+
+int lancador_ler(const char *texto, Lancador *lancador) {
+    for (int l = 0; l < N_LANCADORES; l++) {
+        if (strcmp(texto, NOMES[l]) == 0) {
+            *lancador = (Lancador)l;
+            return 0;
+        }
+    }
+    return -1;
+}
+
+const char* lancador_nome(Lancador lancador) {
+    return NOMES[lancador];
+}
+
+// Corpo do filho: troca de imagem ou envia o errno ao pai e termina
+static int executar(void *arg) {
+    const Execucao *execucao = (const Execucao*)arg;
+    
+    // dup2 limpa o O_CLOEXEC na cópia: só ela sobrevive ao exec
+    if ((execucao->saida_fd >= 0 && dup2(execucao->saida_fd, STDOUT_FILENO) == -1) ||
+        (execucao->erros_fd >= 0 && dup2(execucao->erros_fd, STDERR_FILENO) == -1)) {
+        int erro = errno;
+        ssize_t escritos = write(execucao->aviso_fd, &erro, sizeof(erro));
+        (void)escritos;
+        _exit(127);
+    }
+    
+    execv(execucao->caminho, execucao->argumentos);
+    
+    int erro = errno;
+    ssize_t escritos = write(execucao->aviso_fd, &erro, sizeof(erro));
+    (void)escritos;
+    _exit(127);
+}
+
+pid_t lancar(Lancador lancador, const char *nome, const char *caminho,
+             char *const argumentos[]) {
+    return lancar_redirecionado(lancador, nome, caminho, argumentos, -1, -1);
+}
+
+pid_t lancar_redirecionado(Lancador lancador, const char *nome, const char *caminho,
+                           char *const argumentos[], int saida_fd, int erros_fd) {
+    if (lancador == LANCADOR_POSIX_SPAWN) {
+        // Redirecionamentos como ações do posix_spawn
+        posix_spawn_file_actions_t acoes;
+        posix_spawn_file_actions_init(&acoes);
+        if (saida_fd >= 0) posix_spawn_file_actions_adddup2(&acoes, saida_fd, STDOUT_FILENO);
+        if (erros_fd >= 0) posix_spawn_file_actions_adddup2(&acoes, erros_fd, STDERR_FILENO);
+        
+        // A glibc já espera o exec e devolve o erro dele
+        pid_t pid;
+        int erro = posix_spawn(&pid, caminho, &acoes, NULL, argumentos, environ);
+        posix_spawn_file_actions_destroy(&acoes);
+        if (erro != 0) {
+            errno = erro;
+            return -1;
+        }
+        return pid;
+    }
+    
+    // Pipe de aviso: o exec fecha a ponta de escrita do filho (O_CLOEXEC)
+    int aviso[2];
+    if (pipe2(aviso, O_CLOEXEC) == -1) {
+        return -1;
+    }
+    Execucao execucao = { caminho, argumentos, saida_fd, erros_fd, aviso[1] };
+    
+    pid_t pid;
+    if (lancador == LANCADOR_VFORK) {
+        pid = vfork();
+        if (pid == 0) {
+            executar(&execucao);
+        }
+    } else if (lancador == LANCADOR_CLONE) {
+        // O pai fica suspenso até o exec: a pilha pode ficar no quadro dele
+        char pilha[PILHA_CLONE] __attribute__((aligned(16)));
+        pid = clone(executar, pilha + sizeof(pilha), CLONE_VM | CLONE_VFORK | SIGCHLD, &execucao);
+    } else {
+        pid = fork();
+        if (pid == 0) {
+            rastro_nomear(nome);
+    
+            // Último evento antes da troca de imagem; o fim aparece na coleta pelo pai
+            rastro_marcar("exec", -1);
+            executar(&execucao);
+        }
+    }
+    int erro_criacao = errno;
+    close(aviso[1]);
+    
+    if (pid < 0) {
+        close(aviso[0]);
+        errno = erro_criacao;
+        return -1;
+    }
+    
+    // Fim de arquivo: exec feito; um inteiro: o errno do exec que falhou
+    int erro;
+    ssize_t lidos;
+    do {
+        lidos = read(aviso[0], &erro, sizeof(erro));
+    } while (lidos == -1 && errno == EINTR);
+    close(aviso[0]);
+    
+    if (lidos == sizeof(erro)) {
+        waitpid(pid, NULL, 0);
+        errno = erro;
+        return -1;
+    }
+    return pid;
+}
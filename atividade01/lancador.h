@@ -0,0 +1,68 @@
+/*
+ * Instituição: Universidade Federal da Paraíba
+ * Disciplina: Sistemas Operacionais I
+ * Unidade 1 - Atividade 1
+ *
+ * Autor: Rodrigo Monteiro Fortes de Oliveira, 20240097664
+ *
+ * Nome do Módulo: lancador.h
+ *
+ * Descrição:
+ *     Criação de um processo que executa um comando, com o mecanismo
+ *     escolhido:
+ *
+ *       fork         fork() seguido de execv(): copia as tabelas de
+ *                    páginas do pai (custo que cresce com o RSS) só
+ *                    para descartá-las no exec;
+ *       vfork        vfork(): o filho usa a memória do pai, suspenso
+ *                    até o exec, sem copiar nada;
+ *       posix_spawn  posix_spawn() da glibc (clone com CLONE_VFORK);
+ *       clone        clone(CLONE_VM | CLONE_VFORK) direto, com a pilha
+ *                    do filho emprestada do pai suspenso.
+ *
+ *     Em todos, lancar() só retorna depois que o filho trocou de imagem
+ *     (ou falhou): o exec fecha um pipe com O_CLOEXEC e, se falhar, o
+ *     filho envia o errno por ele. Assim o tempo da chamada é a latência
+ *     do lançamento até o exec, comparável entre os mecanismos.
+ *
+ *     Só no fork o filho executa código do programa antes do exec; é
+ *     nele que o nome do processo e o evento "exec" vão para o rastro.
+ *     Nos demais o filho compartilha a memória do pai e não registra.
+ *
+ *     lancar_redirecionado() também troca a saída padrão e a de erros
+ *     do filho antes do exec (dup2, ou as ações do posix_spawn); é o que
+ *     o supervisor (supervisor.h) usa para capturá-las.
+ */
+
+#ifndef LANCADOR_H
+#define LANCADOR_H
+
+#include <sys/types.h>
+
+typedef enum {
+    LANCADOR_FORK = 0,
+    LANCADOR_VFORK,
+    LANCADOR_POSIX_SPAWN,
+    LANCADOR_CLONE,
+    N_LANCADORES
+} Lancador;
+
+// Lê o nome do mecanismo ("fork", "vfork", "posix_spawn" ou "clone");
+// retorna -1 se for desconhecido
+int lancador_ler(const char *texto, Lancador *lancador);
+
+// Nome do mecanismo
+const char* lancador_nome(Lancador lancador);
+
+// Executa 'caminho' com os argumentos dados (terminados em NULL) em um
+// processo novo; 'nome' identifica o filho no rastro. Retorna o PID ou
+// -1 com errno se a criação ou o exec falhar (o filho já foi coletado).
+pid_t lancar(Lancador lancador, const char *nome, const char *caminho,
+             char *const argumentos[]);
+
+// Como lancar(), com a saída padrão e a de erros do filho trocadas por
+// 'saida_fd' e 'erros_fd' (-1 mantém a herdada do pai)
+pid_t lancar_redirecionado(Lancador lancador, const char *nome, const char *caminho,
+                           char *const argumentos[], int saida_fd, int erros_fd);
+
+#endif
@@ -0,0 +1,489 @@
+/*
+ * Instituição: Universidade Federal da Paraíba
+ * Disciplina: Sistemas Operacionais I
+ * Unidade 1 - Atividade 1
+ *
+ * Autor: Rodrigo Monteiro Fortes de Oliveira, 20240097664
+ *
+ * Nome do Módulo: supervisor.c
+ *
+ * Descrição:
+ *     Implementação do supervisor declarado em supervisor.h. Cada evento
+ *     do epoll carrega a posição do filho e o que ficou pronto (pidfd,
+ *     pipe de saída ou de erros). pidfd_open e pidfd_send_signal são
+ *     chamados por syscall(), como o perf_event_open da Atividade 2.
+ */
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <sys/sendfile.h>
+#include <sys/syscall.h>
+#include <sys/wait.h>
+#include "supervisor.h"
+#include "../atividade02/src/tempo.h"
+
+#ifndef P_PIDFD
+#define P_PIDFD 3
+#endif
+
+// Tipos de evento (dois bits menos significativos do dado do epoll)
+#define EVENTO_PROCESSO 0
+#define EVENTO_SAIDA 1
+#define EVENTO_ERROS 2
+
+#define MAX_EVENTOS 64
+#define BLOCO_SPLICE (64 * 1024)
+
+// Filho acompanhado (pid 0: posição livre)
+typedef struct {
+    pid_t pid;
+    int pidfd;
+    int leitura[2];         // pontas de leitura dos pipes (-1: sem captura ou já no fim)
+    int destino[2];         // memfd ou arquivo de cada fluxo
+    size_t bytes[2];
+    const char *nome;
+    void *contexto;
+    uint64_t inicio_ns;
+    uint64_t prazo_ns;      // 0: sem prazo
+    int expirou;
+    int terminou;           // pidfd sinalizado, ainda não entregue
+} Acompanhado;
+
+struct Supervisor {
+    int epoll_fd;
+    Captura captura;
+    const char *diretorio;
+    Acompanhado *filhos;
+    int capacidade;
+    int ativos;
+    int *prontos;           // posições que terminaram, na ordem dos eventos
+    int n_prontos;
+};
+
+static uint64_t agora_ns(void) {
+    struct timespec instante;
+    marcar_instante(&instante);
+    return (uint64_t)instante.tv_sec * 1000000000ULL + instante.tv_nsec;
+}
+
+// Move o que houver no pipe para o destino. Retorna 1 no fim do arquivo,
+// 0 quando o pipe esvaziou e -1 em caso de erro.
+static int drenar(int origem, int destino, size_t *bytes) {
+    for (;;) {
+        ssize_t movidos = splice(origem, NULL, destino, NULL, BLOCO_SPLICE,
+                                 SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+        if (movidos > 0) {
+            *bytes += movidos;
+            continue;
+        }
+        if (movidos == 0) return 1;
+        if (errno == EINTR) continue;
+        if (errno == EAGAIN) return 0;
+        if (errno != EINVAL) return -1;
+
+        // Destino sem suporte a splice: cópia comum
+        char bloco[4096];
+        ssize_t lidos = read(origem, bloco, sizeof(bloco));
+        if (lidos == 0) return 1;
+        if (lidos < 0) return errno == EAGAIN ? 0 : -1;
+        if (write(destino, bloco, lidos) != lidos) return -1;
+        *bytes += lidos;
+    }
+}
+
+// Fecha a ponta de leitura de um fluxo (e o arquivo, fora da memória)
+static void fechar_fluxo(Supervisor *supervisor, Acompanhado *filho, int fluxo) {
+    if (filho->leitura[fluxo] >= 0) {
+        epoll_ctl(supervisor->epoll_fd, EPOLL_CTL_DEL, filho->leitura[fluxo], NULL);
+        close(filho->leitura[fluxo]);
+        filho->leitura[fluxo] = -1;
+    }
+    if (supervisor->captura == CAPTURA_ARQUIVO && filho->destino[fluxo] >= 0) {
+        close(filho->destino[fluxo]);
+        filho->destino[fluxo] = -1;
+    }
+}
+
+// Descritor registrado no epoll com a posição do filho e o tipo do evento
+static int registrar(Supervisor *supervisor, int fd, int posicao, int tipo) {
+    struct epoll_event evento;
+    evento.events = EPOLLIN;
+    evento.data.u64 = ((uint64_t)posicao << 2) | tipo;
+    return epoll_ctl(supervisor->epoll_fd, EPOLL_CTL_ADD, fd, &evento);
+}
+
+// Posição livre (aumenta as listas quando cheias); -1 em caso de erro
+static int reservar_posicao(Supervisor *supervisor) {
+    for (int i = 0; i < supervisor->capacidade; i++) {
+        if (supervisor->filhos[i].pid == 0) return i;
+    }
+
+    int capacidade = supervisor->capacidade > 0 ? supervisor->capacidade * 2 : 16;
+    Acompanhado *filhos = (Acompanhado*)realloc(supervisor->filhos, capacidade * sizeof(Acompanhado));
+    if (filhos == NULL) return -1;
+    supervisor->filhos = filhos;
+    int *prontos = (int*)realloc(supervisor->prontos, capacidade * sizeof(int));
+    if (prontos == NULL) return -1;
+    supervisor->prontos = prontos;
+
+    memset(&filhos[supervisor->capacidade], 0,
+           (capacidade - supervisor->capacidade) * sizeof(Acompanhado));
+    int posicao = supervisor->capacidade;
+    supervisor->capacidade = capacidade;
+    return posicao;
+}
+
+// Abre o pidfd do filho e o registra; os fluxos já devem estar preenchidos
+static int iniciar_acompanhamento(Supervisor *supervisor, int posicao, pid_t pid,
+                                  const char *nome, double prazo_ms, void *contexto) {
+    Acompanhado *filho = &supervisor->filhos[posicao];
+    filho->pidfd = (int)syscall(SYS_pidfd_open, pid, 0);
+    if (filho->pidfd == -1) return -1;
+    if (registrar(supervisor, filho->pidfd, posicao, EVENTO_PROCESSO) == -1) {
+        int erro = errno;
+        close(filho->pidfd);
+        errno = erro;
+        return -1;
+    }
+
+    filho->pid = pid;
+    filho->nome = nome;
+    filho->contexto = contexto;
+    filho->inicio_ns = agora_ns();
+    filho->prazo_ns = prazo_ms > 0 ? filho->inicio_ns + (uint64_t)(prazo_ms * 1e6) : 0;
+    filho->expirou = 0;
+    filho->terminou = 0;
+    supervisor->ativos++;
+    return 0;
+}
+
+Supervisor* supervisor_criar(Captura captura, const char *diretorio) {
+    Supervisor *supervisor = (Supervisor*)calloc(1, sizeof(Supervisor));
+    if (supervisor == NULL) {
+        fprintf(stderr, "Erro ao alocar memória para o supervisor\n");
+        return NULL;
+    }
+
+    supervisor->epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    if (supervisor->epoll_fd == -1) {
+        perror("Erro ao criar o epoll do supervisor");
+        free(supervisor);
+        return NULL;
+    }
+    supervisor->captura = captura;
+    supervisor->diretorio = diretorio;
+
+    // Até três descritores por filho (pidfd e dois pipes), mais os destinos
+    struct rlimit limite;
+    if (getrlimit(RLIMIT_NOFILE, &limite) == 0 && limite.rlim_cur < limite.rlim_max) {
+        limite.rlim_cur = limite.rlim_max;
+        setrlimit(RLIMIT_NOFILE, &limite);
+    }
+    return supervisor;
+}
+
+pid_t supervisor_lancar(Supervisor *supervisor, Lancador lancador, const char *nome,
+                        const char *caminho, char *const argumentos[],
+                        double prazo_ms, void *contexto) {
+    int posicao = reservar_posicao(supervisor);
+    if (posicao < 0) {
+        errno = ENOMEM;
+        return -1;
+    }
+    Acompanhado *filho = &supervisor->filhos[posicao];
+    int escrita[2] = { -1, -1 };
+    for (int fluxo = 0; fluxo < 2; fluxo++) {
+        filho->leitura[fluxo] = -1;
+        filho->destino[fluxo] = -1;
+        filho->bytes[fluxo] = 0;
+    }
+
+    int erro = 0;
+    for (int fluxo = 0; fluxo < 2 && supervisor->captura != CAPTURA_NENHUMA && erro == 0; fluxo++) {
+        int canal[2];
+        if (pipe2(canal, O_CLOEXEC) == -1) {
+            erro = errno;
+            break;
+        }
+        filho->leitura[fluxo] = canal[0];
+        escrita[fluxo] = canal[1];
+        fcntl(canal[0], F_SETFL, O_NONBLOCK);
+
+        if (supervisor->captura == CAPTURA_MEMORIA) {
+            filho->destino[fluxo] = memfd_create(nome, MFD_CLOEXEC);
+        } else {
+            char caminho_destino[4096];
+            snprintf(caminho_destino, sizeof(caminho_destino), "%s/%s.%s", supervisor->diretorio,
+                     nome, fluxo == 0 ? "saida" : "erros");
+            filho->destino[fluxo] = open(caminho_destino, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        }
+        if (filho->destino[fluxo] == -1) erro = errno;
+    }
+
+    pid_t pid = -1;
+    if (erro == 0) {
+        pid = lancar_redirecionado(lancador, nome, caminho, argumentos, escrita[0], escrita[1]);
+        if (pid < 0) erro = errno;
+    }
+
+    // O pai não escreve nos pipes: só o filho mantém as pontas de escrita
+    for (int fluxo = 0; fluxo < 2; fluxo++) {
+        if (escrita[fluxo] >= 0) close(escrita[fluxo]);
+    }
+
+    if (erro == 0) {
+        for (int fluxo = 0; fluxo < 2 && erro == 0; fluxo++) {
+            if (filho->leitura[fluxo] >= 0 &&
+                registrar(supervisor, filho->leitura[fluxo], posicao, EVENTO_SAIDA + fluxo) == -1) {
+                erro = errno;
+            }
+        }
+        if (erro == 0 && iniciar_acompanhamento(supervisor, posicao, pid, nome, prazo_ms, contexto) == -1) {
+            erro = errno;
+        }
+        if (erro != 0) {
+            // Sem como acompanhá-lo: encerra e coleta já
+            kill(pid, SIGKILL);
+            waitpid(pid, NULL, 0);
+        }
+    }
+
+    if (erro != 0) {
+        for (int fluxo = 0; fluxo < 2; fluxo++) {
+            fechar_fluxo(supervisor, filho, fluxo);
+            if (filho->destino[fluxo] >= 0) close(filho->destino[fluxo]);
+            filho->destino[fluxo] = -1;
+        }
+        filho->pid = 0;
+        errno = erro;
+        return -1;
+    }
+    return pid;
+}
+
+int supervisor_acompanhar(Supervisor *supervisor, pid_t pid, const char *nome,
+                          double prazo_ms, void *contexto) {
+    int posicao = reservar_posicao(supervisor);
+    if (posicao < 0) {
+        errno = ENOMEM;
+        return -1;
+    }
+    Acompanhado *filho = &supervisor->filhos[posicao];
+    for (int fluxo = 0; fluxo < 2; fluxo++) {
+        filho->leitura[fluxo] = -1;
+        filho->destino[fluxo] = -1;
+        filho->bytes[fluxo] = 0;
+    }
+
+    if (iniciar_acompanhamento(supervisor, posicao, pid, nome, prazo_ms, contexto) == -1) {
+        filho->pid = 0;
+        return -1;
+    }
+    return 0;
+}
+
+int supervisor_ativos(const Supervisor *supervisor) {
+    return supervisor->ativos;
+}
+
+// Mata os filhos cujo prazo passou; retorna o tempo até o próximo prazo
+// em ms (-1: nenhum prazo pendente)
+static int verificar_prazos(Supervisor *supervisor) {
+    uint64_t agora = agora_ns();
+    uint64_t proximo = 0;
+
+    for (int i = 0; i < supervisor->capacidade; i++) {
+        Acompanhado *filho = &supervisor->filhos[i];
+        if (filho->pid == 0 || filho->prazo_ns == 0 || filho->expirou || filho->terminou) continue;
+
+        if (agora >= filho->prazo_ns) {
+            // Pelo pidfd: atinge este processo mesmo que o PID já tenha sido reusado
+            if (syscall(SYS_pidfd_send_signal, filho->pidfd, SIGKILL, NULL, 0) == 0) {
+                filho->expirou = 1;
+            }
+        } else if (proximo == 0 || filho->prazo_ns < proximo) {
+            proximo = filho->prazo_ns;
+        }
+    }
+
+    if (proximo == 0) return -1;
+    return (int)((proximo - agora + 999999) / 1000000);
+}
+
+int supervisor_proximo(Supervisor *supervisor, Termino *termino) {
+    while (supervisor->n_prontos == 0) {
+        if (supervisor->ativos == 0) return -1;
+
+        struct epoll_event eventos[MAX_EVENTOS];
+        int espera = verificar_prazos(supervisor);
+        int n = epoll_wait(supervisor->epoll_fd, eventos, MAX_EVENTOS, espera);
+        if (n == -1) {
+            if (errno == EINTR) continue;
+            perror("Erro ao aguardar eventos dos filhos");
+            return -1;
+        }
+
+        for (int e = 0; e < n; e++) {
+            int posicao = (int)(eventos[e].data.u64 >> 2);
+            int tipo = (int)(eventos[e].data.u64 & 3);
+            Acompanhado *filho = &supervisor->filhos[posicao];
+
+            if (tipo == EVENTO_PROCESSO) {
+                if (!filho->terminou) {
+                    filho->terminou = 1;
+                    epoll_ctl(supervisor->epoll_fd, EPOLL_CTL_DEL, filho->pidfd, NULL);
+                    supervisor->prontos[supervisor->n_prontos++] = posicao;
+                }
+                continue;
+            }
+
+            // Dados (ou fim) em um pipe: move para o destino
+            int fluxo = tipo - EVENTO_SAIDA;
+            if (filho->leitura[fluxo] >= 0 &&
+                drenar(filho->leitura[fluxo], filho->destino[fluxo], &filho->bytes[fluxo]) != 0) {
+                fechar_fluxo(supervisor, filho, fluxo);
+            }
+        }
+    }
+
+    // Entrega o primeiro que terminou
+    int posicao = supervisor->prontos[0];
+    supervisor->n_prontos--;
+    memmove(&supervisor->prontos[0], &supervisor->prontos[1], supervisor->n_prontos * sizeof(int));
+    Acompanhado *filho = &supervisor->filhos[posicao];
+
+    siginfo_t informacao;
+    memset(&informacao, 0, sizeof(informacao));
+    while (waitid((idtype_t)P_PIDFD, (id_t)filho->pidfd, &informacao, WEXITED) == -1 && errno == EINTR) {
+    }
+    close(filho->pidfd);
+
+    // O que o comando escreveu antes de terminar ainda pode estar nos pipes
+    // (descendentes que herdaram a saída não são aguardados)
+    for (int fluxo = 0; fluxo < 2; fluxo++) {
+        if (filho->leitura[fluxo] >= 0) {
+            drenar(filho->leitura[fluxo], filho->destino[fluxo], &filho->bytes[fluxo]);
+            fechar_fluxo(supervisor, filho, fluxo);
+        }
+    }
+
+    termino->pid = filho->pid;
+    termino->nome = filho->nome;
+    termino->contexto = filho->contexto;
+    termino->expirou = filho->expirou;
+    termino->duracao_ms = (agora_ns() - filho->inicio_ns) / 1e6;
+    if (informacao.si_code == CLD_EXITED) {
+        termino->codigo = informacao.si_status;
+        termino->sinal = 0;
+    } else {
+        termino->codigo = -1;
+        termino->sinal = informacao.si_status;
+    }
+    termino->saida_fd = filho->destino[0];
+    termino->erros_fd = filho->destino[1];
+    termino->bytes_saida = filho->bytes[0];
+    termino->bytes_erros = filho->bytes[1];
+
+    filho->pid = 0;
+    supervisor->ativos--;
+    return 0;
+}
+
+// Seções aninhadas abertas por este processo (a trava é do processo)
+static int nivel_trava = 0;
+
+// Trava de registro (fcntl) sobre todo o arquivo da saída padrão
+static void travar_registro(short tipo) {
+    struct flock trava = { 0 };
+    trava.l_type = tipo;
+    trava.l_whence = SEEK_SET;
+    int ret;
+    do {
+        ret = fcntl(STDOUT_FILENO, F_SETLKW, &trava);
+    } while (ret == -1 && errno == EINTR);
+}
+
+void supervisor_travar_saida(void) {
+    if (nivel_trava++ > 0) return;
+
+    // Sem suporte à trava (ex.: saída fechada) a escrita segue sem ela
+    travar_registro(F_WRLCK);
+    fflush(stdout);
+}
+
+void supervisor_destravar_saida(void) {
+    if (nivel_trava == 0 || --nivel_trava > 0) return;
+
+    fflush(stdout);
+    travar_registro(F_UNLCK);
+}
+
+// Copia 'bytes' do início de um buffer para a saída padrão
+static void copiar_buffer(int origem, size_t bytes) {
+    off_t posicao = 0;
+    while ((size_t)posicao < bytes) {
+        ssize_t enviados = sendfile(STDOUT_FILENO, origem, &posicao, bytes - posicao);
+        if (enviados > 0) continue;
+        if (enviados == -1 && errno == EINTR) continue;
+        if (enviados == 0 || errno != EINVAL) return;
+
+        // Saída sem suporte a sendfile: cópia comum
+        char bloco[4096];
+        ssize_t lidos = pread(origem, bloco, sizeof(bloco), posicao);
+        if (lidos <= 0 || write(STDOUT_FILENO, bloco, lidos) != lidos) return;
+        posicao += lidos;
+    }
+}
+
+void supervisor_exibir(const Termino *termino) {
+    const int fds[2] = { termino->saida_fd, termino->erros_fd };
+    const size_t bytes[2] = { termino->bytes_saida, termino->bytes_erros };
+
+    // Cabeçalho e conteúdo na mesma seção: outro processo que escreva na
+    // mesma saída (travando-a) não se intercala entre eles
+    supervisor_travar_saida();
+    for (int fluxo = 0; fluxo < 2; fluxo++) {
+        if (fds[fluxo] < 0 || bytes[fluxo] == 0) continue;
+
+        printf("--- %s (%s, %zu B) ---\n", termino->nome, fluxo == 0 ? "saída" : "erros", bytes[fluxo]);
+        fflush(stdout);
+        copiar_buffer(fds[fluxo], bytes[fluxo]);
+    }
+    supervisor_destravar_saida();
+}
+
+void supervisor_liberar(Termino *termino) {
+    if (termino->saida_fd >= 0) close(termino->saida_fd);
+    if (termino->erros_fd >= 0) close(termino->erros_fd);
+    termino->saida_fd = -1;
+    termino->erros_fd = -1;
+}
+
+void supervisor_destruir(Supervisor *supervisor) {
+    if (supervisor == NULL) return;
+
+    for (int i = 0; i < supervisor->capacidade; i++) {
+        Acompanhado *filho = &supervisor->filhos[i];
+        if (filho->pid == 0) continue;
+
+        close(filho->pidfd);
+        for (int fluxo = 0; fluxo < 2; fluxo++) {
+            if (filho->leitura[fluxo] >= 0) close(filho->leitura[fluxo]);
+            if (filho->destino[fluxo] >= 0) close(filho->destino[fluxo]);
+        }
+    }
+    close(supervisor->epoll_fd);
+    free(supervisor->filhos);
+    free(supervisor->prontos);
+    free(supervisor);
+}
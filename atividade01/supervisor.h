@@ -0,0 +1,106 @@
+/*
+ * Instituição: Universidade Federal da Paraíba
+ * Disciplina: Sistemas Operacionais I
+ * Unidade 1 - Atividade 1
+ *
+ * Autor: Rodrigo Monteiro Fortes de Oliveira, 20240097664
+ *
+ * Nome do Módulo: supervisor.h
+ *
+ * Descrição:
+ *     Supervisor de processos filhos orientado a eventos, no lugar de
+ *     wait(NULL) em ordem fixa. Cada filho acompanhado tem um pidfd
+ *     (pidfd_open) registrado em um epoll: supervisor_proximo() entrega
+ *     o primeiro filho que terminar, qualquer que seja, e coleta-o com
+ *     waitid(P_PIDFD). Um filho lento não atrasa a coleta dos outros.
+ *
+ *     Cada filho pode ter um prazo: ao estourá-lo, o supervisor o mata
+ *     com pidfd_send_signal(SIGKILL), sem o risco de atingir outro
+ *     processo que tenha reaproveitado o PID.
+ *
+ *     Os comandos lançados por supervisor_lancar() têm a saída padrão e
+ *     a de erros ligadas a pipes. Conforme os dados chegam, o epoll os
+ *     avisa e splice() os move do pipe para o destino sem passar pela
+ *     memória do programa:
+ *
+ *       CAPTURA_MEMORIA  um memfd por fluxo (buffer em memória), exibido
+ *                        de uma vez quando o comando termina, sem mistura
+ *                        com a saída dos outros;
+ *       CAPTURA_ARQUIVO  os arquivos diretorio/nome.saida e nome.erros.
+ *
+ *     Todos os descritores são criados com O_CLOEXEC. Um processo filho
+ *     criado com fork() (sem exec) que vá supervisionar os próprios
+ *     filhos deve chamar supervisor_destruir() na cópia herdada.
+ */
+
+#ifndef SUPERVISOR_H
+#define SUPERVISOR_H
+
+#include <stddef.h>
+#include <sys/types.h>
+#include "lancador.h"
+
+typedef enum {
+    CAPTURA_NENHUMA = 0,    // o filho herda a saída do pai
+    CAPTURA_MEMORIA,
+    CAPTURA_ARQUIVO
+} Captura;
+
+typedef struct Supervisor Supervisor;
+
+// Filho que terminou, como entregue por supervisor_proximo()
+typedef struct {
+    pid_t pid;
+    const char *nome;
+    void *contexto;         // o ponteiro dado ao acompanhar o filho
+    int codigo;             // código de saída (-1 se terminou por sinal)
+    int sinal;              // sinal que o terminou (0 se saiu normalmente)
+    int expirou;            // morto pelo supervisor ao estourar o prazo
+    double duracao_ms;      // do início do acompanhamento até o término
+    int saida_fd;           // memfd da saída capturada (-1 fora de CAPTURA_MEMORIA)
+    int erros_fd;
+    size_t bytes_saida;
+    size_t bytes_erros;
+} Termino;
+
+// Cria um supervisor; 'diretorio' só é usado com CAPTURA_ARQUIVO.
+// Eleva o limite de descritores abertos ao máximo permitido.
+// Retorna NULL em caso de erro.
+Supervisor* supervisor_criar(Captura captura, const char *diretorio);
+
+// Lança um comando (lancar_redirecionado) com a saída capturada e passa
+// a acompanhá-lo. 'prazo_ms' <= 0: sem prazo. 'nome' deve continuar
+// válido até o término. Retorna o PID ou -1 com errno.
+pid_t supervisor_lancar(Supervisor *supervisor, Lancador lancador, const char *nome,
+                        const char *caminho, char *const argumentos[],
+                        double prazo_ms, void *contexto);
+
+// Acompanha um filho já criado (ex.: por fork), sem captura
+int supervisor_acompanhar(Supervisor *supervisor, pid_t pid, const char *nome,
+                          double prazo_ms, void *contexto);
+
+// Filhos acompanhados que ainda não foram entregues
+int supervisor_ativos(const Supervisor *supervisor);
+
+// Espera o próximo filho terminar, coleta-o e drena a saída dele.
+// Retorna 0, ou -1 se não houver filhos acompanhados ou em caso de erro.
+int supervisor_proximo(Supervisor *supervisor, Termino *termino);
+
+// Exibe na saída padrão a saída capturada em memória, com o nome do
+// comando, dentro de uma seção com a saída travada
+void supervisor_exibir(const Termino *termino);
+
+// Seção com a saída padrão travada (trava de registro do fcntl, que vale
+// entre processos mesmo com o descritor herdado do pai): o que for
+// escrito nela não se intercala com a seção de outro processo. As seções
+// podem ser aninhadas; a última a fechar esvazia o buffer e destrava.
+void supervisor_travar_saida(void);
+void supervisor_destravar_saida(void);
+
+// Fecha os buffers do término
+void supervisor_liberar(Termino *termino);
+
+// Fecha os descritores e libera o supervisor (não mata os filhos)
+void supervisor_destruir(Supervisor *supervisor);
+
+#endif
@@ -0,0 +1,236 @@
+/*
+ * Instituição: Universidade Federal da Paraíba
+ * Disciplina: Sistemas Operacionais I
+ * Unidade 1 - Atividade 2
+ *
+ * Autor: Rodrigo Monteiro Fortes de Oliveira, 20240097664
+ *
+ * Nome do Módulo: afinidade.c
+ *
+ * Descrição:
+ *     Implementação das políticas de posicionamento declaradas em
+ *     afinidade.h. A ordem das CPUs é calculada uma única vez, ao ler a
+ *     opção, e depois só é consultada pelo índice do trabalhador.
+ */
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sched.h>
+#include "afinidade.h"
+
+// Nós NUMA procurados em /sys/devices/system/node
+#define MAX_NOS 64
+
+// Posição de uma CPU na topologia
+typedef struct {
+    int cpu;
+    int no;
+    int pacote;
+    int nucleo;
+    int irma;          // 0 na primeira CPU do núcleo, 1 na segunda (SMT)...
+    int posicao_no;    // ordem do núcleo dentro do nó
+} InfoCpu;
+
+// Lê um inteiro de um arquivo do sysfs (-1 se não existir)
+static int ler_inteiro(const char *caminho) {
+    FILE *arquivo = fopen(caminho, "r");
+    if (arquivo == NULL) return -1;
+    int valor;
+    if (fscanf(arquivo, "%d", &valor) != 1) valor = -1;
+    fclose(arquivo);
+    return valor;
+}
+
+// Lê uma lista no formato do núcleo ("0,2,4-7") para 'cpus'; retorna a
+// quantidade lida ou -1 se o texto for inválido
+static int ler_lista_cpus(const char *texto, int *cpus, int maximo) {
+    int quantidade = 0;
+    const char *p = texto;
+    
+    while (*p != '\0' && *p != '\n') {
+        char *fim;
+        long primeira = strtol(p, &fim, 10);
+        if (fim == p || primeira < 0) return -1;
+        long ultima = primeira;
+        if (*fim == '-') {
+            p = fim + 1;
+            ultima = strtol(p, &fim, 10);
+            if (fim == p || ultima < primeira) return -1;
+        }
+        for (long cpu = primeira; cpu <= ultima && quantidade < maximo; cpu++) {
+            cpus[quantidade++] = (int)cpu;
+        }
+        if (*fim == ',') fim++;
+        else if (*fim != '\0' && *fim != '\n') return -1;
+        p = fim;
+    }
+    
+    return quantidade;
+}
+
+// Nó NUMA de cada CPU, pelas listas de /sys/devices/system/node/nodeN/cpulist
+static void ler_nos(InfoCpu *info, int n_cpus) {
+    static int cpus_no[AFINIDADE_MAX_CPUS];
+    
+    for (int no = 0; no < MAX_NOS; no++) {
+        char caminho[64], texto[4096];
+        snprintf(caminho, sizeof(caminho), "/sys/devices/system/node/node%d/cpulist", no);
+        FILE *arquivo = fopen(caminho, "r");
+        if (arquivo == NULL) continue;
+        int lido = fgets(texto, sizeof(texto), arquivo) != NULL;
+        fclose(arquivo);
+        if (!lido) continue;
+    
+        int quantidade = ler_lista_cpus(texto, cpus_no, AFINIDADE_MAX_CPUS);
+        for (int i = 0; i < quantidade; i++) {
+            for (int c = 0; c < n_cpus; c++) {
+                if (info[c].cpu == cpus_no[i]) info[c].no = no;
+            }
+        }
+    }
+}
+
+static int comparar_compacto(const void *a, const void *b) {
+    const InfoCpu *x = (const InfoCpu*)a;
+    const InfoCpu *y = (const InfoCpu*)b;
+    if (x->no != y->no) return x->no - y->no;
+    if (x->pacote != y->pacote) return x->pacote - y->pacote;
+    if (x->nucleo != y->nucleo) return x->nucleo - y->nucleo;
+    return x->cpu - y->cpu;
+}
+
+static int comparar_espalhado(const void *a, const void *b) {
+    const InfoCpu *x = (const InfoCpu*)a;
+    const InfoCpu *y = (const InfoCpu*)b;
+    if (x->irma != y->irma) return x->irma - y->irma;
+    if (x->posicao_no != y->posicao_no) return x->posicao_no - y->posicao_no;
+    if (x->no != y->no) return x->no - y->no;
+    return x->cpu - y->cpu;
+}
+
+// Ordena as CPUs permitidas ao processo segundo a política
+static int ordenar_topologia(Afinidade *afinidade, int espalhado) {
+    cpu_set_t permitidas;
+    if (sched_getaffinity(0, sizeof(permitidas), &permitidas) == -1) {
+        perror("Erro ao consultar a afinidade do processo");
+        return -1;
+    }
+    
+    static InfoCpu info[AFINIDADE_MAX_CPUS];
+    int n_cpus = 0;
+    for (int cpu = 0; cpu < CPU_SETSIZE && n_cpus < AFINIDADE_MAX_CPUS; cpu++) {
+        if (!CPU_ISSET(cpu, &permitidas)) continue;
+    
+        char caminho[96];
+        info[n_cpus].cpu = cpu;
+        info[n_cpus].no = 0;
+        snprintf(caminho, sizeof(caminho), "/sys/devices/system/cpu/cpu%d/topology/physical_package_id", cpu);
+        info[n_cpus].pacote = ler_inteiro(caminho);
+        snprintf(caminho, sizeof(caminho), "/sys/devices/system/cpu/cpu%d/topology/core_id", cpu);
+        info[n_cpus].nucleo = ler_inteiro(caminho);
+    
+        // Sem topologia: cada CPU é um núcleo próprio
+        if (info[n_cpus].pacote < 0 || info[n_cpus].nucleo < 0) {
+            info[n_cpus].pacote = 0;
+            info[n_cpus].nucleo = cpu;
+        }
+        n_cpus++;
+    }
+    ler_nos(info, n_cpus);
+    
+    // Ordem compacta primeiro: dela saem a irmã SMT e a posição do núcleo no nó
+    qsort(info, n_cpus, sizeof(InfoCpu), comparar_compacto);
+    for (int c = 0; c < n_cpus; c++) {
+        int mesmo_nucleo = c > 0 && info[c].no == info[c - 1].no &&
+                           info[c].pacote == info[c - 1].pacote &&
+                           info[c].nucleo == info[c - 1].nucleo;
+        int mesmo_no = c > 0 && info[c].no == info[c - 1].no;
+    
+        info[c].irma = mesmo_nucleo ? info[c - 1].irma + 1 : 0;
+        if (mesmo_nucleo) {
+            info[c].posicao_no = info[c - 1].posicao_no;
+        } else {
+            info[c].posicao_no = mesmo_no ? info[c - 1].posicao_no + 1 : 0;
+        }
+    }
+    if (espalhado) {
+        qsort(info, n_cpus, sizeof(InfoCpu), comparar_espalhado);
+    }
+    
+    for (int c = 0; c < n_cpus; c++) {
+        afinidade->cpus[c] = info[c].cpu;
+    }
+    afinidade->n_cpus = n_cpus;
+    return n_cpus > 0 ? 0 : -1;
+}
+
+int afinidade_ler(const char *texto, Afinidade *afinidade) {
+    afinidade->n_cpus = 0;
+    
+    if (strcmp(texto, "compacto") == 0 || strcmp(texto, "espalhado") == 0) {
+        afinidade->politica = texto[0] == 'c' ? "compacto" : "espalhado";
+        return ordenar_topologia(afinidade, texto[0] == 'e');
+    }
+    
+    // Lista explícita: cada CPU precisa estar entre as permitidas
+    cpu_set_t permitidas;
+    if (sched_getaffinity(0, sizeof(permitidas), &permitidas) == -1) {
+        perror("Erro ao consultar a afinidade do processo");
+        return -1;
+    }
+    int quantidade = ler_lista_cpus(texto, afinidade->cpus, AFINIDADE_MAX_CPUS);
+    if (quantidade <= 0) {
+        return -1;
+    }
+    for (int i = 0; i < quantidade; i++) {
+        if (afinidade->cpus[i] >= CPU_SETSIZE || !CPU_ISSET(afinidade->cpus[i], &permitidas)) {
+            fprintf(stderr, "CPU %d indisponível para o processo\n", afinidade->cpus[i]);
+            return -1;
+        }
+    }
+    afinidade->politica = "lista";
+    afinidade->n_cpus = quantidade;
+    return 0;
+}
+
+int afinidade_cpu(const Afinidade *afinidade, int trabalhador) {
+    if (afinidade == NULL || afinidade->n_cpus == 0) return -1;
+    return afinidade->cpus[trabalhador % afinidade->n_cpus];
+}
+
+void afinidade_atributos(const Afinidade *afinidade, int trabalhador,
+                         pthread_attr_t *atributos) {
+    int cpu = afinidade_cpu(afinidade, trabalhador);
+    if (cpu < 0) return;
+    
+    cpu_set_t conjunto;
+    CPU_ZERO(&conjunto);
+    CPU_SET(cpu, &conjunto);
+    pthread_attr_setaffinity_np(atributos, sizeof(conjunto), &conjunto);
+}
+
+int afinidade_fixar(const Afinidade *afinidade, int trabalhador) {
+    int cpu = afinidade_cpu(afinidade, trabalhador);
+    if (cpu < 0) return 0;
+    
+    cpu_set_t conjunto;
+    CPU_ZERO(&conjunto);
+    CPU_SET(cpu, &conjunto);
+    if (sched_setaffinity(0, sizeof(conjunto), &conjunto) == -1) {
+        perror("Erro ao fixar a afinidade");
+        return -1;
+    }
+    return 0;
+}
+
+void afinidade_exibir(const Afinidade *afinidade) {
+    if (afinidade == NULL || afinidade->n_cpus == 0) return;
+    
+    printf("Afinidade: %s (CPUs", afinidade->politica);
+    for (int c = 0; c < afinidade->n_cpus && c < 16; c++) {
+        printf("%s%d", c == 0 ? " " : ",", afinidade->cpus[c]);
+    }
+    printf("%s)\n", afinidade->n_cpus > 16 ? ",..." : "");
+}
@@ -0,0 +1,63 @@
+/*
+ * Instituição: Universidade Federal da Paraíba
+ * Disciplina: Sistemas Operacionais I
+ * Unidade 1 - Atividade 2
+ *
+ * Autor: Rodrigo Monteiro Fortes de Oliveira, 20240097664
+ *
+ * Nome do Módulo: afinidade.h
+ *
+ * Descrição:
+ *     Política de posicionamento dos trabalhadores (threads ou
+ *     processos) nas CPUs, aplicada com pthread_attr_setaffinity_np na
+ *     criação das threads e com sched_setaffinity nos processos:
+ *
+ *       compacto   ocupa primeiro as CPUs irmãs (SMT) de um núcleo e os
+ *                  núcleos de um mesmo nó NUMA, mantendo os
+ *                  trabalhadores próximos (caches compartilhados);
+ *       espalhado  um trabalhador por núcleo físico, alternando os nós
+ *                  NUMA, e só depois as CPUs irmãs;
+ *       lista      CPUs explícitas, ex.: "0,2,4-7".
+ *
+ *     O trabalhador i usa a CPU i da ordem (com volta ao início se houver
+ *     mais trabalhadores que CPUs). Só entram CPUs já permitidas ao
+ *     processo. A topologia vem de /sys/devices/system; sem ela, cada
+ *     CPU conta como um núcleo do nó 0.
+ */
+
+#ifndef AFINIDADE_H
+#define AFINIDADE_H
+
+#include <pthread.h>
+
+#define AFINIDADE_MAX_CPUS 1024
+
+typedef struct {
+    const char *politica;          // "compacto", "espalhado" ou "lista"
+    int n_cpus;                    // 0: sem política (o escalonador decide)
+    int cpus[AFINIDADE_MAX_CPUS];  // ordem de ocupação pelos trabalhadores
+} Afinidade;
+
+// Sem política: nenhum trabalhador é fixado
+#define AFINIDADE_NENHUMA { NULL, 0, { 0 } }
+
+// Lê a política ("compacto", "espalhado" ou lista de CPUs); retorna -1 se
+// o texto for inválido ou nenhuma CPU da lista estiver disponível
+int afinidade_ler(const char *texto, Afinidade *afinidade);
+
+// CPU do trabalhador (-1 sem política)
+int afinidade_cpu(const Afinidade *afinidade, int trabalhador);
+
+// Prepara 'atributos' para criar a thread do trabalhador já na sua CPU.
+// Sem política (ou afinidade NULL) não altera os atributos.
+void afinidade_atributos(const Afinidade *afinidade, int trabalhador,
+                         pthread_attr_t *atributos);
+
+// Fixa a thread ou o processo atual na CPU do trabalhador; retorna 0
+// também quando não há política
+int afinidade_fixar(const Afinidade *afinidade, int trabalhador);
+
+// Exibe a política e a ordem das CPUs (nada sem política)
+void afinidade_exibir(const Afinidade *afinidade);
+
+#endif
@@ -0,0 +1,580 @@
+/*
+ * Instituição: Universidade Federal da Paraíba
+ * Disciplina: Sistemas Operacionais I
+ * Unidade 1 - Atividade 2
+ *
+ * Autor: Rodrigo Monteiro Fortes de Oliveira, 20240097664
+ *
+ * Nome do Programa: benchmark.c
+ *
+ * Descrição:
+ *     Executa todas as versões do programa (processo único, thread
+ *     única, três processos, três threads e os modos adicionais) para
+ *     uma lista de tamanhos N e de quantidades de threads. Cada
+ *     configuração tem execuções de aquecimento descartadas seguidas
+ *     de repetições medidas; os tempos informados pelos próprios
+ *     programas (relógio monotônico) são resumidos em mínimo, mediana,
+ *     percentis 95 e 99, máximo e desvio padrão e gravados no CSV de -o
+ *     (padrão: resultados_benchmark.csv, distinto do resultados_tempos.csv
+ *     coletado à mão). Para comparar a cauda (p99, máximo) use muitas
+ *     repetições (-r 100).
+ *
+ *     O modo em lote (series) processa 1.000 séries de tamanhos variados
+ *     em uma execução; as colunas Series_por_s e Valores_por_s do CSV
+ *     trazem a vazão pela mediana do tempo total (séries só nesse modo).
+ *
+ *     Com -f todas as versões leem o mesmo arquivo binário (gerado pelo
+ *     converter) em vez de gerar valores aleatórios, e N passa a ser a
+ *     quantidade gravada no arquivo. Com -S todas as versões geram os
+ *     valores com a mesma semente, e cada N recebe a mesma entrada.
+ *
+ *     Com -c as versões são executadas com ESTATISTICAS_CONTADORES=1 e
+ *     informam contadores de desempenho por fase (contadores.h). O CSV
+ *     principal ganha a mediana dos totais de cada contador e o arquivo
+ *     dado em -c recebe uma linha por fase, com as medianas de tempo e
+ *     de cada contador; eventos indisponíveis ficam em branco.
+ *
+ *     Com -l modo as versões são executadas no modo de latência
+ *     (ESTATISTICAS_LATENCIA=modo, ver latencia.h): "1" trava e
+ *     pré-carrega a memória; "fifo" também usa SCHED_FIFO, se permitido.
+ *
+ * Uso:
+ *     ./benchmark [-d dir_binarios] [-n 1000,10000,...] [-t 1,2,4]
+ *                 [-w aquecimento] [-r repetições] [-o saida.csv]
+ *                 [-f arquivo.bin] [-S semente] [-c fases.csv] [-l 1|fifo]
+ *
+ * Compilação:
+ *     gcc -O2 benchmark.c dados.c -o benchmark -lm
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include "dados.h"
+#include "contadores.h"
+
+#define MAX_LISTA 32
+#define MAX_ARGUMENTOS 16
+#define TAMANHO_SAIDA 65536
+
+// Uma versão do programa a ser medida
+typedef struct {
+    const char *metodo;     // nome na coluna Metodo do CSV
+    const char *programa;   // executável
+    const char *opcoes;     // opções extras separadas por espaço (ou NULL)
+    int trabalhadores;      // processos/threads usados (0: varia com -t)
+} Variante;
+
+static const Variante VARIANTES[] = {
+    { "Single-Process",                      "single_process", NULL,    1 },
+    { "Single Thread",                       "single_thread",  NULL,    1 },
+    { "Processos (3)",                       "processos",      NULL,    3 },
+    { "Processos (3) memória compartilhada", "processos",      "-s",    3 },
+    { "Pool de processos (3)",               "processos",      "-P 3",  3 },
+    { "Threads (3)",                         "threads",        NULL,    3 },
+    { "Threads (3) pool",                    "threads",        "-p",    3 },
+    { "Threads dados",                       "threads",        "-d",    0 },
+    { "Threads dados pool",                  "threads",        "-d -p", 0 },
+    { "Lote de séries (1000)",               "series",         "-b 1000 -o /dev/null", 0 },
+};
+
+#define N_VARIANTES (sizeof(VARIANTES) / sizeof(VARIANTES[0]))
+
+// Colunas da tabela de contadores: tempo da fase seguido dos eventos
+#define COLUNAS_FASE (1 + N_CONTADORES)
+
+static const char *const NOMES_COLUNAS[COLUNAS_FASE] = {
+    "Tempo_ms", "Ciclos", "Instrucoes", "Falhas_Cache", "Desvios_Errados",
+    "Trocas_Contexto", "Faltas_Pagina"
+};
+
+// Contadores de uma fase em uma execução (NAN: evento indisponível)
+typedef struct {
+    char nome[32];
+    double colunas[COLUNAS_FASE];
+} MedicaoFase;
+
+// Tempos informados por uma execução
+typedef struct {
+    double total;
+    double criacao;   // NAN quando o programa não mede criação
+    double series;    // séries do lote (NAN fora do modo em lote)
+    int n_fases;      // linhas da tabela de contadores (0 sem -c)
+    MedicaoFase fases[CONTADORES_MAX_FASES];
+} Medicao;
+
+// Lê uma lista de inteiros separados por vírgula; retorna quantos leu
+int ler_lista(const char *texto, long long *lista, int maximo) {
+    int quantidade = 0;
+    const char *p = texto;
+    
+    while (*p != '\0' && quantidade < maximo) {
+        char *fim;
+        long long valor = strtoll(p, &fim, 10);
+        if (fim == p || valor <= 0) {
+            return -1;
+        }
+        lista[quantidade++] = valor;
+        p = (*fim == ',') ? fim + 1 : fim;
+    }
+    
+    return quantidade;
+}
+
+// Procura "prefixo ... : valor" na saída do programa
+double extrair_tempo(const char *saida, const char *prefixo) {
+    const char *linha = strstr(saida, prefixo);
+    if (linha == NULL) return NAN;
+    
+    const char *dois_pontos = strchr(linha, ':');
+    if (dois_pontos == NULL) return NAN;
+    
+    return strtod(dois_pontos + 1, NULL);
+}
+
+// Lê a tabela "--- CONTADORES DE DESEMPENHO ---": uma fase por linha até a
+// linha em branco, "-" nas colunas de eventos indisponíveis
+int extrair_contadores(const char *saida, MedicaoFase *fases) {
+    const char *linha = strstr(saida, "--- CONTADORES DE DESEMPENHO ---");
+    if (linha == NULL) return 0;
+    
+    // Pula o título e o cabeçalho das colunas
+    for (int i = 0; i < 2 && linha != NULL; i++) {
+        linha = strchr(linha, '\n');
+        if (linha != NULL) linha++;
+    }
+    
+    int n_fases = 0;
+    while (linha != NULL && *linha != '\n' && *linha != '\0' && n_fases < CONTADORES_MAX_FASES) {
+        MedicaoFase *fase = &fases[n_fases];
+        int consumidos;
+        if (sscanf(linha, "%31s%n", fase->nome, &consumidos) != 1) break;
+    
+        const char *p = linha + consumidos;
+        for (int c = 0; c < COLUNAS_FASE; c++) {
+            char *fim;
+            fase->colunas[c] = strtod(p, &fim);
+            if (fim == p) {
+                // "-": evento indisponível
+                while (*p == ' ') p++;
+                if (*p == '-') p++;
+                fase->colunas[c] = NAN;
+            } else {
+                p = fim;
+            }
+        }
+        n_fases++;
+    
+        linha = strchr(linha, '\n');
+        if (linha != NULL) linha++;
+    }
+    return n_fases;
+}
+
+// Executa o programa, captura a saída padrão e extrai os tempos
+int executar(char *const argumentos[], Medicao *medicao) {
+    int pipe_fds[2];
+    if (pipe(pipe_fds) == -1) {
+        perror("Erro ao criar pipe");
+        return -1;
+    }
+    
+    pid_t pid = fork();
+    if (pid < 0) {
+        perror("Erro ao criar fork");
+        close(pipe_fds[0]);
+        close(pipe_fds[1]);
+        return -1;
+    }
+    
+    if (pid == 0) {
+        // Processo filho: a saída padrão vai para o pipe
+        close(pipe_fds[0]);
+        dup2(pipe_fds[1], STDOUT_FILENO);
+        close(pipe_fds[1]);
+        execv(argumentos[0], argumentos);
+        perror("Erro na execução do execv");
+        _exit(EXIT_FAILURE);
+    }
+    
+    // Pai: lê toda a saída (o restante além do buffer é descartado)
+    close(pipe_fds[1]);
+    static char saida[TAMANHO_SAIDA];
+    size_t usados = 0;
+    for (;;) {
+        char descarte[4096];
+        char *destino = usados < sizeof(saida) - 1 ? saida + usados : descarte;
+        size_t espaco = usados < sizeof(saida) - 1 ? sizeof(saida) - 1 - usados : sizeof(descarte);
+    
+        ssize_t lidos = read(pipe_fds[0], destino, espaco);
+        if (lidos == -1 && errno == EINTR) continue;
+        if (lidos <= 0) break;
+        if (destino == saida + usados) usados += lidos;
+    }
+    saida[usados] = '\0';
+    close(pipe_fds[0]);
+    
+    int status;
+    if (waitpid(pid, &status, 0) == -1 || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+        fprintf(stderr, "Falha ao executar %s\n", argumentos[0]);
+        return -1;
+    }
+    
+    medicao->total = extrair_tempo(saida, "Tempo total de execução");
+    medicao->criacao = extrair_tempo(saida, "Tempo de criação");
+    if (isnan(medicao->criacao)) {
+        medicao->criacao = extrair_tempo(saida, "Tempo de preparação do pool");
+    }
+    medicao->series = extrair_tempo(saida, "Séries processadas");
+    medicao->n_fases = extrair_contadores(saida, medicao->fases);
+    
+    return isnan(medicao->total) ? -1 : 0;
+}
+
+int comparar_double(const void *a, const void *b) {
+    double da = *((const double*)a);
+    double db = *((const double*)b);
+    
+    if (da < db) return -1;
+    if (da > db) return 1;
+    return 0;
+}
+
+// Mediana dos valores que não são NAN (NAN se não houver nenhum)
+double mediana_disponivel(double *amostras, int n) {
+    int validas = 0;
+    for (int i = 0; i < n; i++) {
+        if (!isnan(amostras[i])) amostras[validas++] = amostras[i];
+    }
+    if (validas == 0) return NAN;
+    
+    qsort(amostras, validas, sizeof(double), comparar_double);
+    return (validas % 2 == 0) ? (amostras[validas/2 - 1] + amostras[validas/2]) / 2.0
+                              : amostras[validas/2];
+}
+
+// Grava o valor com a precisão dada, ou deixa a célula vazia se for NAN
+void gravar_celula(FILE *csv, double valor, int casas) {
+    fprintf(csv, ",");
+    if (!isnan(valor)) fprintf(csv, "%.*f", casas, valor);
+}
+
+// Percentil pelo posto mais próximo (amostras em ordem crescente)
+double percentil(const double *amostras, int n, double p) {
+    int posto = (int)ceil(p * n) - 1;
+    return amostras[posto < 0 ? 0 : posto];
+}
+
+// Distribuição das amostras de uma configuração
+typedef struct {
+    double minimo;
+    double mediana;
+    double p95;
+    double p99;
+    double maximo;
+    double desvio;    // desvio padrão amostral
+} Distribuicao;
+
+// Resume as amostras (ordena o vetor)
+void resumir(double *amostras, int n, Distribuicao *distribuicao) {
+    qsort(amostras, n, sizeof(double), comparar_double);
+    
+    distribuicao->minimo = amostras[0];
+    distribuicao->mediana = (n % 2 == 0) ? (amostras[n/2 - 1] + amostras[n/2]) / 2.0
+                                         : amostras[n/2];
+    distribuicao->p95 = percentil(amostras, n, 0.95);
+    distribuicao->p99 = percentil(amostras, n, 0.99);
+    distribuicao->maximo = amostras[n - 1];
+    
+    double soma = 0.0;
+    for (int i = 0; i < n; i++) soma += amostras[i];
+    double media = soma / n;
+    
+    double soma_quadrados = 0.0;
+    for (int i = 0; i < n; i++) {
+        double diferenca = amostras[i] - media;
+        soma_quadrados += diferenca * diferenca;
+    }
+    distribuicao->desvio = n > 1 ? sqrt(soma_quadrados / (n - 1)) : 0.0;
+}
+
+// Medianas dos contadores de uma configuração: os totais por execução vão
+// para o fim da linha do CSV principal e cada fase vira uma linha de 'fases'
+void gravar_contadores(FILE *csv, FILE *fases, const char *metodo, long long n,
+                       int trabalhadores, const Medicao *medicoes, int repeticoes,
+                       double *amostras) {
+    // Totais: soma das fases de cada execução (a coluna 0, tempo, já está no CSV)
+    for (int c = 1; c < COLUNAS_FASE; c++) {
+        for (int r = 0; r < repeticoes; r++) {
+            amostras[r] = NAN;
+            for (int f = 0; f < medicoes[r].n_fases; f++) {
+                double valor = medicoes[r].fases[f].colunas[c];
+                if (isnan(valor)) continue;
+                amostras[r] = isnan(amostras[r]) ? valor : amostras[r] + valor;
+            }
+        }
+        gravar_celula(csv, mediana_disponivel(amostras, repeticoes), 0);
+    }
+    
+    // Fases na ordem da primeira execução, casadas pelo nome nas demais
+    for (int f = 0; f < medicoes[0].n_fases; f++) {
+        const char *nome = medicoes[0].fases[f].nome;
+        fprintf(fases, "%s,%lld,%d,%s", metodo, n, trabalhadores, nome);
+        for (int c = 0; c < COLUNAS_FASE; c++) {
+            for (int r = 0; r < repeticoes; r++) {
+                amostras[r] = NAN;
+                for (int g = 0; g < medicoes[r].n_fases; g++) {
+                    if (strcmp(medicoes[r].fases[g].nome, nome) == 0) {
+                        amostras[r] = medicoes[r].fases[g].colunas[c];
+                        break;
+                    }
+                }
+            }
+            gravar_celula(fases, mediana_disponivel(amostras, repeticoes), c == 0 ? 6 : 0);
+        }
+        fprintf(fases, "\n");
+    }
+    fflush(fases);
+}
+
+int main(int argc, char *argv[]) {
+    const char *diretorio = ".";
+    const char *arquivo_saida = "resultados_benchmark.csv";
+    const char *arquivo_dados = NULL;
+    const char *semente = NULL;
+    const char *arquivo_fases = NULL;
+    const char *modo_latencia = NULL;
+    long long tamanhos[MAX_LISTA] = { 1000, 10000, 100000, 1000000, 10000000 };
+    int n_tamanhos = 5;
+    long long lista_threads[MAX_LISTA];
+    int n_lista_threads = 0;
+    int aquecimento = 2;
+    int repeticoes = 10;
+    
+    // Lê as opções da linha de comando
+    int opcao;
+    while ((opcao = getopt(argc, argv, "d:n:t:w:r:o:f:S:c:l:")) != -1) {
+        switch (opcao) {
+            case 'd':
+                diretorio = optarg;
+                break;
+            case 'n':
+                n_tamanhos = ler_lista(optarg, tamanhos, MAX_LISTA);
+                break;
+            case 't':
+                n_lista_threads = ler_lista(optarg, lista_threads, MAX_LISTA);
+                break;
+            case 'w':
+                aquecimento = atoi(optarg);
+                break;
+            case 'r':
+                repeticoes = atoi(optarg);
+                break;
+            case 'o':
+                arquivo_saida = optarg;
+                break;
+            case 'f':
+                arquivo_dados = optarg;
+                break;
+            case 'S':
+                semente = optarg;
+                break;
+            case 'c':
+                arquivo_fases = optarg;
+                break;
+            case 'l':
+                modo_latencia = optarg;
+                break;
+            default:
+                fprintf(stderr, "Uso: %s [-d dir] [-n N1,N2,...] [-t T1,T2,...] "
+                        "[-w aquecimento] [-r repetições] [-o saida.csv] [-f arquivo.bin] [-S semente] "
+                        "[-c fases.csv] [-l 1|fifo]\n", argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+    
+    if (n_tamanhos <= 0 || n_lista_threads < 0 || repeticoes < 1 || aquecimento < 0) {
+        fprintf(stderr, "Opções inválidas\n");
+        return EXIT_FAILURE;
+    }
+    
+    // Arquivo de dados: um único N, o gravado no cabeçalho
+    if (arquivo_dados != NULL) {
+        CabecalhoDados cabecalho;
+        if (dados_ler_cabecalho(arquivo_dados, &cabecalho) != 0) {
+            return EXIT_FAILURE;
+        }
+        tamanhos[0] = (long long)cabecalho.quantidade;
+        n_tamanhos = 1;
+    }
+    
+    // Padrão de threads: 1, 2, 4, ... até o número de núcleos
+    if (n_lista_threads == 0) {
+        long nucleos = sysconf(_SC_NPROCESSORS_ONLN);
+        if (nucleos < 1) nucleos = 1;
+        for (long t = 1; t < nucleos && n_lista_threads < MAX_LISTA - 1; t *= 2) {
+            lista_threads[n_lista_threads++] = t;
+        }
+        lista_threads[n_lista_threads++] = nucleos;
+    }
+    
+    FILE *csv = fopen(arquivo_saida, "w");
+    if (csv == NULL) {
+        perror("Erro ao abrir o arquivo de saída");
+        return EXIT_FAILURE;
+    }
+    fprintf(csv, "Metodo,N,Trabalhadores,Repeticoes,Min_ms,Mediana_ms,P95_ms,P99_ms,Max_ms,"
+                 "Desvio_ms,Criacao_Mediana_ms,Series_por_s,Valores_por_s");
+    
+    // Modo de latência: herdado pelas versões via ambiente
+    if (modo_latencia != NULL) {
+        setenv("ESTATISTICAS_LATENCIA", modo_latencia, 1);
+    }
+    
+    // Contadores: herdados pelas versões via ambiente, uma linha por fase em -c
+    FILE *fases = NULL;
+    if (arquivo_fases != NULL) {
+        fases = fopen(arquivo_fases, "w");
+        if (fases == NULL) {
+            perror("Erro ao abrir o arquivo de fases");
+            fclose(csv);
+            return EXIT_FAILURE;
+        }
+        setenv("ESTATISTICAS_CONTADORES", "1", 1);
+    
+        fprintf(fases, "Metodo,N,Trabalhadores,Fase");
+        for (int c = 0; c < COLUNAS_FASE; c++) {
+            fprintf(fases, ",%s_Mediana", NOMES_COLUNAS[c]);
+            if (c > 0) fprintf(csv, ",%s_Mediana", NOMES_COLUNAS[c]);
+        }
+        fprintf(fases, "\n");
+    }
+    fprintf(csv, "\n");
+    
+    double *totais = (double*)malloc(repeticoes * sizeof(double));
+    double *criacoes = (double*)malloc(repeticoes * sizeof(double));
+    Medicao *medicoes = (Medicao*)malloc(repeticoes * sizeof(Medicao));
+    if (totais == NULL || criacoes == NULL || medicoes == NULL) {
+        fprintf(stderr, "Erro ao alocar memória para as amostras\n");
+        fclose(csv);
+        if (fases != NULL) fclose(fases);
+        return EXIT_FAILURE;
+    }
+    
+    int falhas = 0;
+    for (int i = 0; i < n_tamanhos; i++) {
+        for (size_t v = 0; v < N_VARIANTES; v++) {
+            const Variante *variante = &VARIANTES[v];
+            int n_configuracoes = variante->trabalhadores == 0 ? n_lista_threads : 1;
+    
+            for (int c = 0; c < n_configuracoes; c++) {
+                int trabalhadores = variante->trabalhadores;
+                if (trabalhadores == 0) trabalhadores = (int)lista_threads[c];
+    
+                // Monta a linha de comando: programa (-n N | -f arquivo) [opções] [-S semente] [-t T]
+                char caminho[4096], texto_n[32], texto_t[32], opcoes[256];
+                char *argumentos[MAX_ARGUMENTOS];
+                int n_argumentos = 0;
+    
+                snprintf(caminho, sizeof(caminho), "%s/%s", diretorio, variante->programa);
+                snprintf(texto_n, sizeof(texto_n), "%lld", tamanhos[i]);
+                snprintf(texto_t, sizeof(texto_t), "%d", trabalhadores);
+    
+                argumentos[n_argumentos++] = caminho;
+                if (arquivo_dados != NULL) {
+                    argumentos[n_argumentos++] = "-f";
+                    argumentos[n_argumentos++] = (char*)arquivo_dados;
+                } else {
+                    argumentos[n_argumentos++] = "-n";
+                    argumentos[n_argumentos++] = texto_n;
+                }
+                if (variante->opcoes != NULL) {
+                    snprintf(opcoes, sizeof(opcoes), "%s", variante->opcoes);
+                    for (char *parte = strtok(opcoes, " "); parte != NULL; parte = strtok(NULL, " ")) {
+                        argumentos[n_argumentos++] = parte;
+                    }
+                }
+                if (semente != NULL) {
+                    argumentos[n_argumentos++] = "-S";
+                    argumentos[n_argumentos++] = (char*)semente;
+                }
+                if (variante->trabalhadores == 0) {
+                    argumentos[n_argumentos++] = "-t";
+                    argumentos[n_argumentos++] = texto_t;
+                }
+                argumentos[n_argumentos] = NULL;
+    
+                printf("%-36s N=%-11lld T=%-3d ", variante->metodo, tamanhos[i], trabalhadores);
+                fflush(stdout);
+    
+                // Aquecimento: cache de páginas, binário e alocador já carregados
+                Medicao medicao;
+                int ok = 1;
+                for (int w = 0; w < aquecimento && ok; w++) {
+                    ok = executar(argumentos, &medicao) == 0;
+                }
+    
+                int n_criacoes = 0;
+                for (int r = 0; r < repeticoes && ok; r++) {
+                    ok = executar(argumentos, &medicoes[r]) == 0;
+                    totais[r] = medicoes[r].total;
+                    if (!isnan(medicoes[r].criacao)) criacoes[n_criacoes++] = medicoes[r].criacao;
+                }
+    
+                if (!ok) {
+                    printf("falhou\n");
+                    falhas++;
+                    continue;
+                }
+    
+                Distribuicao tempo;
+                resumir(totais, repeticoes, &tempo);
+    
+                double criacao_mediana = NAN;
+                if (n_criacoes > 0) {
+                    Distribuicao criacao;
+                    resumir(criacoes, n_criacoes, &criacao);
+                    criacao_mediana = criacao.mediana;
+                }
+    
+                // Vazão pela mediana do tempo total; séries só no modo em lote
+                double valores_por_s = tamanhos[i] / (tempo.mediana / 1000.0);
+                double series_por_s = medicoes[0].series / (tempo.mediana / 1000.0);
+    
+                printf("mediana %.3f ms  p95 %.3f ms  p99 %.3f ms", tempo.mediana, tempo.p95, tempo.p99);
+                if (!isnan(series_por_s)) printf("  %.0f séries/s", series_por_s);
+                printf("\n");
+    
+                fprintf(csv, "%s,%lld,%d,%d,%.6f,%.6f,%.6f,%.6f,%.6f,%.6f,", variante->metodo,
+                        tamanhos[i], trabalhadores, repeticoes, tempo.minimo, tempo.mediana,
+                        tempo.p95, tempo.p99, tempo.maximo, tempo.desvio);
+                if (!isnan(criacao_mediana)) fprintf(csv, "%.6f", criacao_mediana);
+                gravar_celula(csv, series_por_s, 1);
+                gravar_celula(csv, valores_por_s, 1);
+                if (fases != NULL) {
+                    gravar_contadores(csv, fases, variante->metodo, tamanhos[i], trabalhadores,
+                                      medicoes, repeticoes, totais);
+                }
+                fprintf(csv, "\n");
+                fflush(csv);
+            }
+        }
+    }
+    
+    free(totais);
+    free(criacoes);
+    free(medicoes);
+    fclose(csv);
+    
+    printf("\nResultados gravados em %s\n", arquivo_saida);
+    if (fases != NULL) {
+        fclose(fases);
+        printf("Contadores por fase gravados em %s\n", arquivo_fases);
+    }
+    return falhas == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
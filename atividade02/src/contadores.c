@@ -0,0 +1,190 @@
+/*
+ * Instituição: Universidade Federal da Paraíba
+ * Disciplina: Sistemas Operacionais I
+ * Unidade 1 - Atividade 2
+ *
+ * Autor: Rodrigo Monteiro Fortes de Oliveira, 20240097664
+ *
+ * Nome do Módulo: contadores.c
+ *
+ * Descrição:
+ *     Implementação dos contadores por fase declarados em contadores.h.
+ *     Cada evento é um descritor independente (sem grupo), para que os
+ *     eventos de software continuem disponíveis quando os de hardware
+ *     não abrem; quando há mais eventos que registradores o núcleo os
+ *     reveza, e a contagem é corrigida pela fração do tempo em que o
+ *     evento esteve ativo. As fases também são repassadas ao rastro
+ *     (rastro.h), que as mostra na linha do tempo quando está ligado.
+ */
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#include "contadores.h"
+#include "rastro.h"
+#include "tempo.h"
+
+// Tipo e configuração de cada evento, na ordem de Contador
+static const struct {
+    uint32_t tipo;
+    uint64_t configuracao;
+} EVENTOS[N_CONTADORES] = {
+    { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+    { PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+    { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES },
+    { PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES },
+    { PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CONTEXT_SWITCHES },
+    { PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS },
+};
+
+// Contagem e tempo acumulados de uma fase
+typedef struct {
+    const char *nome;
+    double tempo_ms;
+    uint64_t valores[N_CONTADORES];
+} Fase;
+
+// Estado do módulo (um por processo)
+static int descritores[N_CONTADORES] = { -1, -1, -1, -1, -1, -1 };
+static int ativos = 0;
+static int n_fases = 0;
+static int fase_atual = -1;
+static Fase fases[CONTADORES_MAX_FASES];
+static uint64_t inicio_fase[N_CONTADORES];
+static struct timespec instante_fase;
+static const char *fase_rastro = NULL;   // fase aberta no rastro
+
+// Abre um evento herdado; tenta contar o núcleo e, se não for permitido
+// (perf_event_paranoid >= 2), conta só o modo usuário
+static int abrir_evento(uint32_t tipo, uint64_t configuracao) {
+    struct perf_event_attr atributos;
+    memset(&atributos, 0, sizeof(atributos));
+    atributos.size = sizeof(atributos);
+    atributos.type = tipo;
+    atributos.config = configuracao;
+    atributos.inherit = 1;
+    atributos.exclude_hv = 1;
+    atributos.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    
+    int fd = syscall(SYS_perf_event_open, &atributos, 0, -1, -1, PERF_FLAG_FD_CLOEXEC);
+    if (fd == -1 && (errno == EACCES || errno == EPERM)) {
+        atributos.exclude_kernel = 1;
+        fd = syscall(SYS_perf_event_open, &atributos, 0, -1, -1, PERF_FLAG_FD_CLOEXEC);
+    }
+    return fd;
+}
+
+// Lê a contagem atual de cada evento aberto, corrigida pelo revezamento
+static void ler_eventos(uint64_t valores[N_CONTADORES]) {
+    for (int e = 0; e < N_CONTADORES; e++) {
+        uint64_t leitura[3];   // valor, tempo habilitado, tempo em execução
+        valores[e] = 0;
+        if (descritores[e] == -1 ||
+            read(descritores[e], leitura, sizeof(leitura)) != sizeof(leitura)) {
+            continue;
+        }
+        if (leitura[2] > 0 && leitura[2] < leitura[1]) {
+            valores[e] = (uint64_t)((double)leitura[0] * leitura[1] / leitura[2]);
+        } else {
+            valores[e] = leitura[0];
+        }
+    }
+}
+
+void contadores_abrir(void) {
+    const char *ambiente = getenv("ESTATISTICAS_CONTADORES");
+    if (ambiente == NULL || *ambiente == '\0' || strcmp(ambiente, "0") == 0) {
+        return;
+    }
+    
+    int abertos = 0;
+    for (int e = 0; e < N_CONTADORES; e++) {
+        descritores[e] = abrir_evento(EVENTOS[e].tipo, EVENTOS[e].configuracao);
+        if (descritores[e] != -1) abertos++;
+    }
+    if (abertos == 0) {
+        perror("Aviso: contadores de desempenho indisponíveis");
+        return;
+    }
+    ativos = 1;
+}
+
+void contadores_entrar(const char *fase) {
+    contadores_sair();
+    rastro_comecar(fase);
+    fase_rastro = fase;
+    if (!ativos) return;
+    
+    // Procura a fase pelo nome; cria se ainda não existe
+    int indice = 0;
+    while (indice < n_fases && strcmp(fases[indice].nome, fase) != 0) {
+        indice++;
+    }
+    if (indice == n_fases) {
+        if (n_fases == CONTADORES_MAX_FASES) return;
+        memset(&fases[indice], 0, sizeof(Fase));
+        fases[indice].nome = fase;
+        n_fases++;
+    }
+    
+    fase_atual = indice;
+    marcar_instante(&instante_fase);
+    ler_eventos(inicio_fase);
+}
+
+void contadores_sair(void) {
+    if (fase_rastro != NULL) {
+        rastro_terminar(fase_rastro);
+        fase_rastro = NULL;
+    }
+    if (!ativos || fase_atual == -1) return;
+    
+    uint64_t fim[N_CONTADORES];
+    ler_eventos(fim);
+    struct timespec agora;
+    marcar_instante(&agora);
+    
+    Fase *fase = &fases[fase_atual];
+    fase->tempo_ms += diferenca_ms(instante_fase, agora);
+    for (int e = 0; e < N_CONTADORES; e++) {
+        fase->valores[e] += fim[e] - inicio_fase[e];
+    }
+    fase_atual = -1;
+}
+
+void contadores_exibir(void) {
+    if (!ativos) return;
+    contadores_sair();
+    
+    // Formato fixo: o benchmark lê uma fase por linha até a linha em branco
+    printf("\n--- CONTADORES DE DESEMPENHO ---\n");
+    printf("%-12s %10s %14s %14s %12s %12s %10s %10s\n", "Fase", "Tempo_ms", "Ciclos",
+           "Instrucoes", "Falhas_cache", "Desvios_err", "Trocas_ctx", "Faltas_pag");
+    for (int f = 0; f < n_fases; f++) {
+        printf("%-12s %10.3f", fases[f].nome, fases[f].tempo_ms);
+        for (int e = 0; e < N_CONTADORES; e++) {
+            int largura = e < CONTADOR_FALHAS_CACHE ? 14 : e < CONTADOR_TROCAS_CONTEXTO ? 12 : 10;
+            if (descritores[e] == -1) {
+                printf(" %*s", largura, "-");
+            } else {
+                printf(" %*llu", largura, (unsigned long long)fases[f].valores[e]);
+            }
+        }
+        printf("\n");
+    }
+}
+
+void contadores_fechar(void) {
+    for (int e = 0; e < N_CONTADORES; e++) {
+        if (descritores[e] != -1) close(descritores[e]);
+        descritores[e] = -1;
+    }
+    ativos = 0;
+    n_fases = 0;
+    fase_atual = -1;
+}
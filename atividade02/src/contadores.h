@@ -0,0 +1,61 @@
+/*
+ * Instituição: Universidade Federal da Paraíba
+ * Disciplina: Sistemas Operacionais I
+ * Unidade 1 - Atividade 2
+ *
+ * Autor: Rodrigo Monteiro Fortes de Oliveira, 20240097664
+ *
+ * Nome do Módulo: contadores.h
+ *
+ * Descrição:
+ *     Contadores de desempenho por fase (ciclos, instruções, falhas de
+ *     cache, desvios mal previstos, trocas de contexto e faltas de
+ *     página) lidos com perf_event_open. Os eventos são abertos com
+ *     herança: threads e processos filhos criados depois da abertura
+ *     também são contados, e a contagem de cada um é somada à do
+ *     programa quando ele termina. Por isso o trabalho de um filho
+ *     aparece na fase em que ele encerra (em geral a espera ou o
+ *     transporte do resultado), e não na fase em que foi criado.
+ *
+ *     A medição só é ligada com a variável de ambiente
+ *     ESTATISTICAS_CONTADORES=1 (o benchmark a define com -c); sem ela
+ *     as chamadas não fazem nada. Eventos que o sistema não oferece
+ *     (comum em máquinas virtuais, sem PMU) são exibidos como "-".
+ */
+
+#ifndef CONTADORES_H
+#define CONTADORES_H
+
+#include <stdint.h>
+
+// Fases distintas registradas por execução
+#define CONTADORES_MAX_FASES 16
+
+// Eventos medidos, na ordem das colunas
+typedef enum {
+    CONTADOR_CICLOS = 0,
+    CONTADOR_INSTRUCOES,
+    CONTADOR_FALHAS_CACHE,
+    CONTADOR_DESVIOS_ERRADOS,
+    CONTADOR_TROCAS_CONTEXTO,
+    CONTADOR_FALTAS_PAGINA,
+    N_CONTADORES
+} Contador;
+
+// Abre os eventos se ESTATISTICAS_CONTADORES estiver definida. Deve ser
+// chamada antes de criar threads ou processos que devam ser contados.
+void contadores_abrir(void);
+
+// Começa e termina uma fase; fases com o mesmo nome são acumuladas.
+// A fase também vai para o rastro (rastro.h), mesmo sem contadores.
+void contadores_entrar(const char *fase);
+void contadores_sair(void);
+
+// Exibe a tabela "--- CONTADORES DE DESEMPENHO ---", precedida de uma
+// linha em branco (nada se desligados)
+void contadores_exibir(void);
+
+// Fecha os eventos
+void contadores_fechar(void);
+
+#endif
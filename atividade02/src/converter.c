@@ -0,0 +1,245 @@
+/*
+ * Instituição: Universidade Federal da Paraíba
+ * Disciplina: Sistemas Operacionais I
+ * Unidade 1 - Atividade 2
+ *
+ * Autor: Rodrigo Monteiro Fortes de Oliveira, 20240097664
+ *
+ * Nome do Programa: converter.c
+ *
+ * Descrição:
+ *     Converte inteiros em texto (um ou mais por linha, separados por
+ *     espaço, vírgula ou ponto e vírgula) para o formato binário de
+ *     dados.h. O arquivo gerado pode ser passado com -f às demais
+ *     versões, que o mapeiam sem conversão; assim os benchmarks podem
+ *     ser repetidos sobre exatamente a mesma entrada. Com -g, em vez de
+ *     ler texto, grava N valores aleatórios do intervalo -v; com a mesma
+ *     semente (-S) eles são iguais aos gerados pelas demais versões.
+ *
+ *     Os valores são gravados no menor tipo que cabe no intervalo
+ *     (uint8, uint16 ou int32): com -g o tipo sai do intervalo -v; ao
+ *     ler texto, o corpo é gravado em int32 e compactado no fim, quando
+ *     o intervalo encontrado permitir. -w grava sempre em int32.
+ *
+ * Uso:
+ *     ./converter -o saida.bin [-w] [entrada.txt | -]
+ *     ./converter -o saida.bin -g N [-v min:max] [-S semente] [-w]
+ *
+ * Compilação:
+ *     gcc -O2 -pthread converter.c dados.c leitor.c estatisticas.c simd.c selecao.c esboco.c gerador.c afinidade.c -o converter -lm
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <errno.h>
+#include <limits.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include "dados.h"
+#include "leitor.h"
+#include "gerador.h"
+
+#define MIN_VALOR 0
+#define MAX_VALOR 100
+
+// Valores convertidos por lote antes de cada escrita
+#define TAMANHO_LOTE 65536
+
+// Escreve exatamente 'bytes' bytes, repetindo em escritas parciais
+static int escrever_completo(int fd, const void *buffer, size_t bytes) {
+    const char *origem = (const char*)buffer;
+    while (bytes > 0) {
+        ssize_t escritos = write(fd, origem, bytes);
+        if (escritos == -1) {
+            if (errno == EINTR) continue;
+            return -1;
+        }
+        origem += escritos;
+        bytes -= escritos;
+    }
+    return 0;
+}
+
+// Atualiza o menor e o maior valor vistos com um lote
+static void atualizar_intervalo(Dominio *intervalo, const int *lote, size_t tamanho) {
+    for (size_t i = 0; i < tamanho; i++) {
+        if (lote[i] < intervalo->min) intervalo->min = lote[i];
+        if (lote[i] > intervalo->max) intervalo->max = lote[i];
+    }
+}
+
+// Reescreve o lote no tipo 'tipo', no próprio buffer; retorna os bytes ocupados.
+// Cada valor estreito fica antes do inteiro de origem, então a ordem crescente é segura.
+static size_t estreitar_lote(int *lote, size_t tamanho, TipoElemento tipo) {
+    if (tipo == ELEMENTO_UINT8) {
+        uint8_t *destino = (uint8_t*)lote;
+        for (size_t i = 0; i < tamanho; i++) destino[i] = (uint8_t)lote[i];
+    } else if (tipo == ELEMENTO_UINT16) {
+        uint16_t *destino = (uint16_t*)lote;
+        for (size_t i = 0; i < tamanho; i++) destino[i] = (uint16_t)lote[i];
+    }
+    return tamanho * elemento_bytes(tipo);
+}
+
+// Converte o corpo já gravado em int32 para 'tipo', lote a lote, e encurta o
+// arquivo. A escrita nunca alcança a leitura: cada lote é lido antes de gravado.
+static int compactar_corpo(int fd, size_t total, TipoElemento tipo, int *lote) {
+    off_t origem = DADOS_DESLOCAMENTO;
+    off_t destino = DADOS_DESLOCAMENTO;
+    
+    for (size_t feitos = 0; feitos < total; ) {
+        size_t tamanho = total - feitos < TAMANHO_LOTE ? total - feitos : TAMANHO_LOTE;
+        if (pread(fd, lote, tamanho * sizeof(int), origem) != (ssize_t)(tamanho * sizeof(int))) {
+            perror("Erro ao reler o arquivo de saída");
+            return -1;
+        }
+        size_t bytes = estreitar_lote(lote, tamanho, tipo);
+        if (pwrite(fd, lote, bytes, destino) != (ssize_t)bytes) {
+            perror("Erro ao compactar o arquivo de saída");
+            return -1;
+        }
+        origem += tamanho * sizeof(int);
+        destino += bytes;
+        feitos += tamanho;
+    }
+    
+    if (ftruncate(fd, destino) == -1) {
+        perror("Erro ao encurtar o arquivo de saída");
+        return -1;
+    }
+    return 0;
+}
+
+int main(int argc, char *argv[]) {
+    const char *saida = NULL;
+    size_t n_gerados = 0;
+    Dominio dominio = { MIN_VALOR, MAX_VALOR };
+    uint64_t semente = gerador_semente_padrao();
+    int armazenamento_largo = 0;
+    
+    // Lê as opções da linha de comando
+    int opcao;
+    while ((opcao = getopt(argc, argv, "o:g:v:S:w")) != -1) {
+        switch (opcao) {
+            case 'o':
+                saida = optarg;
+                break;
+            case 'g':
+                n_gerados = strtoull(optarg, NULL, 10);
+                break;
+            case 'v':
+                if (dominio_ler(optarg, &dominio) != 0) {
+                    fprintf(stderr, "Intervalo inválido: %s (use min:max)\n", optarg);
+                    return EXIT_FAILURE;
+                }
+                break;
+            case 'S':
+                semente = strtoull(optarg, NULL, 10);
+                break;
+            case 'w':
+                armazenamento_largo = 1;
+                break;
+            default:
+                fprintf(stderr, "Uso: %s -o saida.bin [-g N [-v min:max] [-S semente]] [-w] [entrada | -]\n", argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+    if (saida == NULL) {
+        fprintf(stderr, "Uso: %s -o saida.bin [-g N [-v min:max] [-S semente]] [-w] [entrada | -]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+    
+    Leitor leitor;
+    if (n_gerados == 0 && leitor_abrir(&leitor, optind < argc ? argv[optind] : "-") != 0) {
+        return EXIT_FAILURE;
+    }
+    
+    int fd = open(saida, O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    int *lote = (int*)malloc(TAMANHO_LOTE * sizeof(int));
+    if (fd == -1 || lote == NULL) {
+        if (fd == -1) perror("Erro ao criar o arquivo de saída");
+        else fprintf(stderr, "Erro ao alocar memória para o lote\n");
+        if (n_gerados == 0) leitor_fechar(&leitor);
+        free(lote);
+        return EXIT_FAILURE;
+    }
+    
+    // Mesma sequência de gerador_preencher, produzida lote a lote
+    FluxoGerador fluxo;
+    fluxo_iniciar(&fluxo, semente);
+    
+    // Intervalo vazio até o primeiro valor
+    Dominio intervalo = { INT_MAX, INT_MIN };
+    
+    // Valores gerados já saem no tipo do intervalo; o texto, em int32
+    TipoElemento tipo = ELEMENTO_INT32;
+    if (n_gerados > 0 && !armazenamento_largo) {
+        tipo = dominio_tipo_elemento(dominio);
+    }
+    
+    size_t total = 0;
+    int status = EXIT_SUCCESS;
+    
+    // O corpo vem depois do cabeçalho, que só é gravado no fim
+    if (lseek(fd, DADOS_DESLOCAMENTO, SEEK_SET) == -1) {
+        perror("Erro ao posicionar o arquivo de saída");
+        status = EXIT_FAILURE;
+    }
+    
+    while (status == EXIT_SUCCESS) {
+        size_t lidos;
+        if (n_gerados > 0) {
+            lidos = n_gerados - total < TAMANHO_LOTE ? n_gerados - total : TAMANHO_LOTE;
+            fluxo_preencher(&fluxo, lote, lidos, dominio);
+        } else {
+            lidos = leitor_ler(&leitor, lote, TAMANHO_LOTE);
+        }
+        if (lidos == 0) {
+            break;
+        }
+    
+        atualizar_intervalo(&intervalo, lote, lidos);
+        size_t bytes = estreitar_lote(lote, lidos, tipo);
+        if (escrever_completo(fd, lote, bytes) != 0) {
+            perror("Erro ao escrever o arquivo de saída");
+            status = EXIT_FAILURE;
+            break;
+        }
+        total += lidos;
+    }
+    
+    if (n_gerados == 0) {
+        if (leitor.erro) status = EXIT_FAILURE;
+        leitor_fechar(&leitor);
+    
+        // Texto: compacta se o intervalo encontrado couber em um tipo menor
+        if (status == EXIT_SUCCESS && total > 0 && !armazenamento_largo) {
+            tipo = dominio_tipo_elemento(intervalo);
+            if (tipo != ELEMENTO_INT32 && compactar_corpo(fd, total, tipo, lote) != 0) {
+                status = EXIT_FAILURE;
+            }
+        }
+    }
+    free(lote);
+    
+    if (status == EXIT_SUCCESS && dados_gravar_cabecalho(fd, total, intervalo, tipo) != 0) {
+        status = EXIT_FAILURE;
+    }
+    if (close(fd) == -1) {
+        perror("Erro ao fechar o arquivo de saída");
+        status = EXIT_FAILURE;
+    }
+    
+    if (status != EXIT_SUCCESS) {
+        unlink(saida);
+        return status;
+    }
+    
+    printf("%zu valores gravados em %s (intervalo [%d, %d], %s)\n", total, saida,
+           total > 0 ? intervalo.min : 0, total > 0 ? intervalo.max : 0, elemento_nome(tipo));
+    if (n_gerados > 0) {
+        printf("Semente do gerador: %llu\n", (unsigned long long)semente);
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,176 @@
+/*
+ * Instituição: Universidade Federal da Paraíba
+ * Disciplina: Sistemas Operacionais I
+ * Unidade 1 - Atividade 2
+ *
+ * Autor: Rodrigo Monteiro Fortes de Oliveira, 20240097664
+ *
+ * Nome do Módulo: dados.c
+ *
+ * Descrição:
+ *     Leitura, mapeamento e gravação do cabeçalho dos arquivos de dados
+ *     declarados em dados.h. O mapeamento usa MAP_POPULATE, de modo que
+ *     as faltas de página acontecem no carregamento e não dentro do
+ *     intervalo medido pelos programas.
+ */
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "dados.h"
+
+_Static_assert(sizeof(CabecalhoDados) == 64, "cabeçalho deve ter 64 bytes");
+
+#if __BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__
+#error "o formato de dados assume uma máquina little-endian"
+#endif
+
+// Tipo de elemento correspondente ao código do cabeçalho
+static TipoElemento tipo_do_cabecalho(uint32_t tipo) {
+    switch (tipo) {
+        case DADOS_TIPO_UINT8: return ELEMENTO_UINT8;
+        case DADOS_TIPO_UINT16: return ELEMENTO_UINT16;
+        default: return ELEMENTO_INT32;
+    }
+}
+
+// Bytes por valor do código do cabeçalho (sem depender de estatisticas.c)
+static size_t bytes_do_cabecalho(uint32_t tipo) {
+    switch (tipo) {
+        case DADOS_TIPO_UINT8: return sizeof(uint8_t);
+        case DADOS_TIPO_UINT16: return sizeof(uint16_t);
+        default: return sizeof(int32_t);
+    }
+}
+
+// Confere identificação, versão, tipo e intervalo do cabeçalho
+static int cabecalho_valido(const CabecalhoDados *cabecalho, const char *caminho) {
+    if (memcmp(cabecalho->magica, DADOS_MAGICA, sizeof(DADOS_MAGICA)) != 0) {
+        fprintf(stderr, "%s: não é um arquivo de dados\n", caminho);
+        return 0;
+    }
+    if (cabecalho->versao != DADOS_VERSAO || cabecalho->tipo < DADOS_TIPO_INT32 ||
+        cabecalho->tipo > DADOS_TIPO_UINT16) {
+        fprintf(stderr, "%s: versão ou tipo de elemento não suportado\n", caminho);
+        return 0;
+    }
+    if (cabecalho->quantidade > 0 &&
+        (cabecalho->minimo > cabecalho->maximo ||
+         cabecalho->minimo < INT32_MIN || cabecalho->maximo > INT32_MAX)) {
+        fprintf(stderr, "%s: intervalo inválido no cabeçalho\n", caminho);
+        return 0;
+    }
+    if (cabecalho->quantidade > 0 && cabecalho->tipo != DADOS_TIPO_INT32 &&
+        (cabecalho->minimo < 0 ||
+         cabecalho->maximo > (cabecalho->tipo == DADOS_TIPO_UINT8 ? UINT8_MAX : UINT16_MAX))) {
+        fprintf(stderr, "%s: intervalo não cabe no tipo de elemento\n", caminho);
+        return 0;
+    }
+    return 1;
+}
+
+int dados_ler_cabecalho(const char *caminho, CabecalhoDados *cabecalho) {
+    int fd = open(caminho, O_RDONLY | O_CLOEXEC);
+    if (fd == -1) {
+        perror("Erro ao abrir o arquivo de dados");
+        return -1;
+    }
+    
+    ssize_t lidos;
+    do {
+        lidos = pread(fd, cabecalho, sizeof(*cabecalho), 0);
+    } while (lidos == -1 && errno == EINTR);
+    close(fd);
+    
+    if (lidos != (ssize_t)sizeof(*cabecalho)) {
+        fprintf(stderr, "%s: cabeçalho incompleto\n", caminho);
+        return -1;
+    }
+    return cabecalho_valido(cabecalho, caminho) ? 0 : -1;
+}
+
+int dados_mapear(Vetor *vetor, const char *caminho, Dominio *dominio) {
+    int fd = open(caminho, O_RDONLY | O_CLOEXEC);
+    if (fd == -1) {
+        perror("Erro ao abrir o arquivo de dados");
+        return -1;
+    }
+    
+    struct stat info;
+    if (fstat(fd, &info) == -1) {
+        perror("Erro ao consultar o arquivo de dados");
+        close(fd);
+        return -1;
+    }
+    if ((size_t)info.st_size < DADOS_DESLOCAMENTO) {
+        fprintf(stderr, "%s: cabeçalho incompleto\n", caminho);
+        close(fd);
+        return -1;
+    }
+    
+    // MAP_SHARED somente leitura: os filhos enxergam as mesmas páginas do cache
+    size_t bytes = (size_t)info.st_size;
+    void *endereco = mmap(NULL, bytes, PROT_READ, MAP_SHARED | MAP_POPULATE, fd, 0);
+    close(fd);
+    if (endereco == MAP_FAILED) {
+        perror("Erro ao mapear o arquivo de dados");
+        return -1;
+    }
+    
+    const CabecalhoDados *cabecalho = (const CabecalhoDados*)endereco;
+    if (!cabecalho_valido(cabecalho, caminho)) {
+        munmap(endereco, bytes);
+        return -1;
+    }
+    size_t largura = bytes_do_cabecalho(cabecalho->tipo);
+    if (cabecalho->quantidade != (bytes - DADOS_DESLOCAMENTO) / largura ||
+        (bytes - DADOS_DESLOCAMENTO) % largura != 0) {
+        fprintf(stderr, "%s: tamanho não confere com o cabeçalho\n", caminho);
+        munmap(endereco, bytes);
+        return -1;
+    }
+    
+    // Leitura sequencial: o núcleo pode ler adiante com mais agressividade
+    madvise(endereco, bytes, MADV_SEQUENTIAL);
+    
+    if (dominio != NULL) {
+        dominio->min = (int)cabecalho->minimo;
+        dominio->max = (int)cabecalho->maximo;
+    }
+    
+    vetor->valores = (char*)endereco + DADOS_DESLOCAMENTO;
+    vetor->tamanho = cabecalho->quantidade;
+    vetor->tipo = tipo_do_cabecalho(cabecalho->tipo);
+    vetor->bytes_mapeados = bytes;
+    vetor->deslocamento = DADOS_DESLOCAMENTO;
+    return 0;
+}
+
+int dados_gravar_cabecalho(int fd, size_t quantidade, Dominio intervalo, TipoElemento tipo) {
+    CabecalhoDados cabecalho;
+    memset(&cabecalho, 0, sizeof(cabecalho));
+    memcpy(cabecalho.magica, DADOS_MAGICA, sizeof(DADOS_MAGICA));
+    cabecalho.versao = DADOS_VERSAO;
+    cabecalho.tipo = tipo == ELEMENTO_UINT8 ? DADOS_TIPO_UINT8 :
+                     tipo == ELEMENTO_UINT16 ? DADOS_TIPO_UINT16 : DADOS_TIPO_INT32;
+    cabecalho.quantidade = quantidade;
+    cabecalho.minimo = quantidade > 0 ? intervalo.min : 0;
+    cabecalho.maximo = quantidade > 0 ? intervalo.max : 0;
+    
+    ssize_t escritos;
+    do {
+        escritos = pwrite(fd, &cabecalho, sizeof(cabecalho), 0);
+    } while (escritos == -1 && errno == EINTR);
+    
+    if (escritos != (ssize_t)sizeof(cabecalho)) {
+        perror("Erro ao gravar o cabeçalho");
+        return -1;
+    }
+    return 0;
+}
@@ -0,0 +1,62 @@
+/*
+ * Instituição: Universidade Federal da Paraíba
+ * Disciplina: Sistemas Operacionais I
+ * Unidade 1 - Atividade 2
+ *
+ * Autor: Rodrigo Monteiro Fortes de Oliveira, 20240097664
+ *
+ * Nome do Módulo: dados.h
+ *
+ * Descrição:
+ *     Formato binário de conjunto de dados: um cabeçalho de 64 bytes
+ *     (identificação, tipo do elemento, quantidade e intervalo dos
+ *     valores) seguido dos valores em little-endian, sem separadores.
+ *     Os valores podem ser int32 ou, quando o intervalo permite,
+ *     uint8/uint16 (o mesmo armazenamento compacto de vetor.h).
+ *     O arquivo é mapeado somente leitura com mmap e entregue direto
+ *     às funções de estatística, sem conversão de texto nem cópia; os
+ *     processos filhos herdam o mesmo mapeamento após fork().
+ */
+
+#ifndef DADOS_H
+#define DADOS_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "estatisticas.h"
+#include "vetor.h"
+
+// Identificação no início de todo arquivo de dados
+#define DADOS_MAGICA "SOESTAT"
+#define DADOS_VERSAO 1
+
+// Tipos de elemento do corpo do arquivo
+#define DADOS_TIPO_INT32 1
+#define DADOS_TIPO_UINT8 2
+#define DADOS_TIPO_UINT16 3
+
+// Cabeçalho gravado no início do arquivo (uma linha de cache)
+typedef struct {
+    char magica[8];        // DADOS_MAGICA, terminada em '\0'
+    uint32_t versao;
+    uint32_t tipo;         // DADOS_TIPO_*
+    uint64_t quantidade;   // número de valores no corpo
+    int64_t minimo;        // menor valor do arquivo
+    int64_t maximo;        // maior valor do arquivo
+    uint8_t reservado[24];
+} CabecalhoDados;
+
+// Os valores começam logo após o cabeçalho
+#define DADOS_DESLOCAMENTO sizeof(CabecalhoDados)
+
+// Lê e valida o cabeçalho do arquivo; retorna 0 em caso de sucesso
+int dados_ler_cabecalho(const char *caminho, CabecalhoDados *cabecalho);
+
+// Mapeia o arquivo somente leitura em 'vetor' (liberar com vetor_liberar).
+// Se 'dominio' não for NULL, recebe o intervalo gravado no cabeçalho.
+int dados_mapear(Vetor *vetor, const char *caminho, Dominio *dominio);
+
+// Grava o cabeçalho no início de 'fd' (após o corpo já ter sido escrito)
+int dados_gravar_cabecalho(int fd, size_t quantidade, Dominio intervalo, TipoElemento tipo);
+
+#endif
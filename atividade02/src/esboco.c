@@ -0,0 +1,423 @@
+/*
+ * Instituição: Universidade Federal da Paraíba
+ * Disciplina: Sistemas Operacionais I
+ * Unidade 1 - Atividade 2
+ *
+ * Autor: Rodrigo Monteiro Fortes de Oliveira, 20240097664
+ *
+ * Nome do Módulo: esboco.c
+ *
+ * Descrição:
+ *     Implementação do esboço KLL declarado em esboco.h. A capacidade
+ *     do nível h, com H níveis, é max(k·(2/3)^(H-h-1), 8): o nível mais
+ *     alto guarda k itens e os de baixo, cada vez menos. A compactação
+ *     é preguiçosa: só ocorre quando o total passa da soma das
+ *     capacidades, e só no primeiro nível cheio. Os níveis acima do 0
+ *     ficam sempre ordenados: promover e combinar são intercalações.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "esboco.h"
+
+// Razão entre as capacidades de níveis vizinhos
+#define ESBOCO_RAZAO (2.0 / 3.0)
+
+// Menor capacidade de um nível (os de baixo encolhem com a razão)
+#define ESBOCO_CAPACIDADE_MINIMA 8
+
+// Valores por lote ordenado de uma vez em esboco_adicionar (16 KiB)
+#define ESBOCO_LOTE 4096
+
+// Semente fixa: o mesmo fluxo de valores gera sempre o mesmo esboço
+#define ESBOCO_SEMENTE 0x6b6c6cULL
+
+// Cabeçalho da forma serializada, seguido dos itens nível a nível
+typedef struct {
+    uint32_t k;
+    uint32_t n_niveis;
+    uint64_t contagem;
+    uint32_t quantidade[ESBOCO_MAX_NIVEIS];
+} CabecalhoEsboco;
+
+// Item com peso, usado na consulta de quantis
+typedef struct {
+    int valor;
+    uint64_t peso;
+} ItemPesado;
+
+// Recalcula as capacidades após mudar o número de níveis
+static void atualizar_capacidades(Esboco *esboco) {
+    esboco->tamanho_maximo = 0;
+    for (int h = 0; h < esboco->n_niveis; h++) {
+        double capacidade = ceil(esboco->k * pow(ESBOCO_RAZAO, esboco->n_niveis - h - 1));
+        esboco->niveis[h].capacidade = capacidade > ESBOCO_CAPACIDADE_MINIMA ?
+                                       (uint32_t)capacidade : ESBOCO_CAPACIDADE_MINIMA;
+        esboco->tamanho_maximo += esboco->niveis[h].capacidade;
+    }
+}
+
+// Garante espaço para mais 'extra' itens no nível
+static void reservar_nivel(NivelEsboco *nivel, uint32_t extra) {
+    uint32_t necessario = nivel->quantidade + extra;
+    if (necessario <= nivel->capacidade_alocada) return;
+    
+    uint32_t nova = nivel->capacidade_alocada > 0 ? nivel->capacidade_alocada : 16;
+    while (nova < necessario) nova *= 2;
+    
+    int *itens = (int*)realloc(nivel->itens, nova * sizeof(int));
+    if (itens == NULL) {
+        fprintf(stderr, "Erro ao alocar memória para o esboço\n");
+        exit(EXIT_FAILURE);
+    }
+    nivel->itens = itens;
+    nivel->capacidade_alocada = nova;
+}
+
+// Abre mais um nível no topo (as capacidades dos de baixo diminuem)
+static void crescer(Esboco *esboco) {
+    esboco->n_niveis++;
+    atualizar_capacidades(esboco);
+}
+
+// Ordenação por inserção (o nível mais baixo tem poucas dezenas de itens)
+static void ordenar_insercao(int *itens, uint32_t quantidade) {
+    for (uint32_t i = 1; i < quantidade; i++) {
+        int item = itens[i];
+        uint32_t j = i;
+        while (j > 0 && itens[j - 1] > item) {
+            itens[j] = itens[j - 1];
+            j--;
+        }
+        itens[j] = item;
+    }
+}
+
+// Radix LSD de 8 bits; 'temporario' tem espaço para 'quantidade' itens.
+// São quatro passadas (número par): o resultado termina em 'itens'.
+static void ordenar_radix(int *itens, int *temporario, uint32_t quantidade) {
+    uint32_t *origem = (uint32_t*)itens;
+    uint32_t *destino = (uint32_t*)temporario;
+    
+    // O bit de sinal invertido torna a ordem sem sinal igual à com sinal
+    for (uint32_t i = 0; i < quantidade; i++) origem[i] ^= 0x80000000u;
+    
+    for (int deslocamento = 0; deslocamento < 32; deslocamento += 8) {
+        uint32_t contagem[256] = { 0 };
+        for (uint32_t i = 0; i < quantidade; i++) {
+            contagem[(origem[i] >> deslocamento) & 0xff]++;
+        }
+        uint32_t soma = 0;
+        for (int d = 0; d < 256; d++) {
+            uint32_t c = contagem[d];
+            contagem[d] = soma;
+            soma += c;
+        }
+        for (uint32_t i = 0; i < quantidade; i++) {
+            destino[contagem[(origem[i] >> deslocamento) & 0xff]++] = origem[i];
+        }
+        uint32_t *troca = origem;
+        origem = destino;
+        destino = troca;
+    }
+    
+    for (uint32_t i = 0; i < quantidade; i++) origem[i] ^= 0x80000000u;
+}
+
+// Garante a área de trabalho com espaço para 'quantidade' itens
+static int* reservar_auxiliar(Esboco *esboco, uint32_t quantidade) {
+    if (esboco->auxiliar_alocado < quantidade) {
+        free(esboco->auxiliar);
+        esboco->auxiliar = (int*)malloc(quantidade * sizeof(int));
+        if (esboco->auxiliar == NULL) {
+            fprintf(stderr, "Erro ao alocar memória para o esboço\n");
+            exit(EXIT_FAILURE);
+        }
+        esboco->auxiliar_alocado = quantidade;
+    }
+    return esboco->auxiliar;
+}
+
+// Intercala a sequência ordenada 'itens' (com passo 'passo') no nível h,
+// que já está ordenado; a intercalação vai de trás para frente, no
+// próprio vetor do nível
+static void intercalar(NivelEsboco *nivel, const int *itens, uint32_t quantidade,
+                       uint32_t passo) {
+    reservar_nivel(nivel, quantidade);
+    
+    int64_t i = (int64_t)nivel->quantidade - 1;
+    int64_t j = (int64_t)quantidade - 1;
+    int64_t destino = i + quantidade;
+    while (j >= 0) {
+        int item = itens[j * passo];
+        if (i >= 0 && nivel->itens[i] > item) {
+            nivel->itens[destino--] = nivel->itens[i--];
+        } else {
+            nivel->itens[destino--] = item;
+            j--;
+        }
+    }
+    nivel->quantidade += quantidade;
+}
+
+// Promove ao nível h + 1 metade dos 'quantidade' (par) itens ordenados:
+// os de posição par ou os de posição ímpar, por sorteio
+static void promover(Esboco *esboco, int h, const int *ordenados, uint32_t quantidade) {
+    if (h + 1 >= esboco->n_niveis) {
+        crescer(esboco);
+    }
+    
+    uint32_t paridade = (uint32_t)(gerador_proximo(&esboco->gerador) >> 63);
+    intercalar(&esboco->niveis[h + 1], ordenados + paridade, quantidade / 2, 2);
+    esboco->tamanho += quantidade / 2;
+}
+
+// Compacta o primeiro nível cheio. Os níveis acima do primeiro são
+// mantidos sempre ordenados, então só o nível 0 precisa de ordenação.
+static void compactar(Esboco *esboco) {
+    for (int h = 0; h < esboco->n_niveis; h++) {
+        NivelEsboco *nivel = &esboco->niveis[h];
+        if (nivel->quantidade < nivel->capacidade) continue;
+    
+        if (h == 0) {
+            if (nivel->quantidade <= 64) {
+                ordenar_insercao(nivel->itens, nivel->quantidade);
+            } else {
+                ordenar_radix(nivel->itens, reservar_auxiliar(esboco, nivel->quantidade),
+                              nivel->quantidade);
+            }
+        }
+    
+        // Com quantidade ímpar, o maior item fica no nível
+        uint32_t pares = nivel->quantidade & ~1u;
+        promover(esboco, h, nivel->itens, pares);
+    
+        uint32_t sobra = nivel->quantidade - pares;
+        if (sobra) {
+            nivel->itens[0] = nivel->itens[nivel->quantidade - 1];
+        }
+        nivel->quantidade = sobra;
+        esboco->tamanho -= pares;
+        return;
+    }
+}
+
+int esboco_iniciar(Esboco *esboco, int k) {
+    if (k < 8) {
+        fprintf(stderr, "Precisão do esboço inválida: %d\n", k);
+        return -1;
+    }
+    
+    memset(esboco, 0, sizeof(*esboco));
+    esboco->k = k;
+    esboco->n_niveis = 1;
+    gerador_iniciar(&esboco->gerador, ESBOCO_SEMENTE);
+    atualizar_capacidades(esboco);
+    return 0;
+}
+
+void esboco_adicionar(Esboco *esboco, const int *valores, size_t tamanho) {
+    // Lotes inteiros são ordenados fora do esboço e compactados direto
+    // para o nível 1, como se o nível 0 tivesse capacidade ESBOCO_LOTE:
+    // menos compactações (menos erro) e ordenação radix em vez de uma
+    // ordenação por inserção a cada poucos valores
+    while (tamanho >= ESBOCO_LOTE) {
+        int *lote = reservar_auxiliar(esboco, 2 * ESBOCO_LOTE);
+        memcpy(lote, valores, ESBOCO_LOTE * sizeof(int));
+        ordenar_radix(lote, lote + ESBOCO_LOTE, ESBOCO_LOTE);
+    
+        promover(esboco, 0, lote, ESBOCO_LOTE);
+        esboco->contagem += ESBOCO_LOTE;
+        valores += ESBOCO_LOTE;
+        tamanho -= ESBOCO_LOTE;
+    
+        while (esboco->tamanho >= esboco->tamanho_maximo) {
+            compactar(esboco);
+        }
+    }
+    
+    NivelEsboco *base = &esboco->niveis[0];
+    while (tamanho > 0) {
+        // Copia em bloco o que cabe antes da próxima compactação
+        size_t livres = esboco->tamanho_maximo - esboco->tamanho;
+        size_t parte = tamanho < livres ? tamanho : livres;
+    
+        reservar_nivel(base, (uint32_t)parte);
+        memcpy(base->itens + base->quantidade, valores, parte * sizeof(int));
+        base->quantidade += (uint32_t)parte;
+        esboco->tamanho += parte;
+        esboco->contagem += parte;
+        valores += parte;
+        tamanho -= parte;
+    
+        while (esboco->tamanho >= esboco->tamanho_maximo) {
+            compactar(esboco);
+        }
+    }
+}
+
+void esboco_adicionar_repetido(Esboco *esboco, int valor, uint64_t vezes) {
+    // Cada bit de 'vezes' vira um item no nível de mesmo peso: a
+    // contagem é representada sem erro antes das compactações
+    for (int h = 0; vezes > 0 && h < ESBOCO_MAX_NIVEIS - 1; h++, vezes >>= 1) {
+        if ((vezes & 1) == 0) continue;
+    
+        while (esboco->n_niveis <= h) {
+            crescer(esboco);
+        }
+        intercalar(&esboco->niveis[h], &valor, 1, 1);
+        esboco->tamanho++;
+        esboco->contagem += 1ULL << h;
+    }
+    
+    while (esboco->tamanho >= esboco->tamanho_maximo) {
+        compactar(esboco);
+    }
+}
+
+void esboco_combinar(Esboco *destino, const Esboco *origem) {
+    while (destino->n_niveis < origem->n_niveis) {
+        crescer(destino);
+    }
+    
+    for (int h = 0; h < origem->n_niveis; h++) {
+        const NivelEsboco *nivel = &origem->niveis[h];
+        intercalar(&destino->niveis[h], nivel->itens, nivel->quantidade, 1);
+        destino->tamanho += nivel->quantidade;
+    }
+    destino->contagem += origem->contagem;
+    
+    while (destino->tamanho >= destino->tamanho_maximo) {
+        compactar(destino);
+    }
+}
+
+static int comparar_item(const void *a, const void *b) {
+    int valor_a = ((const ItemPesado*)a)->valor;
+    int valor_b = ((const ItemPesado*)b)->valor;
+    
+    if (valor_a < valor_b) return -1;
+    if (valor_a > valor_b) return 1;
+    return 0;
+}
+
+int esboco_quantil(const Esboco *esboco, double q) {
+    ItemPesado *itens = (ItemPesado*)malloc((esboco->tamanho > 0 ? esboco->tamanho : 1) *
+                                            sizeof(ItemPesado));
+    if (itens == NULL) {
+        fprintf(stderr, "Erro ao alocar memória para o esboço\n");
+        exit(EXIT_FAILURE);
+    }
+    
+    // Todos os itens, cada um com o peso do seu nível
+    size_t n = 0;
+    uint64_t peso_total = 0;
+    for (int h = 0; h < esboco->n_niveis; h++) {
+        for (uint32_t i = 0; i < esboco->niveis[h].quantidade; i++) {
+            itens[n].valor = esboco->niveis[h].itens[i];
+            itens[n].peso = 1ULL << h;
+            peso_total += itens[n].peso;
+            n++;
+        }
+    }
+    if (n == 0) {
+        free(itens);
+        return 0;
+    }
+    
+    qsort(itens, n, sizeof(ItemPesado), comparar_item);
+    
+    // Primeiro item cujo peso acumulado alcança o posto pedido
+    double alvo = ceil(q * peso_total);
+    if (alvo < 1.0) alvo = 1.0;
+    uint64_t acumulado = 0;
+    int resultado = itens[n - 1].valor;
+    for (size_t i = 0; i < n; i++) {
+        acumulado += itens[i].peso;
+        if ((double)acumulado >= alvo) {
+            resultado = itens[i].valor;
+            break;
+        }
+    }
+    
+    free(itens);
+    return resultado;
+}
+
+void esboco_liberar(Esboco *esboco) {
+    for (int h = 0; h < ESBOCO_MAX_NIVEIS; h++) {
+        free(esboco->niveis[h].itens);
+        esboco->niveis[h].itens = NULL;
+        esboco->niveis[h].quantidade = 0;
+        esboco->niveis[h].capacidade_alocada = 0;
+    }
+    free(esboco->auxiliar);
+    esboco->auxiliar = NULL;
+    esboco->auxiliar_alocado = 0;
+    esboco->tamanho = 0;
+    esboco->contagem = 0;
+}
+
+size_t esboco_bytes_maximos(int k) {
+    // Após cada compactação o total fica abaixo da soma das capacidades:
+    // k/(1 - 2/3), mais o arredondamento e a capacidade mínima por nível
+    size_t itens = 3 * (size_t)k + (ESBOCO_CAPACIDADE_MINIMA + 1) * ESBOCO_MAX_NIVEIS;
+    return sizeof(CabecalhoEsboco) + itens * sizeof(int);
+}
+
+int esboco_serializar(const Esboco *esboco, void *destino, size_t bytes) {
+    size_t necessarios = sizeof(CabecalhoEsboco) + esboco->tamanho * sizeof(int);
+    if (necessarios > bytes) {
+        fprintf(stderr, "Esboço maior que a área de destino\n");
+        return -1;
+    }
+    
+    CabecalhoEsboco cabecalho;
+    memset(&cabecalho, 0, sizeof(cabecalho));
+    cabecalho.k = (uint32_t)esboco->k;
+    cabecalho.n_niveis = (uint32_t)esboco->n_niveis;
+    cabecalho.contagem = esboco->contagem;
+    
+    char *saida = (char*)destino + sizeof(cabecalho);
+    for (int h = 0; h < esboco->n_niveis; h++) {
+        cabecalho.quantidade[h] = esboco->niveis[h].quantidade;
+        if (esboco->niveis[h].quantidade == 0) continue;
+        memcpy(saida, esboco->niveis[h].itens, esboco->niveis[h].quantidade * sizeof(int));
+        saida += esboco->niveis[h].quantidade * sizeof(int);
+    }
+    memcpy(destino, &cabecalho, sizeof(cabecalho));
+    return 0;
+}
+
+int esboco_desserializar(Esboco *esboco, const void *origem, size_t bytes) {
+    CabecalhoEsboco cabecalho;
+    if (bytes < sizeof(cabecalho)) return -1;
+    memcpy(&cabecalho, origem, sizeof(cabecalho));
+    if (cabecalho.n_niveis < 1 || cabecalho.n_niveis > ESBOCO_MAX_NIVEIS) return -1;
+    
+    if (esboco_iniciar(esboco, (int)cabecalho.k) != 0) return -1;
+    while ((uint32_t)esboco->n_niveis < cabecalho.n_niveis) {
+        crescer(esboco);
+    }
+    
+    const char *entrada = (const char*)origem + sizeof(cabecalho);
+    size_t restantes = bytes - sizeof(cabecalho);
+    for (uint32_t h = 0; h < cabecalho.n_niveis; h++) {
+        size_t tamanho = cabecalho.quantidade[h] * sizeof(int);
+        if (tamanho > restantes) {
+            esboco_liberar(esboco);
+            return -1;
+        }
+        if (tamanho == 0) continue;
+        reservar_nivel(&esboco->niveis[h], cabecalho.quantidade[h]);
+        memcpy(esboco->niveis[h].itens, entrada, tamanho);
+        esboco->niveis[h].quantidade = cabecalho.quantidade[h];
+        esboco->tamanho += cabecalho.quantidade[h];
+        entrada += tamanho;
+        restantes -= tamanho;
+    }
+    esboco->contagem = cabecalho.contagem;
+    return 0;
+}
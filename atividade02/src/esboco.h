@@ -0,0 +1,83 @@
+/*
+ * Instituição: Universidade Federal da Paraíba
+ * Disciplina: Sistemas Operacionais I
+ * Unidade 1 - Atividade 2
+ *
+ * Autor: Rodrigo Monteiro Fortes de Oliveira, 20240097664
+ *
+ * Nome do Módulo: esboco.h
+ *
+ * Descrição:
+ *     Esboço KLL (Karnin, Lang e Liberty) para quantis aproximados com
+ *     memória O(k), independente da quantidade de valores. O esboço é
+ *     uma pilha de compactadores: o nível h guarda valores de peso 2^h
+ *     e, quando enche, é ordenado e metade dos seus valores (os de
+ *     posição par ou ímpar, por sorteio) sobe para o nível seguinte.
+ *     O erro de posto fica em torno de 1,7/k (k = 200: ~1%).
+ *
+ *     Dois esboços podem ser combinados (threads ou processos que
+ *     resumiram partes diferentes dos dados) e um esboço pode ser
+ *     serializado em uma área de tamanho fixo para passar entre
+ *     processos sem enviar os dados originais.
+ */
+
+#ifndef ESBOCO_H
+#define ESBOCO_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "gerador.h"
+
+// Parâmetro de precisão padrão
+#define ESBOCO_K_PADRAO 200
+
+// Níveis suficientes para 2^64 valores
+#define ESBOCO_MAX_NIVEIS 64
+
+typedef struct {
+    int *itens;
+    uint32_t quantidade;
+    uint32_t capacidade;          // itens que o nível aceita antes de compactar
+    uint32_t capacidade_alocada;
+} NivelEsboco;
+
+typedef struct Esboco {
+    int k;
+    int n_niveis;
+    size_t tamanho;        // itens guardados em todos os níveis
+    size_t tamanho_maximo; // soma das capacidades dos níveis
+    uint64_t contagem;     // valores representados (soma dos pesos)
+    Gerador gerador;       // sorteio da paridade nas compactações
+    int *auxiliar;         // área de trabalho da ordenação
+    uint32_t auxiliar_alocado;
+    NivelEsboco niveis[ESBOCO_MAX_NIVEIS];
+} Esboco;
+
+// Inicializa um esboço vazio com precisão k; retorna 0 em caso de sucesso
+int esboco_iniciar(Esboco *esboco, int k);
+
+// Acrescenta os valores ao esboço
+void esboco_adicionar(Esboco *esboco, const int *valores, size_t tamanho);
+
+// Acrescenta 'vezes' cópias de 'valor' (ex.: uma classe de histograma)
+void esboco_adicionar_repetido(Esboco *esboco, int valor, uint64_t vezes);
+
+// Acrescenta ao destino todos os valores representados pela origem
+void esboco_combinar(Esboco *destino, const Esboco *origem);
+
+// Valor aproximado do quantil q (0 <= q <= 1), pelo posto mais próximo
+int esboco_quantil(const Esboco *esboco, double q);
+
+// Libera a memória dos níveis
+void esboco_liberar(Esboco *esboco);
+
+// Bytes que a serialização de um esboço de precisão k pode ocupar
+size_t esboco_bytes_maximos(int k);
+
+// Grava o esboço em 'destino'; retorna 0 se coube em 'bytes'
+int esboco_serializar(const Esboco *esboco, void *destino, size_t bytes);
+
+// Reconstrói um esboço serializado; retorna 0 em caso de sucesso
+int esboco_desserializar(Esboco *esboco, const void *origem, size_t bytes);
+
+#endif
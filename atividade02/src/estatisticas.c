@@ -0,0 +1,621 @@
+/*
+ * Instituição: Universidade Federal da Paraíba
+ * Disciplina: Sistemas Operacionais I
+ * Unidade 1 - Atividade 2
+ *
+ * Autor: Rodrigo Monteiro Fortes de Oliveira, 20240097664
+ *
+ * Nome do Módulo: estatisticas.c
+ *
+ * Descrição:
+ *     Implementação das rotinas declaradas em estatisticas.h.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <stdint.h>
+#include <math.h>
+#include "estatisticas.h"
+#include "esboco.h"
+#include "simd.h"
+#include "selecao.h"
+
+// Valores por bloco na passada com histograma (16 KiB: cabe na L1)
+#define BLOCO_HISTOGRAMA 4096
+
+// Rotinas por tipo de elemento estreito: contagem no histograma sem
+// teste por valor (o bloco já foi conferido pelo mínimo e máximo),
+// contagem com teste e cópia para int (entrada do esboço)
+#define DEFINIR_ROTINAS_ELEMENTO(sufixo, tipo)                                  \
+static void contar_##sufixo(const tipo *valores, size_t tamanho, size_t *histograma, \
+                            int base) {                                         \
+    for (size_t i = 0; i < tamanho; i++) {                                      \
+        histograma[valores[i] - base]++;                                        \
+    }                                                                           \
+}                                                                               \
+                                                                                \
+static size_t contar_verificando_##sufixo(const tipo *valores, size_t tamanho,   \
+                                          size_t *histograma, int base,         \
+                                          size_t classes) {                     \
+    for (size_t i = 0; i < tamanho; i++) {                                      \
+        size_t indice = (size_t)((unsigned int)valores[i] - (unsigned int)base); \
+        if (indice >= classes) return i;                                        \
+        histograma[indice]++;                                                   \
+    }                                                                           \
+    return tamanho;                                                             \
+}                                                                               \
+                                                                                \
+static void copiar_##sufixo(const tipo *valores, size_t tamanho, int *destino) { \
+    for (size_t i = 0; i < tamanho; i++) {                                      \
+        destino[i] = valores[i];                                                \
+    }                                                                           \
+}
+
+DEFINIR_ROTINAS_ELEMENTO(u8, uint8_t)
+DEFINIR_ROTINAS_ELEMENTO(u16, uint16_t)
+
+int dominio_limitado(Dominio dominio) {
+    if (dominio.min > dominio.max) return 0;
+    return dominio_classes(dominio) <= HISTOGRAMA_MAX_CLASSES;
+}
+
+int dominio_ler(const char *texto, Dominio *dominio) {
+    int min, max;
+    if (sscanf(texto, "%d:%d", &min, &max) != 2 || min > max) {
+        return -1;
+    }
+    
+    dominio->min = min;
+    dominio->max = max;
+    return 0;
+}
+
+size_t dominio_classes(Dominio dominio) {
+    if (dominio.min > dominio.max) return 0;
+    return (size_t)((long long)dominio.max - dominio.min) + 1;
+}
+
+TipoElemento dominio_tipo_elemento(Dominio dominio) {
+    if (dominio.min > dominio.max || dominio.min < 0) return ELEMENTO_INT32;
+    if (dominio.max <= UINT8_MAX) return ELEMENTO_UINT8;
+    if (dominio.max <= UINT16_MAX) return ELEMENTO_UINT16;
+    return ELEMENTO_INT32;
+}
+
+size_t elemento_bytes(TipoElemento tipo) {
+    switch (tipo) {
+        case ELEMENTO_UINT8: return sizeof(uint8_t);
+        case ELEMENTO_UINT16: return sizeof(uint16_t);
+        default: return sizeof(int32_t);
+    }
+}
+
+const char* elemento_nome(TipoElemento tipo) {
+    switch (tipo) {
+        case ELEMENTO_UINT8: return "uint8";
+        case ELEMENTO_UINT16: return "uint16";
+        default: return "int32";
+    }
+}
+
+// Compara dois inteiros (usado pelo qsort)
+int comparar(const void *a, const void *b) {
+    int int_a = *((const int*)a);
+    int int_b = *((const int*)b);
+    
+    if (int_a < int_b) return -1;
+    if (int_a > int_b) return 1;
+    return 0;
+}
+
+// Conta as ocorrências de cada valor em uma única passada
+int histograma_contar(const int *valores, size_t tamanho, Dominio dominio,
+                      size_t *histograma) {
+    size_t classes = dominio_classes(dominio);
+    memset(histograma, 0, classes * sizeof(size_t));
+    
+    for (size_t i = 0; i < tamanho; i++) {
+        // A subtração sem sinal rejeita valores abaixo e acima do domínio
+        size_t indice = (size_t)((unsigned int)valores[i] - (unsigned int)dominio.min);
+        if (indice >= classes) {
+            return 0;
+        }
+        histograma[indice]++;
+    }
+    
+    return 1;
+}
+
+// Percorre as contagens acumuladas até alcançar a posição k
+int histograma_elemento(const size_t *histograma, Dominio dominio, size_t k) {
+    size_t classes = dominio_classes(dominio);
+    size_t acumulado = 0;
+    
+    for (size_t i = 0; i < classes; i++) {
+        acumulado += histograma[i];
+        if (acumulado > k) {
+            return dominio.min + (int)i;
+        }
+    }
+    
+    return dominio.max;
+}
+
+double histograma_mediana(const size_t *histograma, Dominio dominio, size_t tamanho) {
+    if (tamanho % 2 == 0) {
+        // Par: média dos dois do meio
+        int menor = histograma_elemento(histograma, dominio, tamanho/2 - 1);
+        int maior = histograma_elemento(histograma, dominio, tamanho/2);
+        return ((double)menor + maior) / 2.0;
+    }
+    
+    // Ímpar: elemento do meio
+    return histograma_elemento(histograma, dominio, tamanho/2);
+}
+
+// Copia o vetor e ordena (não altera o original)
+static int* copia_ordenada(const int *valores, size_t tamanho) {
+    int *copia = selecao_trabalho(tamanho);
+    memcpy(copia, valores, tamanho * sizeof(int));
+    qsort(copia, tamanho, sizeof(int), comparar);
+    return copia;
+}
+
+double mediana_ordenacao(const int *valores, size_t tamanho) {
+    int *copia = copia_ordenada(valores, tamanho);
+    
+    double mediana;
+    if (tamanho % 2 == 0) {
+        // Par: média dos dois do meio
+        mediana = ((double)copia[tamanho/2] + copia[tamanho/2 - 1]) / 2.0;
+    } else {
+        // Ímpar: elemento do meio
+        mediana = copia[tamanho/2];
+    }
+    
+    selecao_devolver(copia);
+    return mediana;
+}
+
+// Aloca o histograma do domínio; retorna NULL se o domínio não é limitado
+static size_t* histograma_alocar(Dominio dominio) {
+    if (!dominio_limitado(dominio)) return NULL;
+    
+    // Arredonda para linhas de cache inteiras: histogramas de threads
+    // diferentes nunca dividem uma linha
+    size_t bytes = dominio_classes(dominio) * sizeof(size_t);
+    bytes = (bytes + LINHA_CACHE - 1) / LINHA_CACHE * LINHA_CACHE;
+    size_t *histograma = (size_t*)aligned_alloc(LINHA_CACHE, bytes);
+    if (histograma == NULL) {
+        fprintf(stderr, "Erro ao alocar memória para o histograma\n");
+        exit(EXIT_FAILURE);
+    }
+    return histograma;
+}
+
+double mediana_dominio(const int *valores, size_t tamanho, Dominio dominio) {
+    size_t *histograma = histograma_alocar(dominio);
+    
+    if (histograma != NULL && histograma_contar(valores, tamanho, dominio, histograma)) {
+        double mediana = histograma_mediana(histograma, dominio, tamanho);
+        free(histograma);
+        return mediana;
+    }
+    
+    // Domínio ilimitado ou valor fora do domínio declarado: seleção
+    free(histograma);
+    return mediana_selecao(valores, tamanho);
+}
+
+int estatistica_ordem(const int *valores, size_t tamanho, Dominio dominio, size_t k) {
+    size_t *histograma = histograma_alocar(dominio);
+    
+    if (histograma != NULL && histograma_contar(valores, tamanho, dominio, histograma)) {
+        int elemento = histograma_elemento(histograma, dominio, k);
+        free(histograma);
+        return elemento;
+    }
+    
+    free(histograma);
+    return selecao_elemento(valores, tamanho, k);
+}
+
+void resumo_iniciar(Resumo *resumo, Dominio dominio) {
+    resumo->contagem = 0;
+    resumo->soma = 0;
+    resumo->soma_quadrados = 0;
+    resumo->minimo = INT_MAX;
+    resumo->maximo = INT_MIN;
+    resumo->dominio = dominio;
+    resumo->histograma = histograma_alocar(dominio);
+    resumo->precisao_esboco = 0;
+    resumo->esboco = NULL;
+    
+    if (resumo->histograma != NULL) {
+        memset(resumo->histograma, 0, dominio_classes(dominio) * sizeof(size_t));
+    }
+}
+
+// Cria o esboço vazio do resumo
+static void esboco_criar(Resumo *resumo) {
+    resumo->esboco = (Esboco*)malloc(sizeof(Esboco));
+    if (resumo->esboco == NULL) {
+        fprintf(stderr, "Erro ao alocar memória para o esboço\n");
+        exit(EXIT_FAILURE);
+    }
+    if (esboco_iniciar(resumo->esboco, resumo->precisao_esboco) != 0) {
+        exit(EXIT_FAILURE);
+    }
+}
+
+// Acrescenta as contagens de um histograma ao esboço (uma entrada por classe)
+static void esboco_histograma(Esboco *esboco, const size_t *histograma, Dominio dominio) {
+    size_t classes = dominio_classes(dominio);
+    for (size_t i = 0; i < classes; i++) {
+        if (histograma[i] > 0) {
+            esboco_adicionar_repetido(esboco, dominio.min + (int)i, histograma[i]);
+        }
+    }
+}
+
+// Descarta o histograma; com esboço ativo, as contagens passam para ele
+static void abandonar_histograma(Resumo *resumo) {
+    if (resumo->precisao_esboco > 0) {
+        esboco_criar(resumo);
+        esboco_histograma(resumo->esboco, resumo->histograma, resumo->dominio);
+    }
+    free(resumo->histograma);
+    resumo->histograma = NULL;
+}
+
+void resumo_ativar_esboco(Resumo *resumo, int k) {
+    resumo->precisao_esboco = k;
+    if (resumo->histograma == NULL && resumo->esboco == NULL) {
+        esboco_criar(resumo);
+    }
+}
+
+Esboco* resumo_converter_esboco(Resumo *resumo) {
+    if (resumo->histograma != NULL && resumo->precisao_esboco > 0) {
+        abandonar_histograma(resumo);
+    }
+    return resumo->esboco;
+}
+
+// Acumula apenas os momentos (caminho sem histograma)
+static void acumular_momentos(Resumo *resumo, const int *valores, size_t tamanho) {
+    if (resumo->esboco != NULL) {
+        esboco_adicionar(resumo->esboco, valores, tamanho);
+    }
+    
+    Momentos momentos = { 0, 0, resumo->minimo, resumo->maximo };
+    simd_nucleos()->momentos(valores, tamanho, &momentos);
+    
+    resumo->contagem += tamanho;
+    resumo->soma += momentos.soma;
+    resumo->soma_quadrados += momentos.soma_quadrados;
+    resumo->minimo = momentos.minimo;
+    resumo->maximo = momentos.maximo;
+}
+
+void resumo_acumular(Resumo *resumo, const int *valores, size_t tamanho) {
+    if (resumo->histograma == NULL) {
+        acumular_momentos(resumo, valores, tamanho);
+        return;
+    }
+    
+    const NucleosSimd *nucleos = simd_nucleos();
+    size_t classes = dominio_classes(resumo->dominio);
+    Momentos momentos = { 0, 0, resumo->minimo, resumo->maximo };
+    size_t i = 0;
+    
+    // Momentos e histograma na mesma passada pela memória: cada bloco
+    // é contado e, ainda na cache, somado
+    while (i < tamanho) {
+        size_t bloco = tamanho - i < BLOCO_HISTOGRAMA ? tamanho - i : BLOCO_HISTOGRAMA;
+        size_t contados = nucleos->histograma(valores + i, bloco, resumo->histograma,
+                                              resumo->dominio.min, classes);
+        nucleos->momentos(valores + i, contados, &momentos);
+        i += contados;
+        if (contados < bloco) break;
+    }
+    
+    resumo->contagem += i;
+    resumo->soma += momentos.soma;
+    resumo->soma_quadrados += momentos.soma_quadrados;
+    resumo->minimo = momentos.minimo;
+    resumo->maximo = momentos.maximo;
+    
+    if (i < tamanho) {
+        // Valor fora do domínio declarado: o histograma deixa de valer
+        abandonar_histograma(resumo);
+        acumular_momentos(resumo, valores + i, tamanho - i);
+    }
+}
+
+// Momentos de valores do tipo indicado com os núcleos escolhidos
+static void momentos_elementos(const void *valores, TipoElemento tipo, size_t tamanho,
+                               Momentos *momentos) {
+    const NucleosSimd *nucleos = simd_nucleos();
+    switch (tipo) {
+        case ELEMENTO_UINT8:
+            nucleos->momentos_u8((const uint8_t*)valores, tamanho, momentos);
+            break;
+        case ELEMENTO_UINT16:
+            nucleos->momentos_u16((const uint16_t*)valores, tamanho, momentos);
+            break;
+        default:
+            nucleos->momentos((const int*)valores, tamanho, momentos);
+            break;
+    }
+}
+
+// Conta valores estreitos, todos dentro do domínio [base, ...]
+static void contar_elementos(const void *valores, TipoElemento tipo, size_t tamanho,
+                             size_t *histograma, int base) {
+    if (tipo == ELEMENTO_UINT8) {
+        contar_u8((const uint8_t*)valores, tamanho, histograma, base);
+    } else {
+        contar_u16((const uint16_t*)valores, tamanho, histograma, base);
+    }
+}
+
+// Conta valores estreitos até o primeiro fora do domínio; retorna quantos contou
+static size_t contar_verificando_elementos(const void *valores, TipoElemento tipo,
+                                           size_t tamanho, size_t *histograma, int base,
+                                           size_t classes) {
+    if (tipo == ELEMENTO_UINT8) {
+        return contar_verificando_u8((const uint8_t*)valores, tamanho, histograma, base, classes);
+    }
+    return contar_verificando_u16((const uint16_t*)valores, tamanho, histograma, base, classes);
+}
+
+// Converte valores estreitos para int
+static void copiar_elementos(const void *valores, TipoElemento tipo, size_t tamanho,
+                             int *destino) {
+    if (tipo == ELEMENTO_UINT8) {
+        copiar_u8((const uint8_t*)valores, tamanho, destino);
+    } else {
+        copiar_u16((const uint16_t*)valores, tamanho, destino);
+    }
+}
+
+void resumo_acumular_elementos(Resumo *resumo, const void *valores, TipoElemento tipo,
+                               size_t tamanho) {
+    if (tipo == ELEMENTO_INT32) {
+        resumo_acumular(resumo, (const int*)valores, tamanho);
+        return;
+    }
+    
+    Momentos momentos = { 0, 0, resumo->minimo, resumo->maximo };
+    if (resumo->histograma == NULL && resumo->esboco == NULL) {
+        // Só os momentos: uma chamada sobre o vetor inteiro
+        momentos_elementos(valores, tipo, tamanho, &momentos);
+    } else {
+        size_t largura = elemento_bytes(tipo);
+        size_t classes = dominio_classes(resumo->dominio);
+        int lote[BLOCO_HISTOGRAMA];
+    
+        for (size_t i = 0; i < tamanho; i += BLOCO_HISTOGRAMA) {
+            size_t bloco = tamanho - i < BLOCO_HISTOGRAMA ? tamanho - i : BLOCO_HISTOGRAMA;
+            const char *trecho = (const char*)valores + i * largura;
+    
+            // Mínimo e máximo do bloco dizem se ele inteiro cabe no histograma
+            Momentos parcial = { 0, 0, INT_MAX, INT_MIN };
+            momentos_elementos(trecho, tipo, bloco, &parcial);
+    
+            size_t contados = 0;
+            if (resumo->histograma != NULL) {
+                if (parcial.minimo >= resumo->dominio.min && parcial.maximo <= resumo->dominio.max) {
+                    contar_elementos(trecho, tipo, bloco, resumo->histograma, resumo->dominio.min);
+                    contados = bloco;
+                } else {
+                    // Valor fora do domínio: conta até ele e abandona o histograma
+                    contados = contar_verificando_elementos(trecho, tipo, bloco, resumo->histograma,
+                                                            resumo->dominio.min, classes);
+                    abandonar_histograma(resumo);
+                }
+            }
+            if (resumo->esboco != NULL && contados < bloco) {
+                copiar_elementos(trecho + contados * largura, tipo, bloco - contados, lote);
+                esboco_adicionar(resumo->esboco, lote, bloco - contados);
+            }
+    
+            momentos.soma += parcial.soma;
+            momentos.soma_quadrados += parcial.soma_quadrados;
+            if (parcial.minimo < momentos.minimo) momentos.minimo = parcial.minimo;
+            if (parcial.maximo > momentos.maximo) momentos.maximo = parcial.maximo;
+        }
+    }
+    
+    resumo->contagem += tamanho;
+    resumo->soma += momentos.soma;
+    resumo->soma_quadrados += momentos.soma_quadrados;
+    resumo->minimo = momentos.minimo;
+    resumo->maximo = momentos.maximo;
+}
+
+void resumo_combinar(Resumo *destino, const Resumo *origem) {
+    destino->contagem += origem->contagem;
+    destino->soma += origem->soma;
+    destino->soma_quadrados += origem->soma_quadrados;
+    if (origem->minimo < destino->minimo) destino->minimo = origem->minimo;
+    if (origem->maximo > destino->maximo) destino->maximo = origem->maximo;
+    
+    if (destino->histograma != NULL && origem->histograma == NULL) {
+        abandonar_histograma(destino);
+    }
+    
+    if (destino->histograma == NULL) {
+        // Sem histograma, só o esboço (se houver) guarda a distribuição
+        if (destino->esboco == NULL) return;
+        if (origem->esboco != NULL) {
+            esboco_combinar(destino->esboco, origem->esboco);
+        } else if (origem->histograma != NULL) {
+            esboco_histograma(destino->esboco, origem->histograma, origem->dominio);
+        }
+        return;
+    }
+    
+    size_t classes = dominio_classes(destino->dominio);
+    for (size_t i = 0; i < classes; i++) {
+        destino->histograma[i] += origem->histograma[i];
+    }
+}
+
+void resumo_liberar(Resumo *resumo) {
+    free(resumo->histograma);
+    resumo->histograma = NULL;
+    
+    if (resumo->esboco != NULL) {
+        esboco_liberar(resumo->esboco);
+        free(resumo->esboco);
+        resumo->esboco = NULL;
+    }
+}
+
+double resumo_media(const Resumo *resumo) {
+    return (double)resumo->soma / resumo->contagem;
+}
+
+double resumo_variancia(const Resumo *resumo) {
+    // n·Σx² − (Σx)² em inteiro exato, dividido por n² no final
+    __int128 n = resumo->contagem;
+    __int128 numerador = n * resumo->soma_quadrados - (__int128)resumo->soma * resumo->soma;
+    return (double)numerador / ((double)resumo->contagem * resumo->contagem);
+}
+
+double resumo_desvio_padrao(const Resumo *resumo) {
+    return sqrt(resumo_variancia(resumo));
+}
+
+double resumo_mediana(const Resumo *resumo, const int *valores, size_t tamanho) {
+    if (resumo->histograma != NULL) {
+        return histograma_mediana(resumo->histograma, resumo->dominio, resumo->contagem);
+    }
+    return mediana_selecao(valores, tamanho);
+}
+
+int quantis_ler(const char *texto, Quantis *quantis) {
+    quantis->quantidade = 0;
+    quantis->aproximado = 0;
+    
+    const char *p = texto;
+    while (*p != '\0') {
+        char *fim;
+        double q = strtod(p, &fim);
+        if (fim == p || q < 0.0 || q > 1.0 || quantis->quantidade == QUANTIS_MAX) {
+            return -1;
+        }
+    
+        // Inserção ordenada: a seleção reaproveita a cópia em ordem crescente
+        int i = quantis->quantidade++;
+        while (i > 0 && quantis->q[i - 1] > q) {
+            quantis->q[i] = quantis->q[i - 1];
+            i--;
+        }
+        quantis->q[i] = q;
+    
+        if (*fim == ',') fim++;
+        else if (*fim != '\0') return -1;
+        p = fim;
+    }
+    
+    return quantis->quantidade > 0 ? 0 : -1;
+}
+
+// Histograma de todo o intervalo de um tipo estreito (sempre exato)
+static size_t* histograma_tipo(const void *valores, TipoElemento tipo, size_t tamanho,
+                               Dominio *dominio) {
+    dominio->min = 0;
+    dominio->max = tipo == ELEMENTO_UINT8 ? UINT8_MAX : UINT16_MAX;
+    
+    size_t *histograma = histograma_alocar(*dominio);
+    memset(histograma, 0, dominio_classes(*dominio) * sizeof(size_t));
+    contar_elementos(valores, tipo, tamanho, histograma, 0);
+    return histograma;
+}
+
+double resumo_mediana_elementos(const Resumo *resumo, const void *valores, TipoElemento tipo,
+                                size_t tamanho) {
+    if (resumo->histograma != NULL || tipo == ELEMENTO_INT32) {
+        return resumo_mediana(resumo, (const int*)valores, tamanho);
+    }
+    
+    Dominio dominio;
+    size_t *histograma = histograma_tipo(valores, tipo, tamanho, &dominio);
+    double mediana = histograma_mediana(histograma, dominio, tamanho);
+    free(histograma);
+    return mediana;
+}
+
+// Posição (a partir de 0) do quantil q pelo posto mais próximo
+static size_t posto_quantil(double q, size_t tamanho) {
+    double posto = ceil(q * tamanho);
+    if (posto < 1.0) return 0;
+    if (posto > tamanho) return tamanho - 1;
+    return (size_t)posto - 1;
+}
+
+int resumo_quantis(const Resumo *resumo, const int *valores, size_t tamanho,
+                   Quantis *quantis) {
+    quantis->aproximado = 0;
+    
+    if (resumo->histograma != NULL) {
+        for (int i = 0; i < quantis->quantidade; i++) {
+            size_t k = posto_quantil(quantis->q[i], resumo->contagem);
+            quantis->valor[i] = histograma_elemento(resumo->histograma, resumo->dominio, k);
+        }
+        return 0;
+    }
+    
+    if (valores != NULL && tamanho > 0) {
+        // Uma única cópia: cada seleção parte da arrumação deixada pela anterior
+        int *trabalho = selecao_trabalho(tamanho);
+        memcpy(trabalho, valores, tamanho * sizeof(int));
+    
+        for (int i = 0; i < quantis->quantidade; i++) {
+            size_t k = posto_quantil(quantis->q[i], tamanho);
+            quantis->valor[i] = selecao_int(trabalho, tamanho, k);
+        }
+        selecao_devolver(trabalho);
+        return 0;
+    }
+    
+    if (resumo->esboco != NULL) {
+        for (int i = 0; i < quantis->quantidade; i++) {
+            quantis->valor[i] = esboco_quantil(resumo->esboco, quantis->q[i]);
+        }
+        quantis->aproximado = 1;
+        return 0;
+    }
+    
+    return -1;
+}
+
+int resumo_quantis_elementos(const Resumo *resumo, const void *valores, TipoElemento tipo,
+                             size_t tamanho, Quantis *quantis) {
+    if (resumo->histograma != NULL || tipo == ELEMENTO_INT32 || valores == NULL) {
+        return resumo_quantis(resumo, tipo == ELEMENTO_INT32 ? (const int*)valores : NULL,
+                              tamanho, quantis);
+    }
+    
+    Dominio dominio;
+    size_t *histograma = histograma_tipo(valores, tipo, tamanho, &dominio);
+    for (int i = 0; i < quantis->quantidade; i++) {
+        size_t k = posto_quantil(quantis->q[i], tamanho);
+        quantis->valor[i] = histograma_elemento(histograma, dominio, k);
+    }
+    quantis->aproximado = 0;
+    free(histograma);
+    return 0;
+}
+
+void quantis_exibir(const Quantis *quantis) {
+    for (int i = 0; i < quantis->quantidade; i++) {
+        printf("Percentil %g: %d%s\n", quantis->q[i] * 100.0, quantis->valor[i],
+               quantis->aproximado ? " (aproximado)" : "");
+    }
+}
@@ -0,0 +1,180 @@
+/*
+ * Instituição: Universidade Federal da Paraíba
+ * Disciplina: Sistemas Operacionais I
+ * Unidade 1 - Atividade 2
+ *
+ * Autor: Rodrigo Monteiro Fortes de Oliveira, 20240097664
+ *
+ * Nome do Módulo: estatisticas.h
+ *
+ * Descrição:
+ *     Rotinas de estatística compartilhadas pelas quatro versões do
+ *     programa. O resumo (Resumo) obtém contagem, soma, soma dos
+ *     quadrados, mínimo, máximo e histograma em uma única passada
+ *     sobre os dados, de onde saem média, desvio padrão e mediana.
+ *     Quando os valores pertencem a um domínio limitado
+ *     (ex.: 0 a 100) a mediana é obtida por contagem em um histograma,
+ *     em uma única passada e sem copiar o vetor. Para domínios sem
+ *     limite conhecido usa-se a seleção (selecao.h) sobre uma cópia.
+ *
+ *     Quantis (p50, p90, p99, p999...) seguem o mesmo critério: exatos
+ *     pelo histograma ou por seleção quando os valores estão à mão.
+ *     Quando o resumo precisa ser combinado sem os dados (blocos de
+ *     threads, trabalhos de processos, leitura em fluxo), ele pode
+ *     carregar um esboço KLL (esboco.h), que dá quantis aproximados.
+ *
+ *     Os valores podem estar guardados em 8 ou 16 bits sem sinal quando
+ *     o domínio cabe nesses tipos (TipoElemento): as funções *_elementos
+ *     trabalham direto sobre essa representação compacta, com um quarto
+ *     ou metade dos bytes lidos da memória.
+ */
+
+#ifndef ESTATISTICAS_H
+#define ESTATISTICAS_H
+
+#include <stddef.h>
+
+// Tamanho da linha de cache (alinhamento de dados privados de cada thread)
+#define LINHA_CACHE 64
+
+// Maior quantidade de classes que o histograma aceita
+#define HISTOGRAMA_MAX_CLASSES (1 << 20)
+
+// Intervalo [min, max] em que os valores estão contidos
+typedef struct {
+    int min;
+    int max;
+} Dominio;
+
+// Esboço de quantis (definido em esboco.h)
+typedef struct Esboco Esboco;
+
+// Maior quantidade de quantis pedidos de uma vez (opção -q)
+#define QUANTIS_MAX 16
+
+// Tipo de armazenamento dos valores (o menor que cabe no domínio)
+typedef enum {
+    ELEMENTO_INT32 = 0,
+    ELEMENTO_UINT8,
+    ELEMENTO_UINT16
+} TipoElemento;
+
+// Domínio sem limites conhecidos (força o caminho por seleção)
+#define DOMINIO_ILIMITADO ((Dominio){ 1, 0 })
+
+// Resumo de um conjunto de valores obtido em uma única passada
+typedef struct {
+    size_t contagem;
+    long long soma;
+    __int128 soma_quadrados;   // exata: evita o cancelamento de soma/n - média²
+    int minimo;
+    int maximo;
+    Dominio dominio;
+    size_t *histograma;        // NULL se o domínio não é limitado
+    int precisao_esboco;       // k do esboço; 0 se não há quantis aproximados
+    Esboco *esboco;            // criado só quando não há histograma
+} Resumo;
+
+// Quantis pedidos e seus valores
+typedef struct {
+    int quantidade;
+    double q[QUANTIS_MAX];     // em ordem crescente, 0 <= q <= 1
+    int valor[QUANTIS_MAX];
+    int aproximado;            // 1 se vieram do esboço
+} Quantis;
+
+// Retorna 1 se o domínio é limitado e cabe no histograma
+int dominio_limitado(Dominio dominio);
+
+// Lê um domínio no formato "min:max"; retorna 0 em caso de sucesso
+int dominio_ler(const char *texto, Dominio *dominio);
+
+// Quantidade de valores distintos possíveis no domínio
+size_t dominio_classes(Dominio dominio);
+
+// Menor tipo de armazenamento capaz de guardar todo o domínio
+TipoElemento dominio_tipo_elemento(Dominio dominio);
+
+// Bytes ocupados por um valor do tipo
+size_t elemento_bytes(TipoElemento tipo);
+
+// Nome do tipo ("uint8", "uint16" ou "int32")
+const char* elemento_nome(TipoElemento tipo);
+
+// Compara dois inteiros (usado pelo qsort)
+int comparar(const void *a, const void *b);
+
+// Conta as ocorrências de cada valor; retorna 0 se algum valor sair do domínio
+int histograma_contar(const int *valores, size_t tamanho, Dominio dominio,
+                      size_t *histograma);
+
+// k-ésimo menor valor (k começa em 0) a partir do histograma
+int histograma_elemento(const size_t *histograma, Dominio dominio, size_t k);
+
+// Mediana a partir do histograma de um vetor com 'tamanho' valores
+double histograma_mediana(const size_t *histograma, Dominio dominio, size_t tamanho);
+
+// Mediana ordenando uma cópia do vetor (referência para conferir a seleção)
+double mediana_ordenacao(const int *valores, size_t tamanho);
+
+// Mediana: usa histograma se o domínio é limitado, senão seleção em uma cópia
+double mediana_dominio(const int *valores, size_t tamanho, Dominio dominio);
+
+// k-ésimo menor valor do vetor, pelo mesmo critério da mediana
+int estatistica_ordem(const int *valores, size_t tamanho, Dominio dominio, size_t k);
+
+// Prepara um resumo vazio (aloca o histograma se o domínio é limitado)
+void resumo_iniciar(Resumo *resumo, Dominio dominio);
+
+// Acrescenta valores ao resumo; pode ser chamada várias vezes (por blocos)
+void resumo_acumular(Resumo *resumo, const int *valores, size_t tamanho);
+
+// Idem para valores guardados no tipo indicado
+void resumo_acumular_elementos(Resumo *resumo, const void *valores, TipoElemento tipo,
+                               size_t tamanho);
+
+// Soma ao destino os valores resumidos em origem (mesmo domínio)
+void resumo_combinar(Resumo *destino, const Resumo *origem);
+
+// Passa a manter um esboço de precisão k enquanto não houver histograma
+void resumo_ativar_esboco(Resumo *resumo, int k);
+
+// Descarta o histograma, passando as contagens ao esboço (precisa de
+// resumo_ativar_esboco antes); retorna o esboço com toda a distribuição
+Esboco* resumo_converter_esboco(Resumo *resumo);
+
+// Libera o histograma do resumo
+void resumo_liberar(Resumo *resumo);
+
+double resumo_media(const Resumo *resumo);
+
+// Variância populacional
+double resumo_variancia(const Resumo *resumo);
+
+// Desvio padrão populacional
+double resumo_desvio_padrao(const Resumo *resumo);
+
+// Mediana pelo histograma; sem histograma faz a seleção em uma cópia de 'valores'
+double resumo_mediana(const Resumo *resumo, const int *valores, size_t tamanho);
+
+// Idem para valores guardados no tipo indicado; em 8 e 16 bits, sem
+// histograma do domínio, conta um histograma de todo o tipo (sem cópia)
+double resumo_mediana_elementos(const Resumo *resumo, const void *valores, TipoElemento tipo,
+                                size_t tamanho);
+
+// Lê uma lista de quantis ("0.5,0.9,0.99,0.999"); retorna 0 em caso de sucesso
+int quantis_ler(const char *texto, Quantis *quantis);
+
+// Quantis pelo posto mais próximo: histograma, seleção em uma cópia de
+// 'valores' (se não for NULL) ou esboço. Retorna -1 se nenhum está disponível.
+int resumo_quantis(const Resumo *resumo, const int *valores, size_t tamanho,
+                   Quantis *quantis);
+
+// Idem para valores guardados no tipo indicado
+int resumo_quantis_elementos(const Resumo *resumo, const void *valores, TipoElemento tipo,
+                             size_t tamanho, Quantis *quantis);
+
+// Exibe os quantis no formato "Percentil 99: ..."
+void quantis_exibir(const Quantis *quantis);
+
+#endif
@@ -0,0 +1,230 @@
+/*
+ * Instituição: Universidade Federal da Paraíba
+ * Disciplina: Sistemas Operacionais I
+ * Unidade 1 - Atividade 2
+ *
+ * Autor: Rodrigo Monteiro Fortes de Oliveira, 20240097664
+ *
+ * Nome do Módulo: gerador.c
+ *
+ * Descrição:
+ *     Implementação do gerador declarado em gerador.h. No preenchimento
+ *     paralelo a thread t gera os blocos [t * B / T, (t + 1) * B / T):
+ *     salta até o fluxo do primeiro e depois um fluxo por bloco.
+ */
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sched.h>
+#include "gerador.h"
+
+// Polinômio de salto de 2^128 passos do xoshiro256
+static const uint64_t SALTO[4] = {
+    0x180ec6d33cfd0abaULL, 0xd5a61266f0c9392cULL,
+    0xa9582618e03fc9aaULL, 0x39abdc4529b1661cULL
+};
+
+typedef struct {
+    void *valores;
+    TipoElemento tipo;
+    size_t tamanho;
+    Dominio dominio;
+    uint64_t semente;
+    int indice;
+    int n_threads;
+} TrechoGeracao;
+
+// Próximo valor de splitmix64 (espalha a semente pelos 256 bits de estado)
+static uint64_t splitmix64(uint64_t *x) {
+    uint64_t z = (*x += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+void gerador_iniciar(Gerador *gerador, uint64_t semente) {
+    for (int i = 0; i < 4; i++) {
+        gerador->s[i] = splitmix64(&semente);
+    }
+}
+
+void gerador_saltar(Gerador *gerador) {
+    uint64_t s[4] = { 0, 0, 0, 0 };
+    
+    for (int i = 0; i < 4; i++) {
+        for (int b = 0; b < 64; b++) {
+            if (SALTO[i] & (1ULL << b)) {
+                s[0] ^= gerador->s[0];
+                s[1] ^= gerador->s[1];
+                s[2] ^= gerador->s[2];
+                s[3] ^= gerador->s[3];
+            }
+            gerador_proximo(gerador);
+        }
+    }
+    
+    for (int i = 0; i < 4; i++) {
+        gerador->s[i] = s[i];
+    }
+}
+
+uint64_t gerador_semente_padrao(void) {
+    struct timespec agora;
+    clock_gettime(CLOCK_REALTIME, &agora);
+    uint64_t semente = ((uint64_t)agora.tv_sec << 32) ^ (uint64_t)agora.tv_nsec ^ (uint64_t)getpid();
+    return splitmix64(&semente);
+}
+
+// Gera 'tamanho' valores do domínio com um único fluxo, gravados no tipo indicado
+#define DEFINIR_GERACAO(nome, tipo)                                             \
+static void nome(Gerador *gerador, tipo *valores, size_t tamanho, Dominio dominio) { \
+    uint64_t amplitude = (uint64_t)((long long)dominio.max - dominio.min + 1);  \
+    for (size_t i = 0; i < tamanho; i++) {                                      \
+        valores[i] = (tipo)((long long)dominio.min +                            \
+                            (long long)gerador_limitado(gerador, amplitude));   \
+    }                                                                           \
+}
+
+DEFINIR_GERACAO(gerar_valores, int)
+DEFINIR_GERACAO(gerar_valores_u8, uint8_t)
+DEFINIR_GERACAO(gerar_valores_u16, uint16_t)
+
+// Gera no tipo indicado o trecho que começa no índice 'inicio'
+static void gerar_elementos(Gerador *gerador, void *valores, TipoElemento tipo, size_t inicio,
+                            size_t tamanho, Dominio dominio) {
+    switch (tipo) {
+        case ELEMENTO_UINT8:
+            gerar_valores_u8(gerador, (uint8_t*)valores + inicio, tamanho, dominio);
+            break;
+        case ELEMENTO_UINT16:
+            gerar_valores_u16(gerador, (uint16_t*)valores + inicio, tamanho, dominio);
+            break;
+        default:
+            gerar_valores(gerador, (int*)valores + inicio, tamanho, dominio);
+            break;
+    }
+}
+
+void fluxo_iniciar(FluxoGerador *fluxo, uint64_t semente) {
+    gerador_iniciar(&fluxo->atual, semente);
+    fluxo->proximo = fluxo->atual;
+    gerador_saltar(&fluxo->proximo);
+    fluxo->restantes = GERADOR_BLOCO;
+}
+
+void fluxo_preencher(FluxoGerador *fluxo, int *valores, size_t tamanho, Dominio dominio) {
+    while (tamanho > 0) {
+        if (fluxo->restantes == 0) {
+            // Fim do bloco: passa ao fluxo do bloco seguinte
+            fluxo->atual = fluxo->proximo;
+            gerador_saltar(&fluxo->proximo);
+            fluxo->restantes = GERADOR_BLOCO;
+        }
+    
+        size_t parte = tamanho < fluxo->restantes ? tamanho : fluxo->restantes;
+        gerar_valores(&fluxo->atual, valores, parte, dominio);
+        valores += parte;
+        tamanho -= parte;
+        fluxo->restantes -= parte;
+    }
+}
+
+// Função executada por cada thread do preenchimento paralelo
+static void* gerar_trecho(void *arg) {
+    TrechoGeracao *trecho = (TrechoGeracao*)arg;
+    size_t n_blocos = (trecho->tamanho + GERADOR_BLOCO - 1) / GERADOR_BLOCO;
+    size_t primeiro = n_blocos * trecho->indice / trecho->n_threads;
+    size_t ultimo = n_blocos * (trecho->indice + 1) / trecho->n_threads;
+    
+    // Fluxo do primeiro bloco desta thread: 'primeiro' saltos
+    Gerador gerador;
+    gerador_iniciar(&gerador, trecho->semente);
+    for (size_t i = 0; i < primeiro; i++) {
+        gerador_saltar(&gerador);
+    }
+    
+    for (size_t bloco = primeiro; bloco < ultimo; bloco++) {
+        size_t inicio = bloco * GERADOR_BLOCO;
+        size_t tamanho = trecho->tamanho - inicio < GERADOR_BLOCO ? trecho->tamanho - inicio : GERADOR_BLOCO;
+    
+        Gerador copia = gerador;
+        gerar_elementos(&copia, trecho->valores, trecho->tipo, inicio, tamanho, trecho->dominio);
+        gerador_saltar(&gerador);
+    }
+    
+    return NULL;
+}
+
+int gerador_preencher(void *valores, TipoElemento tipo, size_t tamanho, Dominio dominio,
+                      uint64_t semente, int n_threads, const Afinidade *afinidade) {
+    size_t n_blocos = (tamanho + GERADOR_BLOCO - 1) / GERADOR_BLOCO;
+    
+    if (n_threads <= 0) {
+        long nucleos = sysconf(_SC_NPROCESSORS_ONLN);
+        n_threads = nucleos > 0 ? (int)nucleos : 1;
+    }
+    if ((size_t)n_threads > n_blocos) {
+        n_threads = n_blocos > 0 ? (int)n_blocos : 1;
+    }
+    
+    pthread_t *threads = (pthread_t*)malloc(n_threads * sizeof(pthread_t));
+    TrechoGeracao *trechos = (TrechoGeracao*)malloc(n_threads * sizeof(TrechoGeracao));
+    if (threads == NULL || trechos == NULL) {
+        fprintf(stderr, "Erro ao alocar memória para a geração\n");
+        free(threads);
+        free(trechos);
+        return -1;
+    }
+    
+    // A thread principal gera o trecho 0; as demais são criadas para o resto
+    int criadas = 0;
+    for (int t = 0; t < n_threads; t++) {
+        trechos[t].valores = valores;
+        trechos[t].tipo = tipo;
+        trechos[t].tamanho = tamanho;
+        trechos[t].dominio = dominio;
+        trechos[t].semente = semente;
+        trechos[t].indice = t;
+        trechos[t].n_threads = n_threads;
+        if (t > 0) {
+            pthread_attr_t atributos;
+            pthread_attr_init(&atributos);
+            afinidade_atributos(afinidade, t, &atributos);
+            int ret = pthread_create(&threads[t], &atributos, gerar_trecho, &trechos[t]);
+            pthread_attr_destroy(&atributos);
+            if (ret != 0) {
+                fprintf(stderr, "Erro ao criar thread de geração: %d\n", ret);
+                break;
+            }
+            criadas++;
+        }
+    }
+    
+    int status = 0;
+    if (criadas == n_threads - 1) {
+        // O trecho 0 é tocado na CPU do trabalhador 0; depois a thread
+        // principal volta às CPUs que tinha
+        cpu_set_t anterior;
+        int fixada = afinidade_cpu(afinidade, 0) >= 0 &&
+                     sched_getaffinity(0, sizeof(anterior), &anterior) == 0 &&
+                     afinidade_fixar(afinidade, 0) == 0;
+        gerar_trecho(&trechos[0]);
+        if (fixada) {
+            sched_setaffinity(0, sizeof(anterior), &anterior);
+        }
+    } else {
+        status = -1;
+    }
+    
+    for (int t = 1; t <= criadas; t++) {
+        pthread_join(threads[t], NULL);
+    }
+    
+    free(threads);
+    free(trechos);
+    return status;
+}
@@ -0,0 +1,104 @@
+/*
+ * Instituição: Universidade Federal da Paraíba
+ * Disciplina: Sistemas Operacionais I
+ * Unidade 1 - Atividade 2
+ *
+ * Autor: Rodrigo Monteiro Fortes de Oliveira, 20240097664
+ *
+ * Nome do Módulo: gerador.h
+ *
+ * Descrição:
+ *     Geração de números pseudoaleatórios com xoshiro256**, no lugar de
+ *     rand(): o estado é explícito (seguro entre threads), a saída tem
+ *     64 bits e um salto de 2^128 passos separa fluxos independentes.
+ *     Valores em um intervalo são sorteados sem o viés de rand() % n.
+ *
+ *     O vetor é dividido em blocos de GERADOR_BLOCO valores e o bloco c
+ *     usa o fluxo da semente após c saltos. Assim o conteúdo depende só
+ *     da semente: é o mesmo com qualquer número de threads e também na
+ *     geração em lotes do converter.
+ */
+
+#ifndef GERADOR_H
+#define GERADOR_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "estatisticas.h"
+#include "afinidade.h"
+
+// Valores gerados por cada fluxo antes de passar ao seguinte
+#define GERADOR_BLOCO (1 << 16)
+
+typedef struct {
+    uint64_t s[4];
+} Gerador;
+
+// Fluxo sequencial que atravessa os blocos (geração em lotes)
+typedef struct {
+    Gerador atual;      // fluxo do bloco corrente
+    Gerador proximo;    // fluxo do bloco seguinte
+    size_t restantes;   // valores que ainda faltam no bloco corrente
+} FluxoGerador;
+
+static inline uint64_t gerador_rotacionar(uint64_t x, int k) {
+    return (x << k) | (x >> (64 - k));
+}
+
+// Próximo número de 64 bits (xoshiro256**)
+static inline uint64_t gerador_proximo(Gerador *gerador) {
+    uint64_t *s = gerador->s;
+    uint64_t resultado = gerador_rotacionar(s[1] * 5, 7) * 9;
+    uint64_t t = s[1] << 17;
+    
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = gerador_rotacionar(s[3], 45);
+    
+    return resultado;
+}
+
+// Número uniforme em [0, amplitude), sem viés (método de Lemire).
+// Rejeita apenas quando o produto cai na faixa que daria viés.
+static inline uint64_t gerador_limitado(Gerador *gerador, uint64_t amplitude) {
+    unsigned __int128 produto = (unsigned __int128)gerador_proximo(gerador) * amplitude;
+    uint64_t resto = (uint64_t)produto;
+    if (resto < amplitude) {
+        uint64_t limiar = -amplitude % amplitude;
+        while (resto < limiar) {
+            produto = (unsigned __int128)gerador_proximo(gerador) * amplitude;
+            resto = (uint64_t)produto;
+        }
+    }
+    return (uint64_t)(produto >> 64);
+}
+
+// Inicializa o estado a partir de uma semente (via splitmix64)
+void gerador_iniciar(Gerador *gerador, uint64_t semente);
+
+// Avança 2^128 passos: o resultado é um fluxo que não se sobrepõe ao anterior
+void gerador_saltar(Gerador *gerador);
+
+// Semente derivada do relógio, para quando o usuário não informa uma
+uint64_t gerador_semente_padrao(void);
+
+// Prepara um fluxo que começa no bloco 0 da semente
+void fluxo_iniciar(FluxoGerador *fluxo, uint64_t semente);
+
+// Gera os próximos 'tamanho' valores do fluxo, no intervalo do domínio
+void fluxo_preencher(FluxoGerador *fluxo, int *valores, size_t tamanho, Dominio dominio);
+
+// Preenche o vetor, de valores do tipo indicado, em paralelo
+// (n_threads <= 0: uma por núcleo). Os valores não dependem do tipo.
+// A thread t gera um trecho contíguo (a t-ésima fatia de blocos) fixada
+// na CPU do trabalhador t de 'afinidade': pela política de primeiro
+// toque do núcleo, as páginas do trecho ficam no nó NUMA de quem vai
+// processá-lo. Com afinidade NULL as threads não são fixadas.
+// Retorna 0 em caso de sucesso.
+int gerador_preencher(void *valores, TipoElemento tipo, size_t tamanho, Dominio dominio,
+                      uint64_t semente, int n_threads, const Afinidade *afinidade);
+
+#endif
@@ -0,0 +1,379 @@
+/*
+ * Instituição: Universidade Federal da Paraíba
+ * Disciplina: Sistemas Operacionais I
+ * Unidade 1 - Atividade 2
+ *
+ * Autor: Rodrigo Monteiro Fortes de Oliveira, 20240097664
+ *
+ * Nome do Módulo: janela.c
+ *
+ * Descrição:
+ *     Implementação da janela deslizante declarada em janela.h.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "janela.h"
+
+// Aloca o mapa vazio para 'classes' classes; retorna 0 em caso de sucesso
+static int mapa_criar(MapaClasses *mapa, size_t classes) {
+    for (int nivel = 0; nivel < JANELA_NIVEIS_MAPA; nivel++) {
+        classes = (classes + 63) / 64;
+        mapa->n_palavras[nivel] = classes;
+        mapa->palavras[nivel] = (uint64_t*)calloc(classes, sizeof(uint64_t));
+        if (mapa->palavras[nivel] == NULL) return -1;
+    }
+    return 0;
+}
+
+static void mapa_liberar(MapaClasses *mapa) {
+    for (int nivel = 0; nivel < JANELA_NIVEIS_MAPA; nivel++) {
+        free(mapa->palavras[nivel]);
+        mapa->palavras[nivel] = NULL;
+    }
+}
+
+// Marca a classe e, enquanto a palavra estava vazia, o bit dela acima
+static void mapa_marcar(MapaClasses *mapa, size_t classe) {
+    for (int nivel = 0; nivel < JANELA_NIVEIS_MAPA; nivel++) {
+        uint64_t *palavra = &mapa->palavras[nivel][classe / 64];
+        int ja_ocupada = *palavra != 0;
+        *palavra |= 1ull << (classe % 64);
+        if (ja_ocupada) break;
+        classe /= 64;
+    }
+}
+
+// Desmarca a classe e, se a palavra esvaziar, o bit dela acima
+static void mapa_desmarcar(MapaClasses *mapa, size_t classe) {
+    for (int nivel = 0; nivel < JANELA_NIVEIS_MAPA; nivel++) {
+        uint64_t *palavra = &mapa->palavras[nivel][classe / 64];
+        *palavra &= ~(1ull << (classe % 64));
+        if (*palavra != 0) break;
+        classe /= 64;
+    }
+}
+
+// Menor posição marcada maior que i no nível dado (-1 se não há)
+static long mapa_proxima(const MapaClasses *mapa, int nivel, size_t i) {
+    const uint64_t *palavras = mapa->palavras[nivel];
+    size_t p = i / 64;
+    int bit = i % 64;
+    
+    uint64_t acima = bit == 63 ? 0 : palavras[p] & (~0ull << (bit + 1));
+    if (acima != 0) return (long)(p * 64 + __builtin_ctzll(acima));
+    
+    // Palavra seguinte não vazia: pelo nível de cima, ou no último nível
+    // percorrendo as poucas palavras que ele tem
+    long q = -1;
+    if (nivel + 1 < JANELA_NIVEIS_MAPA) {
+        q = mapa_proxima(mapa, nivel + 1, p);
+    } else {
+        for (size_t j = p + 1; j < mapa->n_palavras[nivel] && q < 0; j++) {
+            if (palavras[j] != 0) q = (long)j;
+        }
+    }
+    if (q < 0) return -1;
+    return q * 64 + __builtin_ctzll(palavras[q]);
+}
+
+// Maior posição marcada menor que i no nível dado (-1 se não há)
+static long mapa_anterior(const MapaClasses *mapa, int nivel, size_t i) {
+    const uint64_t *palavras = mapa->palavras[nivel];
+    size_t p = i / 64;
+    int bit = i % 64;
+    
+    uint64_t abaixo = palavras[p] & ((1ull << bit) - 1);
+    if (abaixo != 0) return (long)(p * 64 + 63 - __builtin_clzll(abaixo));
+    
+    long q = -1;
+    if (nivel + 1 < JANELA_NIVEIS_MAPA) {
+        q = mapa_anterior(mapa, nivel + 1, p);
+    } else {
+        for (size_t j = p; j-- > 0 && q < 0;) {
+            if (palavras[j] != 0) q = (long)j;
+        }
+    }
+    if (q < 0) return -1;
+    return q * 64 + 63 - __builtin_clzll(palavras[q]);
+}
+
+// Move o cursor até a classe do k-ésimo menor valor da janela, saltando
+// as classes vazias pelo mapa (a classe procurada sempre existe: k < n)
+static void cursor_ajustar(CursorJanela *cursor, const Janela *janela, size_t k) {
+    const size_t *histograma = janela->histograma;
+    while (cursor->abaixo > k) {
+        cursor->classe = (size_t)mapa_anterior(&janela->ocupadas, 0, cursor->classe);
+        cursor->abaixo -= histograma[cursor->classe];
+    }
+    while (cursor->abaixo + histograma[cursor->classe] <= k) {
+        cursor->abaixo += histograma[cursor->classe];
+        cursor->classe = (size_t)mapa_proxima(&janela->ocupadas, 0, cursor->classe);
+    }
+}
+
+// Conta (delta = +1) ou descarta (delta = -1) um valor no histograma
+static void histograma_atualizar(Janela *janela, int valor, int delta) {
+    size_t classe = (size_t)(valor - janela->dominio.min);
+    janela->histograma[classe] += delta;
+    if (janela->histograma[classe] == 0) {
+        mapa_desmarcar(&janela->ocupadas, classe);
+    } else if (delta > 0 && janela->histograma[classe] == 1) {
+        mapa_marcar(&janela->ocupadas, classe);
+    }
+    for (int c = 0; c < 2; c++) {
+        if (classe < janela->cursores[c].classe) janela->cursores[c].abaixo += delta;
+    }
+}
+
+// 1 se a posição a deve ficar acima da posição b no heap
+static int precede(const Janela *janela, const HeapJanela *heap, size_t a, size_t b) {
+    int va = janela->valores[a];
+    int vb = janela->valores[b];
+    return heap->maximo ? va > vb : va < vb;
+}
+
+static void heap_colocar(Janela *janela, HeapJanela *heap, size_t i, size_t posicao) {
+    heap->posicoes[i] = posicao;
+    janela->indice_heap[posicao] = i;
+    janela->no_superior[posicao] = heap == &janela->superior;
+}
+
+static void heap_subir(Janela *janela, HeapJanela *heap, size_t i) {
+    size_t posicao = heap->posicoes[i];
+    while (i > 0) {
+        size_t pai = (i - 1) / 2;
+        if (!precede(janela, heap, posicao, heap->posicoes[pai])) break;
+        heap_colocar(janela, heap, i, heap->posicoes[pai]);
+        i = pai;
+    }
+    heap_colocar(janela, heap, i, posicao);
+}
+
+static void heap_descer(Janela *janela, HeapJanela *heap, size_t i) {
+    size_t posicao = heap->posicoes[i];
+    for (;;) {
+        size_t filho = 2 * i + 1;
+        if (filho >= heap->tamanho) break;
+        if (filho + 1 < heap->tamanho &&
+            precede(janela, heap, heap->posicoes[filho + 1], heap->posicoes[filho])) {
+            filho++;
+        }
+        if (!precede(janela, heap, heap->posicoes[filho], posicao)) break;
+        heap_colocar(janela, heap, i, heap->posicoes[filho]);
+        i = filho;
+    }
+    heap_colocar(janela, heap, i, posicao);
+}
+
+static void heap_inserir(Janela *janela, HeapJanela *heap, size_t posicao) {
+    heap_colocar(janela, heap, heap->tamanho++, posicao);
+    heap_subir(janela, heap, heap->tamanho - 1);
+}
+
+// Retira o elemento de índice i (o último ocupa o lugar e é reposicionado)
+static void heap_remover(Janela *janela, HeapJanela *heap, size_t i) {
+    heap->tamanho--;
+    if (i == heap->tamanho) return;
+    
+    size_t ultimo = heap->posicoes[heap->tamanho];
+    heap_colocar(janela, heap, i, ultimo);
+    heap_subir(janela, heap, i);
+    if (janela->indice_heap[ultimo] == i) heap_descer(janela, heap, i);
+}
+
+// Mantém |inferior| igual a |superior| ou um a mais
+static void heaps_equilibrar(Janela *janela) {
+    HeapJanela *inferior = &janela->inferior;
+    HeapJanela *superior = &janela->superior;
+    
+    while (inferior->tamanho > superior->tamanho + 1) {
+        size_t topo = inferior->posicoes[0];
+        heap_remover(janela, inferior, 0);
+        heap_inserir(janela, superior, topo);
+    }
+    while (superior->tamanho > inferior->tamanho) {
+        size_t topo = superior->posicoes[0];
+        heap_remover(janela, superior, 0);
+        heap_inserir(janela, inferior, topo);
+    }
+}
+
+static void heaps_adicionar(Janela *janela, size_t posicao) {
+    HeapJanela *inferior = &janela->inferior;
+    if (inferior->tamanho == 0 || janela->valores[posicao] <= janela->valores[inferior->posicoes[0]]) {
+        heap_inserir(janela, inferior, posicao);
+    } else {
+        heap_inserir(janela, &janela->superior, posicao);
+    }
+}
+
+static void heaps_retirar(Janela *janela, size_t posicao) {
+    HeapJanela *heap = janela->no_superior[posicao] ? &janela->superior : &janela->inferior;
+    heap_remover(janela, heap, janela->indice_heap[posicao]);
+}
+
+// Aloca os heaps e passa a eles os valores já na janela
+static int heaps_criar(Janela *janela) {
+    size_t largura = janela->largura;
+    janela->inferior.posicoes = (size_t*)malloc(largura * sizeof(size_t));
+    janela->superior.posicoes = (size_t*)malloc(largura * sizeof(size_t));
+    janela->indice_heap = (size_t*)malloc(largura * sizeof(size_t));
+    janela->no_superior = (unsigned char*)malloc(largura);
+    if (janela->inferior.posicoes == NULL || janela->superior.posicoes == NULL ||
+        janela->indice_heap == NULL || janela->no_superior == NULL) {
+        fprintf(stderr, "Erro ao alocar memória para os heaps da janela\n");
+        return -1;
+    }
+    janela->inferior.tamanho = 0;
+    janela->inferior.maximo = 1;
+    janela->superior.tamanho = 0;
+    janela->superior.maximo = 0;
+    
+    for (size_t i = 0; i < janela->quantidade; i++) {
+        heaps_adicionar(janela, i);
+        heaps_equilibrar(janela);
+    }
+    return 0;
+}
+
+int janela_iniciar(Janela *janela, size_t largura, Dominio dominio) {
+    janela->largura = largura;
+    janela->quantidade = 0;
+    janela->proxima = 0;
+    janela->soma = 0;
+    janela->soma_quadrados = 0;
+    janela->dominio = dominio;
+    janela->valores = NULL;
+    janela->histograma = NULL;
+    janela->inferior.posicoes = NULL;
+    janela->superior.posicoes = NULL;
+    janela->indice_heap = NULL;
+    janela->no_superior = NULL;
+    for (int nivel = 0; nivel < JANELA_NIVEIS_MAPA; nivel++) {
+        janela->ocupadas.palavras[nivel] = NULL;
+    }
+    for (int c = 0; c < 2; c++) {
+        janela->cursores[c].classe = 0;
+        janela->cursores[c].abaixo = 0;
+    }
+    
+    if (largura == 0) {
+        fprintf(stderr, "Largura da janela inválida\n");
+        return -1;
+    }
+    janela->valores = (int*)malloc(largura * sizeof(int));
+    if (janela->valores == NULL) {
+        fprintf(stderr, "Erro ao alocar memória para a janela\n");
+        return -1;
+    }
+    
+    if (dominio_limitado(dominio)) {
+        janela->histograma = (size_t*)calloc(dominio_classes(dominio), sizeof(size_t));
+        if (janela->histograma == NULL || mapa_criar(&janela->ocupadas, dominio_classes(dominio)) != 0) {
+            fprintf(stderr, "Erro ao alocar memória para o histograma da janela\n");
+            janela_liberar(janela);
+            return -1;
+        }
+        return 0;
+    }
+    
+    if (heaps_criar(janela) != 0) {
+        janela_liberar(janela);
+        return -1;
+    }
+    return 0;
+}
+
+int janela_inserir(Janela *janela, int valor) {
+    // Valor fora do domínio: a mediana passa para os heaps
+    if (janela->histograma != NULL && (valor < janela->dominio.min || valor > janela->dominio.max)) {
+        // Posições do buffer em ordem de chegada não importam aos heaps,
+        // só que todas as ocupadas (0 a quantidade - 1) sejam inseridas
+        if (heaps_criar(janela) != 0) return -1;
+        free(janela->histograma);
+        janela->histograma = NULL;
+        mapa_liberar(&janela->ocupadas);
+    }
+    
+    size_t posicao = janela->proxima;
+    int cheia = janela->quantidade == janela->largura;
+    
+    // Sai o valor mais antigo, que ocupa a posição do novo
+    if (cheia) {
+        int antigo = janela->valores[posicao];
+        janela->soma -= antigo;
+        janela->soma_quadrados -= (__int128)antigo * antigo;
+        if (janela->histograma != NULL) {
+            histograma_atualizar(janela, antigo, -1);
+        } else {
+            heaps_retirar(janela, posicao);
+        }
+    } else {
+        janela->quantidade++;
+    }
+    
+    janela->valores[posicao] = valor;
+    janela->soma += valor;
+    janela->soma_quadrados += (__int128)valor * valor;
+    janela->proxima = posicao + 1 == janela->largura ? 0 : posicao + 1;
+    
+    if (janela->histograma != NULL) {
+        histograma_atualizar(janela, valor, +1);
+        cursor_ajustar(&janela->cursores[0], janela, (janela->quantidade - 1) / 2);
+        cursor_ajustar(&janela->cursores[1], janela, janela->quantidade / 2);
+    } else {
+        heaps_adicionar(janela, posicao);
+        heaps_equilibrar(janela);
+    }
+    return 0;
+}
+
+int janela_usa_histograma(const Janela *janela) {
+    return janela->histograma != NULL;
+}
+
+double janela_media(const Janela *janela) {
+    return (double)janela->soma / janela->quantidade;
+}
+
+double janela_variancia(const Janela *janela) {
+    // n·Σx² − (Σx)² em inteiro exato, dividido por n² no final
+    __int128 n = janela->quantidade;
+    __int128 numerador = n * janela->soma_quadrados - (__int128)janela->soma * janela->soma;
+    return (double)numerador / ((double)janela->quantidade * janela->quantidade);
+}
+
+double janela_desvio_padrao(const Janela *janela) {
+    return sqrt(janela_variancia(janela));
+}
+
+double janela_mediana(const Janela *janela) {
+    int menor, maior;
+    if (janela->histograma != NULL) {
+        menor = janela->dominio.min + (int)janela->cursores[0].classe;
+        maior = janela->dominio.min + (int)janela->cursores[1].classe;
+    } else {
+        menor = janela->valores[janela->inferior.posicoes[0]];
+        maior = janela->quantidade % 2 == 0 ? janela->valores[janela->superior.posicoes[0]] : menor;
+    }
+    return ((double)menor + maior) / 2.0;
+}
+
+void janela_liberar(Janela *janela) {
+    free(janela->valores);
+    free(janela->histograma);
+    mapa_liberar(&janela->ocupadas);
+    free(janela->inferior.posicoes);
+    free(janela->superior.posicoes);
+    free(janela->indice_heap);
+    free(janela->no_superior);
+    janela->valores = NULL;
+    janela->histograma = NULL;
+    janela->inferior.posicoes = NULL;
+    janela->superior.posicoes = NULL;
+    janela->indice_heap = NULL;
+    janela->no_superior = NULL;
+    janela->quantidade = 0;
+}
@@ -0,0 +1,99 @@
+/*
+ * Instituição: Universidade Federal da Paraíba
+ * Disciplina: Sistemas Operacionais I
+ * Unidade 1 - Atividade 2
+ *
+ * Autor: Rodrigo Monteiro Fortes de Oliveira, 20240097664
+ *
+ * Nome do Módulo: janela.h
+ *
+ * Descrição:
+ *     Média, mediana e desvio padrão dos últimos W valores de um fluxo,
+ *     atualizados a cada valor novo sem recalcular a janela inteira. Os
+ *     valores ficam em um buffer circular; ao chegar um valor com a
+ *     janela cheia, o mais antigo sai.
+ *
+ *     Soma e soma dos quadrados (exatas, como no Resumo) são corrigidas
+ *     em O(1) a cada entrada e saída. A mediana depende do domínio:
+ *
+ *       limitado  histograma da janela com dois cursores, um em cada
+ *                 elemento do meio. Um mapa de bits das classes ocupadas,
+ *                 em três níveis de palavras de 64 bits, leva o cursor
+ *                 direto à classe ocupada vizinha: cada atualização move
+ *                 cada cursor no máximo duas classes ocupadas, em O(1)
+ *                 qualquer que seja o tamanho do domínio;
+ *       ilimitado dois heaps indexados pela posição no buffer: um de
+ *                 máximo com a metade menor e um de mínimo com a maior,
+ *                 com inserção e remoção de qualquer valor em O(log W).
+ *
+ *     Um valor fora do domínio limitado troca o histograma pelos heaps
+ *     uma única vez, sem perder a janela.
+ */
+
+#ifndef JANELA_H
+#define JANELA_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "estatisticas.h"
+
+// Níveis do mapa de classes ocupadas: 64³ cobre HISTOGRAMA_MAX_CLASSES
+#define JANELA_NIVEIS_MAPA 3
+
+// Bit c do nível 0: classe c ocupada; bit p do nível n + 1: palavra p do
+// nível n diferente de zero
+typedef struct {
+    uint64_t *palavras[JANELA_NIVEIS_MAPA];
+    size_t n_palavras[JANELA_NIVEIS_MAPA];
+} MapaClasses;
+
+// Cursor em um dos elementos do meio do histograma
+typedef struct {
+    size_t classe;      // classe do elemento
+    size_t abaixo;      // valores da janela em classes menores
+} CursorJanela;
+
+// Heap de posições do buffer circular, ordenado pelo valor de cada posição
+typedef struct {
+    size_t *posicoes;
+    size_t tamanho;
+    int maximo;         // 1: heap de máximo; 0: de mínimo
+} HeapJanela;
+
+typedef struct {
+    size_t largura;             // W
+    size_t quantidade;          // valores na janela (até W)
+    size_t proxima;             // posição do buffer que recebe o próximo valor
+    int *valores;               // buffer circular
+    long long soma;
+    __int128 soma_quadrados;
+    Dominio dominio;
+    size_t *histograma;         // NULL no modo com heaps
+    MapaClasses ocupadas;       // classes do histograma com contagem > 0
+    CursorJanela cursores[2];   // elementos (n-1)/2 e n/2
+    HeapJanela inferior;        // metade menor (máximo no topo)
+    HeapJanela superior;        // metade maior (mínimo no topo)
+    size_t *indice_heap;        // índice de cada posição do buffer no seu heap
+    unsigned char *no_superior; // 1 se a posição está no heap superior
+} Janela;
+
+// Prepara uma janela vazia de largura W; histograma se o domínio é
+// limitado, heaps caso contrário. Retorna 0 em caso de sucesso.
+int janela_iniciar(Janela *janela, size_t largura, Dominio dominio);
+
+// Acrescenta um valor, retirando o mais antigo se a janela está cheia.
+// Retorna 0, ou -1 se faltar memória para trocar o histograma pelos heaps.
+int janela_inserir(Janela *janela, int valor);
+
+// Retorna 1 se a mediana vem do histograma
+int janela_usa_histograma(const Janela *janela);
+
+// Estatísticas dos valores na janela (precisam de ao menos um valor)
+double janela_media(const Janela *janela);
+double janela_variancia(const Janela *janela);
+double janela_desvio_padrao(const Janela *janela);
+double janela_mediana(const Janela *janela);
+
+void janela_liberar(Janela *janela);
+
+#endif
@@ -0,0 +1,80 @@
+/*
+ * Instituição: Universidade Federal da Paraíba
+ * Disciplina: Sistemas Operacionais I
+ * Unidade 1 - Atividade 2
+ *
+ * Autor: Rodrigo Monteiro Fortes de Oliveira, 20240097664
+ *
+ * Nome do Módulo: latencia.c
+ *
+ * Descrição:
+ *     Implementação do modo de latência declarado em latencia.h.
+ */
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sched.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include "latencia.h"
+#include "selecao.h"
+
+int latencia_ativa = 0;
+
+// Resultado de cada pedido, para latencia_exibir
+static int memoria_travada = 0;
+static int tempo_real = 0;
+
+// Toca uma posição por página (leitura: os dados podem ser somente leitura)
+static void prefaltar(const void *dados, size_t bytes) {
+    const volatile char *p = (const volatile char*)dados;
+    long pagina = sysconf(_SC_PAGESIZE);
+    if (pagina <= 0) pagina = 4096;
+    
+    for (size_t i = 0; i < bytes; i += (size_t)pagina) {
+        (void)p[i];
+    }
+    if (bytes > 0) (void)p[bytes - 1];
+}
+
+void latencia_travar(void) {
+    if (!latencia_ativa) return;
+    memoria_travada = mlockall(MCL_CURRENT | MCL_FUTURE) == 0;
+}
+
+void latencia_iniciar(const void *dados, size_t bytes, size_t trabalho) {
+    const char *modo = getenv("ESTATISTICAS_LATENCIA");
+    if (modo == NULL || *modo == '\0' || strcmp(modo, "0") == 0 || latencia_ativa) {
+        return;
+    }
+    latencia_ativa = 1;
+    
+    // A área de trabalho é tocada ao ser reservada, travada ou não
+    if (trabalho > 0 && selecao_reservar(trabalho) != 0) {
+        fprintf(stderr, "Aviso: área de trabalho das seleções não reservada\n");
+    }
+    
+    latencia_travar();
+    if (!memoria_travada) {
+        perror("Aviso: mlockall falhou, páginas só pré-carregadas");
+        prefaltar(dados, bytes);
+    }
+    
+    if (strcmp(modo, "fifo") == 0) {
+        struct sched_param parametro = { .sched_priority = sched_get_priority_min(SCHED_FIFO) };
+        tempo_real = sched_setscheduler(0, SCHED_FIFO, &parametro) == 0;
+        if (!tempo_real) {
+            perror("Aviso: SCHED_FIFO indisponível, escalonamento normal");
+        }
+    }
+}
+
+void latencia_exibir(void) {
+    if (!latencia_ativa) return;
+    
+    printf("Modo de latência: memória %s, escalonamento %s\n",
+           memoria_travada ? "travada (mlockall)" : "pré-carregada",
+           tempo_real ? "SCHED_FIFO" : "normal");
+}
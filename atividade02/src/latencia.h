@@ -0,0 +1,50 @@
+/*
+ * Instituição: Universidade Federal da Paraíba
+ * Disciplina: Sistemas Operacionais I
+ * Unidade 1 - Atividade 2
+ *
+ * Autor: Rodrigo Monteiro Fortes de Oliveira, 20240097664
+ *
+ * Nome do Módulo: latencia.h
+ *
+ * Descrição:
+ *     Modo de latência, para medições de poucos milissegundos em que o
+ *     ruído do sistema pesa tanto quanto o valor medido. Ligado com
+ *     ESTATISTICAS_LATENCIA no ambiente (o benchmark a define com -l):
+ *
+ *       1     trava na RAM toda a memória atual e futura (mlockall), o
+ *             que também carrega todas as páginas de uma vez, e reserva
+ *             a área de trabalho das seleções (selecao_reservar): a
+ *             medição não inclui faltas de página nem malloc grandes;
+ *       fifo  o mesmo e, se permitido, passa o programa à classe de
+ *             tempo real SCHED_FIFO (prioridade mínima), herdada pelas
+ *             threads e processos criados depois.
+ *
+ *     Sem permissão (RLIMIT_MEMLOCK ou CAP_SYS_NICE) o programa avisa e
+ *     segue: os dados são pré-carregados tocando cada página e o
+ *     escalonamento continua o normal.
+ */
+
+#ifndef LATENCIA_H
+#define LATENCIA_H
+
+#include <stddef.h>
+
+// Diferente de zero quando o modo de latência está ligado
+extern int latencia_ativa;
+
+// Liga o modo se ESTATISTICAS_LATENCIA estiver definida. Deve ser chamada
+// depois de preparar os dados ('bytes' a partir de 'dados') e antes de
+// criar as threads ou processos medidos. 'trabalho' é o tamanho da área
+// de trabalho das seleções a reservar (0 quando a mediana e os quantis
+// vêm de histograma e não copiam o vetor).
+void latencia_iniciar(const void *dados, size_t bytes, size_t trabalho);
+
+// Trava a memória do processo atual: as travas do mlockall não passam
+// para os filhos de um fork(). Nada se o modo estiver desligado.
+void latencia_travar(void);
+
+// Exibe o que foi obtido (nada se desligado)
+void latencia_exibir(void);
+
+#endif
@@ -0,0 +1,149 @@
+/*
+ * Instituição: Universidade Federal da Paraíba
+ * Disciplina: Sistemas Operacionais I
+ * Unidade 1 - Atividade 2
+ *
+ * Autor: Rodrigo Monteiro Fortes de Oliveira, 20240097664
+ *
+ * Nome do Módulo: leitor.c
+ *
+ * Descrição:
+ *     Implementação das rotinas declaradas em leitor.h.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <limits.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include "leitor.h"
+
+int leitor_abrir(Leitor *leitor, const char *caminho) {
+    memset(leitor, 0, sizeof(*leitor));
+    leitor->linha = 1;
+    
+    if (strcmp(caminho, "-") == 0) {
+        leitor->fd = STDIN_FILENO;
+    } else {
+        leitor->fd = open(caminho, O_RDONLY | O_CLOEXEC);
+        if (leitor->fd == -1) {
+            perror("Erro ao abrir o arquivo de entrada");
+            return -1;
+        }
+        // Leitura sequencial: o núcleo pode ler adiante com mais agressividade
+        posix_fadvise(leitor->fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+    }
+    
+    leitor->buffer = (char*)malloc(LEITOR_BLOCO);
+    if (leitor->buffer == NULL) {
+        fprintf(stderr, "Erro ao alocar memória para o buffer de leitura\n");
+        leitor_fechar(leitor);
+        return -1;
+    }
+    
+    return 0;
+}
+
+// Move o que sobrou para o início do buffer e completa com nova leitura
+static int recarregar(Leitor *leitor) {
+    size_t restante = leitor->fim - leitor->inicio;
+    memmove(leitor->buffer, leitor->buffer + leitor->inicio, restante);
+    leitor->inicio = 0;
+    leitor->fim = restante;
+    
+    ssize_t lidos;
+    do {
+        lidos = read(leitor->fd, leitor->buffer + leitor->fim, LEITOR_BLOCO - leitor->fim);
+    } while (lidos == -1 && errno == EINTR);
+    
+    if (lidos == -1) {
+        perror("Erro ao ler a entrada");
+        leitor->erro = 1;
+        return -1;
+    }
+    if (lidos == 0) {
+        leitor->fim_arquivo = 1;
+    }
+    leitor->fim += lidos;
+    return 0;
+}
+
+static int separador(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == ',' || c == ';';
+}
+
+size_t leitor_ler(Leitor *leitor, int *destino, size_t maximo) {
+    size_t lidos = 0;
+    
+    while (lidos < maximo && !leitor->erro) {
+        // Pula separadores
+        while (leitor->inicio < leitor->fim && separador(leitor->buffer[leitor->inicio])) {
+            if (leitor->buffer[leitor->inicio] == '\n') leitor->linha++;
+            leitor->inicio++;
+        }
+    
+        if (leitor->inicio == leitor->fim) {
+            if (leitor->fim_arquivo || recarregar(leitor) != 0) break;
+            continue;
+        }
+    
+        // Delimita o número; se ele encosta no fim do buffer pode estar cortado
+        size_t fim_numero = leitor->inicio;
+        while (fim_numero < leitor->fim && !separador(leitor->buffer[fim_numero])) {
+            fim_numero++;
+        }
+        if (fim_numero == leitor->fim && !leitor->fim_arquivo) {
+            if (leitor->inicio == 0 && leitor->fim == LEITOR_BLOCO) {
+                fprintf(stderr, "Linha %zu: valor longo demais\n", leitor->linha);
+                leitor->erro = 1;
+                break;
+            }
+            if (recarregar(leitor) != 0) break;
+            continue;
+        }
+    
+        // Converte sinal e dígitos com verificação de estouro
+        const char *p = leitor->buffer + leitor->inicio;
+        const char *fim = leitor->buffer + fim_numero;
+        int negativo = 0;
+        if (*p == '-' || *p == '+') {
+            negativo = (*p == '-');
+            p++;
+        }
+    
+        long long valor = 0;
+        int valido = p < fim;
+        for (; p < fim && valido; p++) {
+            if (*p < '0' || *p > '9') {
+                valido = 0;
+                break;
+            }
+            valor = valor * 10 + (*p - '0');
+            if (valor > (long long)INT_MAX + 1) valido = 0;
+        }
+        if (negativo) valor = -valor;
+    
+        if (!valido || valor > INT_MAX || valor < INT_MIN) {
+            fprintf(stderr, "Linha %zu: valor inválido '%.*s'\n", leitor->linha,
+                    (int)(fim_numero - leitor->inicio), leitor->buffer + leitor->inicio);
+            leitor->erro = 1;
+            break;
+        }
+    
+        destino[lidos++] = (int)valor;
+        leitor->inicio = fim_numero;
+    }
+    
+    return lidos;
+}
+
+void leitor_fechar(Leitor *leitor) {
+    if (leitor->fd > STDIN_FILENO) {
+        close(leitor->fd);
+    }
+    free(leitor->buffer);
+    leitor->buffer = NULL;
+    leitor->fd = -1;
+}
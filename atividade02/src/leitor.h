@@ -0,0 +1,45 @@
+/*
+ * Instituição: Universidade Federal da Paraíba
+ * Disciplina: Sistemas Operacionais I
+ * Unidade 1 - Atividade 2
+ *
+ * Autor: Rodrigo Monteiro Fortes de Oliveira, 20240097664
+ *
+ * Nome do Módulo: leitor.h
+ *
+ * Descrição:
+ *     Leitura de inteiros em texto (um ou mais por linha, separados por
+ *     espaço, vírgula ou ponto e vírgula) a partir de um arquivo ou da
+ *     entrada padrão. O arquivo é lido em blocos grandes com read() e
+ *     convertido em lotes de inteiros, sem nunca carregar tudo na memória.
+ */
+
+#ifndef LEITOR_H
+#define LEITOR_H
+
+#include <stddef.h>
+
+// Tamanho do bloco lido do arquivo a cada chamada de read()
+#define LEITOR_BLOCO (1 << 20)
+
+typedef struct {
+    int fd;
+    char *buffer;
+    size_t inicio;       // próximo caractere a converter
+    size_t fim;          // fim dos dados válidos no buffer
+    int fim_arquivo;
+    int erro;            // 1 após valor inválido ou falha de leitura
+    size_t linha;        // linha atual (para mensagens de erro)
+} Leitor;
+
+// Abre o arquivo para leitura ("-" significa entrada padrão)
+int leitor_abrir(Leitor *leitor, const char *caminho);
+
+// Converte até 'maximo' valores para 'destino'; retorna quantos leu
+// (0 no fim do arquivo ou em erro; consulte leitor->erro)
+size_t leitor_ler(Leitor *leitor, int *destino, size_t maximo);
+
+// Fecha o arquivo (exceto a entrada padrão) e libera o buffer
+void leitor_fechar(Leitor *leitor);
+
+#endif
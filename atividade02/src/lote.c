@@ -0,0 +1,180 @@
+/*
+ * Instituição: Universidade Federal da Paraíba
+ * Disciplina: Sistemas Operacionais I
+ * Unidade 1 - Atividade 2
+ *
+ * Autor: Rodrigo Monteiro Fortes de Oliveira, 20240097664
+ *
+ * Nome do Módulo: lote.c
+ *
+ * Descrição:
+ *     Implementação do processamento em lote declarado em lote.h. A
+ *     fila é um vetor com os índices das séries na ordem de distribuição
+ *     e um cursor incrementado com uma operação atômica por série.
+ */
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <pthread.h>
+#include "lote.h"
+#include "tempo.h"
+#include "rastro.h"
+
+// Estado compartilhado pelas threads de uma chamada
+typedef struct {
+    const ConjuntoSeries *series;
+    Dominio dominio;
+    const size_t *fila;             // índices das séries na ordem de distribuição
+    size_t proxima;                 // cursor da fila (atômico)
+    ResultadoSerie *resultados;
+} Lote;
+
+// Argumentos de uma thread trabalhadora
+typedef struct {
+    Lote *lote;
+    CargaTrabalhador carga;
+} __attribute__((aligned(LINHA_CACHE))) TrabalhadorLote;
+
+// Par (tamanho, índice) para ordenar a fila
+typedef struct {
+    size_t tamanho;
+    size_t indice;
+} ItemFila;
+
+// Ordem decrescente de tamanho; empates pelo índice, para ser determinística
+static int comparar_itens(const void *a, const void *b) {
+    const ItemFila *ia = (const ItemFila*)a;
+    const ItemFila *ib = (const ItemFila*)b;
+    
+    if (ia->tamanho != ib->tamanho) return ia->tamanho > ib->tamanho ? -1 : 1;
+    if (ia->indice != ib->indice) return ia->indice < ib->indice ? -1 : 1;
+    return 0;
+}
+
+// Resumo completo de uma série
+static void processar_serie(const Lote *lote, size_t s) {
+    const ConjuntoSeries *series = lote->series;
+    ResultadoSerie *resultado = &lote->resultados[s];
+    size_t tamanho = series->tamanhos[s];
+    
+    if (tamanho == 0) {
+        resultado->media = NAN;
+        resultado->mediana = NAN;
+        resultado->desvio = NAN;
+        return;
+    }
+    
+    const void *valores = (const char*)series->valores +
+                          series->deslocamentos[s] * elemento_bytes(series->tipo);
+    Resumo resumo;
+    resumo_iniciar(&resumo, lote->dominio);
+    resumo_acumular_elementos(&resumo, valores, series->tipo, tamanho);
+    resultado->media = resumo_media(&resumo);
+    resultado->mediana = resumo_mediana_elementos(&resumo, valores, series->tipo, tamanho);
+    resultado->desvio = resumo_desvio_padrao(&resumo);
+    resumo_liberar(&resumo);
+}
+
+// Thread trabalhadora: tira séries da fila até esvaziá-la
+static void* trabalhar(void *arg) {
+    TrabalhadorLote *trabalhador = (TrabalhadorLote*)arg;
+    Lote *lote = trabalhador->lote;
+    rastro_nomear("series");
+    rastro_comecar("series");
+    
+    struct timespec inicio, fim;
+    marcar_instante(&inicio);
+    
+    for (;;) {
+        size_t posicao = __atomic_fetch_add(&lote->proxima, 1, __ATOMIC_RELAXED);
+        if (posicao >= lote->series->quantidade) break;
+    
+        size_t s = lote->fila[posicao];
+        processar_serie(lote, s);
+        trabalhador->carga.series++;
+        trabalhador->carga.valores += lote->series->tamanhos[s];
+    }
+    
+    marcar_instante(&fim);
+    trabalhador->carga.tempo_ms = diferenca_ms(inicio, fim);
+    rastro_terminar("series");
+    return NULL;
+}
+
+int lote_processar(const ConjuntoSeries *series, Dominio dominio, int n_threads, int ordem,
+                   const Afinidade *afinidade, ResultadoSerie *resultados,
+                   CargaTrabalhador *cargas) {
+    if (n_threads < 1) n_threads = 1;
+    
+    size_t *fila = (size_t*)malloc((series->quantidade > 0 ? series->quantidade : 1) * sizeof(size_t));
+    TrabalhadorLote *trabalhadores = (TrabalhadorLote*)aligned_alloc(
+        LINHA_CACHE, n_threads * sizeof(TrabalhadorLote));
+    pthread_t *threads = (pthread_t*)malloc(n_threads * sizeof(pthread_t));
+    if (fila == NULL || trabalhadores == NULL || threads == NULL) {
+        fprintf(stderr, "Erro ao alocar memória para o lote\n");
+        free(fila);
+        free(trabalhadores);
+        free(threads);
+        return -1;
+    }
+    
+    // Fila: maiores primeiro, ou na ordem das colunas
+    if (ordem == LOTE_ORDEM_TAMANHO && series->quantidade > 1) {
+        ItemFila *itens = (ItemFila*)malloc(series->quantidade * sizeof(ItemFila));
+        if (itens == NULL) {
+            fprintf(stderr, "Erro ao alocar memória para o lote\n");
+            free(fila);
+            free(trabalhadores);
+            free(threads);
+            return -1;
+        }
+        for (size_t s = 0; s < series->quantidade; s++) {
+            itens[s].tamanho = series->tamanhos[s];
+            itens[s].indice = s;
+        }
+        qsort(itens, series->quantidade, sizeof(ItemFila), comparar_itens);
+        for (size_t s = 0; s < series->quantidade; s++) {
+            fila[s] = itens[s].indice;
+        }
+        free(itens);
+    } else {
+        for (size_t s = 0; s < series->quantidade; s++) {
+            fila[s] = s;
+        }
+    }
+    
+    Lote lote = { series, dominio, fila, 0, resultados };
+    
+    int criadas = 0;
+    for (int t = 0; t < n_threads; t++) {
+        trabalhadores[t].lote = &lote;
+        trabalhadores[t].carga.series = 0;
+        trabalhadores[t].carga.valores = 0;
+        trabalhadores[t].carga.tempo_ms = 0.0;
+    
+        pthread_attr_t atributos;
+        pthread_attr_init(&atributos);
+        afinidade_atributos(afinidade, t, &atributos);
+        int ret = pthread_create(&threads[t], &atributos, trabalhar, &trabalhadores[t]);
+        pthread_attr_destroy(&atributos);
+        if (ret != 0) {
+            fprintf(stderr, "Erro ao criar thread do lote: %d\n", ret);
+            break;
+        }
+        rastro_marcar("criada", t);
+        criadas++;
+    }
+    
+    // As threads criadas esvaziam a fila mesmo que alguma criação falhe
+    for (int t = 0; t < criadas; t++) {
+        pthread_join(threads[t], NULL);
+        if (cargas != NULL) cargas[t] = trabalhadores[t].carga;
+    }
+    
+    free(fila);
+    free(trabalhadores);
+    free(threads);
+    return criadas == n_threads ? 0 : -1;
+}
@@ -0,0 +1,68 @@
+/*
+ * Instituição: Universidade Federal da Paraíba
+ * Disciplina: Sistemas Operacionais I
+ * Unidade 1 - Atividade 2
+ *
+ * Autor: Rodrigo Monteiro Fortes de Oliveira, 20240097664
+ *
+ * Nome do Módulo: lote.h
+ *
+ * Descrição:
+ *     Estatísticas de muitas séries independentes em uma única chamada.
+ *     As séries chegam em formato colunar: os valores de todas lado a
+ *     lado em um único vetor e duas colunas com o deslocamento e o
+ *     tamanho de cada série dentro dele.
+ *
+ *     As threads trabalhadoras tiram a próxima série de uma fila
+ *     compartilhada (um contador atômico), que por padrão vem ordenada
+ *     da maior para a menor: as séries longas começam primeiro e as
+ *     curtas preenchem o fim, e nenhuma thread fica com uma série longa
+ *     sozinha depois que as outras acabaram. Cada série é processada
+ *     inteira por uma só thread, com um resumo próprio (histograma do
+ *     domínio), e produz uma linha de resultado.
+ */
+
+#ifndef LOTE_H
+#define LOTE_H
+
+#include <stddef.h>
+#include "estatisticas.h"
+#include "afinidade.h"
+
+// Ordem em que as séries são distribuídas às threads
+#define LOTE_ORDEM_TAMANHO 0    // maiores primeiro (balanceia pelo tamanho)
+#define LOTE_ORDEM_ENTRADA 1    // na ordem das colunas
+
+// Séries em formato colunar
+typedef struct {
+    const void *valores;            // todas as séries, no tipo 'tipo'
+    TipoElemento tipo;
+    const size_t *deslocamentos;    // início de cada série em 'valores'
+    const size_t *tamanhos;
+    size_t quantidade;
+} ConjuntoSeries;
+
+// Resultado de uma série (NAN nas três se a série for vazia)
+typedef struct {
+    double media;
+    double mediana;
+    double desvio;
+} ResultadoSerie;
+
+// O que cada thread trabalhadora processou
+typedef struct {
+    size_t series;
+    size_t valores;
+    double tempo_ms;
+} CargaTrabalhador;
+
+// Calcula média, mediana e desvio padrão de cada série com n_threads
+// threads (a t-ésima fixada na CPU do trabalhador t de 'afinidade'; NULL:
+// sem fixar). 'resultados' tem uma posição por série, na ordem das
+// colunas; 'cargas' (pode ser NULL) uma por thread. Retorna 0 em caso
+// de sucesso.
+int lote_processar(const ConjuntoSeries *series, Dominio dominio, int n_threads, int ordem,
+                   const Afinidade *afinidade, ResultadoSerie *resultados,
+                   CargaTrabalhador *cargas);
+
+#endif
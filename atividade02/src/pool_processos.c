@@ -0,0 +1,455 @@
+/*
+ * Instituição: Universidade Federal da Paraíba
+ * Disciplina: Sistemas Operacionais I
+ * Unidade 1 - Atividade 2
+ *
+ * Autor: Rodrigo Monteiro Fortes de Oliveira, 20240097664
+ *
+ * Nome do Módulo: pool_processos.c
+ *
+ * Descrição:
+ *     Implementação do pool de processos declarado em pool_processos.h.
+ *     A fila de trabalhos é um pipe em modo pacote (O_DIRECT): cada
+ *     leitura devolve exatamente um descritor, mesmo com vários
+ *     trabalhadores lendo ao mesmo tempo. Os resultados voltam por um
+ *     pipe comum, em mensagens menores que PIPE_BUF (escritas atômicas).
+ *     O esboço de cada trabalho, quando pedido, vai para o slot do
+ *     trabalho na área compartilhada antes do resultado ser escrito no
+ *     pipe; ao ler o resultado o pai já enxerga o slot preenchido.
+ *
+ *     O pai espera os resultados com um epoll sobre o pipe e um pidfd
+ *     por trabalhador: como os outros trabalhadores mantêm a escrita do
+ *     pipe aberta, a morte de um deles não gera fim de arquivo, e sem os
+ *     pidfds o pai ficaria bloqueado no read para sempre. Cada
+ *     trabalhador lê o descritor direto no seu slot em memória
+ *     compartilhada, de modo que não há instante em que um trabalho saiu
+ *     da fila sem estar anotado; quando um morre, o pai recolhe os
+ *     resultados já escritos, reenvia o trabalho do slot se ainda
+ *     pendente (até POOL_MAX_TENTATIVAS vezes) e cria outro trabalhador
+ *     no lugar.
+ */
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include "esboco.h"
+#include "pool_processos.h"
+#include "rastro.h"
+#include "latencia.h"
+
+// Pacotes que cabem no pipe de trabalhos sem bloquear (um por página)
+#define PACOTES_PIPE 16
+
+// Envios de cada trabalho (o primeiro e os reenvios após a morte de um trabalhador)
+#define POOL_MAX_TENTATIVAS 3
+
+// Id do slot de um trabalhador sem trabalho em andamento
+#define TRABALHO_LIVRE SIZE_MAX
+
+#ifndef P_PIDFD
+#define P_PIDFD 3
+#endif
+
+// Trabalho enviado e ainda sem resultado
+typedef struct {
+    DescritorTrabalho trabalho;
+    int tentativas;
+} Pendente;
+
+struct PoolProcessos {
+    pid_t *pids;
+    int *pidfds;
+    int n_processos;
+    int trabalhos_fd;     // escrita da fila de trabalhos
+    int resultados_fd;    // leitura dos resultados (não bloqueante)
+    
+    // Pontas dos trabalhadores, mantidas para recriar um que morra
+    int trabalhos_leitura;
+    int resultados_escrita;
+    int epoll_fd;
+    
+    // Trabalho em cálculo por trabalhador (id TRABALHO_LIVRE: nenhum), em MAP_SHARED
+    DescritorTrabalho *em_andamento;
+    size_t bytes_andamento;
+    
+    Pendente *pendentes;
+    size_t n_pendentes;
+    size_t capacidade_pendentes;
+    
+    // Resultados lidos ao recolher um trabalhador morto, ainda não entregues
+    ResultadoTrabalho *prontos;
+    size_t n_prontos;
+    size_t capacidade_prontos;
+    
+    // Parâmetros dos trabalhadores
+    const void *dados;
+    TipoElemento tipo;
+    Dominio dominio;
+    const AreaEsbocos *esbocos;
+    const Afinidade *afinidade;
+};
+
+// Lê exatamente 'bytes' bytes; retorna 0 em fim de arquivo antes disso
+static int ler_mensagem(int fd, void *buffer, size_t bytes) {
+    char *destino = (char*)buffer;
+    while (bytes > 0) {
+        ssize_t lidos = read(fd, destino, bytes);
+        if (lidos == -1) {
+            if (errno == EINTR) continue;
+            return -1;
+        }
+        if (lidos == 0) return 0;
+        destino += lidos;
+        bytes -= lidos;
+    }
+    return 1;
+}
+
+// Escreve a mensagem inteira, repetindo se interrompida por sinal
+static int escrever_mensagem(int fd, const void *buffer, size_t bytes) {
+    ssize_t escritos;
+    do {
+        escritos = write(fd, buffer, bytes);
+    } while (escritos == -1 && errno == EINTR);
+    return escritos == (ssize_t)bytes ? 0 : -1;
+}
+
+// Laço do processo trabalhador: só termina quando a fila é fechada
+static void trabalhador(int trabalhos_fd, int resultados_fd, const void *dados,
+                        TipoElemento tipo, Dominio dominio, const AreaEsbocos *esbocos,
+                        DescritorTrabalho *em_andamento) {
+    rastro_nomear("trabalhador");
+    
+    // Lido direto no slot compartilhado: se este processo morrer, o pai sabe o que reenviar
+    while (ler_mensagem(trabalhos_fd, em_andamento, sizeof(*em_andamento)) == 1) {
+        DescritorTrabalho trabalho = *em_andamento;
+        rastro_comecar("trabalho");
+        const void *inicio = (const char*)dados + trabalho.deslocamento * elemento_bytes(tipo);
+    
+        // Uma única passada: momentos e histograma
+        Resumo resumo;
+        resumo_iniciar(&resumo, dominio);
+        if (esbocos != NULL) {
+            resumo_ativar_esboco(&resumo, esbocos->precisao);
+        }
+        resumo_acumular_elementos(&resumo, inicio, tipo, trabalho.tamanho);
+    
+        ResultadoTrabalho resultado;
+        resultado.id = trabalho.id;
+        resultado.media = resumo_media(&resumo);
+        resultado.mediana = resumo_mediana_elementos(&resumo, inicio, tipo, trabalho.tamanho);
+        resultado.desvio = resumo_desvio_padrao(&resumo);
+    
+        // Só o esboço sai do trabalhador, não os valores
+        if (esbocos != NULL) {
+            char *slot = (char*)esbocos->area + trabalho.id * esbocos->bytes_slot;
+            if (esboco_serializar(resumo_converter_esboco(&resumo), slot,
+                                  esbocos->bytes_slot) != 0) {
+                _exit(EXIT_FAILURE);
+            }
+        }
+        resumo_liberar(&resumo);
+    
+        if (escrever_mensagem(resultados_fd, &resultado, sizeof(resultado)) == -1) {
+            perror("Erro ao escrever resultado no pipe");
+            _exit(EXIT_FAILURE);
+        }
+        __atomic_store_n(&em_andamento->id, TRABALHO_LIVRE, __ATOMIC_RELEASE);
+        rastro_terminar("trabalho");
+    }
+    
+    _exit(EXIT_SUCCESS);
+}
+
+// Cria o trabalhador i e passa a acompanhá-lo pelo pidfd; retorna 0 em caso de sucesso
+static int criar_trabalhador(PoolProcessos *pool, int i) {
+    pool->em_andamento[i].id = TRABALHO_LIVRE;
+    
+    pid_t pid = fork();
+    if (pid == 0) {
+        // Trabalhador: fica só com a leitura dos trabalhos e a escrita dos resultados
+        close(pool->trabalhos_fd);
+        close(pool->resultados_fd);
+        close(pool->epoll_fd);
+        afinidade_fixar(pool->afinidade, i);
+        latencia_travar();
+        trabalhador(pool->trabalhos_leitura, pool->resultados_escrita, pool->dados, pool->tipo,
+                    pool->dominio, pool->esbocos, &pool->em_andamento[i]);
+    } else if (pid < 0) {
+        perror("Erro ao criar fork para trabalhador");
+        return -1;
+    }
+    rastro_marcar("fork", pid);
+    pool->pids[i] = pid;
+    
+    pool->pidfds[i] = (int)syscall(SYS_pidfd_open, pid, 0);
+    struct epoll_event evento;
+    evento.events = EPOLLIN;
+    evento.data.u64 = (uint64_t)i + 1;
+    if (pool->pidfds[i] == -1 || epoll_ctl(pool->epoll_fd, EPOLL_CTL_ADD, pool->pidfds[i], &evento) == -1) {
+        perror("Erro ao acompanhar o trabalhador");
+        return -1;
+    }
+    return 0;
+}
+
+// Coleta o trabalhador i, que terminou
+static void coletar_trabalhador(PoolProcessos *pool, int i) {
+    if (pool->pidfds[i] == -1) {
+        // Criado, mas sem pidfd (falha ao acompanhá-lo)
+        waitpid(pool->pids[i], NULL, 0);
+    } else {
+        epoll_ctl(pool->epoll_fd, EPOLL_CTL_DEL, pool->pidfds[i], NULL);
+    
+        siginfo_t informacao;
+        while (waitid((idtype_t)P_PIDFD, (id_t)pool->pidfds[i], &informacao, WEXITED) == -1 &&
+               errno == EINTR) {
+        }
+        close(pool->pidfds[i]);
+    }
+    rastro_marcar("coletado", pool->pids[i]);
+    pool->pidfds[i] = -1;
+    pool->pids[i] = 0;
+}
+
+// Retira o trabalho dos pendentes; retorna 0 se ele não estava lá
+static int retirar_pendente(PoolProcessos *pool, size_t id) {
+    for (size_t p = 0; p < pool->n_pendentes; p++) {
+        if (pool->pendentes[p].trabalho.id == id) {
+            pool->pendentes[p] = pool->pendentes[--pool->n_pendentes];
+            return 1;
+        }
+    }
+    return 0;
+}
+
+// Lê um resultado já disponível no pipe; retorna 1, 0 se não há nenhum ou -1
+static int ler_resultado(PoolProcessos *pool, ResultadoTrabalho *resultado) {
+    // Mensagens menores que PIPE_BUF são escritas inteiras: um read basta
+    ssize_t lidos;
+    do {
+        lidos = read(pool->resultados_fd, resultado, sizeof(*resultado));
+    } while (lidos == -1 && errno == EINTR);
+    
+    if (lidos == -1 && errno == EAGAIN) return 0;
+    if (lidos != (ssize_t)sizeof(*resultado)) return -1;
+    
+    retirar_pendente(pool, resultado->id);
+    return 1;
+}
+
+// Trabalhador i morreu: guarda os resultados que ele (e os outros) já
+// escreveram, reenvia o trabalho que ele calculava e cria outro no lugar
+static int recuperar_trabalhador(PoolProcessos *pool, int i) {
+    coletar_trabalhador(pool, i);
+    
+    for (;;) {
+        if (pool->n_prontos == pool->capacidade_prontos) {
+            size_t capacidade = pool->capacidade_prontos > 0 ? 2 * pool->capacidade_prontos : PACOTES_PIPE;
+            ResultadoTrabalho *prontos = (ResultadoTrabalho*)realloc(pool->prontos,
+                                                                     capacidade * sizeof(ResultadoTrabalho));
+            if (prontos == NULL) {
+                fprintf(stderr, "Erro ao alocar memória para os resultados do pool\n");
+                return -1;
+            }
+            pool->prontos = prontos;
+            pool->capacidade_prontos = capacidade;
+        }
+        int lido = ler_resultado(pool, &pool->prontos[pool->n_prontos]);
+        if (lido == -1) {
+            perror("Erro ao ler resultado do pool");
+            return -1;
+        }
+        if (lido == 0) break;
+        pool->n_prontos++;
+    }
+    
+    // Trabalho interrompido: ainda pendente se o resultado não chegou
+    size_t anotado = pool->em_andamento[i].id;
+    for (size_t p = 0; anotado != TRABALHO_LIVRE && p < pool->n_pendentes; p++) {
+        Pendente *pendente = &pool->pendentes[p];
+        if (pendente->trabalho.id != anotado) continue;
+    
+        fprintf(stderr, "Aviso: trabalhador do pool terminou durante o trabalho %zu (tentativa %d de %d)\n",
+                pendente->trabalho.id, pendente->tentativas, POOL_MAX_TENTATIVAS);
+        if (pendente->tentativas == POOL_MAX_TENTATIVAS) {
+            return -1;
+        }
+        pendente->tentativas++;
+        if (escrever_mensagem(pool->trabalhos_fd, &pendente->trabalho, sizeof(pendente->trabalho)) == -1) {
+            perror("Erro ao reenviar trabalho");
+            return -1;
+        }
+        break;
+    }
+    
+    return criar_trabalhador(pool, i);
+}
+
+PoolProcessos* pool_processos_criar(int n_processos, const void *dados, TipoElemento tipo,
+                                    Dominio dominio, const AreaEsbocos *esbocos,
+                                    const Afinidade *afinidade) {
+    PoolProcessos *pool = (PoolProcessos*)calloc(1, sizeof(PoolProcessos));
+    if (pool == NULL) {
+        fprintf(stderr, "Erro ao alocar memória para o pool\n");
+        return NULL;
+    }
+    pool->dados = dados;
+    pool->tipo = tipo;
+    pool->dominio = dominio;
+    pool->esbocos = esbocos;
+    pool->afinidade = afinidade;
+    pool->trabalhos_fd = -1;
+    pool->resultados_fd = -1;
+    pool->trabalhos_leitura = -1;
+    pool->resultados_escrita = -1;
+    pool->epoll_fd = -1;
+    
+    pool->pids = (pid_t*)calloc(n_processos, sizeof(pid_t));
+    pool->pidfds = (int*)malloc(n_processos * sizeof(int));
+    pool->bytes_andamento = n_processos * sizeof(DescritorTrabalho);
+    pool->em_andamento = (DescritorTrabalho*)mmap(NULL, pool->bytes_andamento, PROT_READ | PROT_WRITE,
+                                                  MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (pool->pids == NULL || pool->pidfds == NULL || pool->em_andamento == MAP_FAILED) {
+        fprintf(stderr, "Erro ao alocar memória para o pool\n");
+        if (pool->em_andamento == MAP_FAILED) pool->em_andamento = NULL;
+        pool_processos_destruir(pool);
+        return NULL;
+    }
+    for (int i = 0; i < n_processos; i++) {
+        pool->pidfds[i] = -1;
+    }
+    
+    // Fila de trabalhos em modo pacote e canal de resultados
+    int trabalhos[2], resultados[2];
+    if (pipe2(trabalhos, O_DIRECT | O_CLOEXEC) == -1) {
+        perror("Erro ao criar pipe de trabalhos");
+        pool_processos_destruir(pool);
+        return NULL;
+    }
+    pool->trabalhos_leitura = trabalhos[0];
+    pool->trabalhos_fd = trabalhos[1];
+    if (pipe2(resultados, O_CLOEXEC) == -1) {
+        perror("Erro ao criar pipe de resultados");
+        pool_processos_destruir(pool);
+        return NULL;
+    }
+    pool->resultados_fd = resultados[0];
+    pool->resultados_escrita = resultados[1];
+    fcntl(pool->resultados_fd, F_SETFL, O_NONBLOCK);
+    
+    // Resultados e término dos trabalhadores em um único epoll (dado 0: pipe)
+    pool->epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    struct epoll_event evento;
+    evento.events = EPOLLIN;
+    evento.data.u64 = 0;
+    if (pool->epoll_fd == -1 || epoll_ctl(pool->epoll_fd, EPOLL_CTL_ADD, pool->resultados_fd, &evento) == -1) {
+        perror("Erro ao criar epoll do pool");
+        pool_processos_destruir(pool);
+        return NULL;
+    }
+    
+    // Cria os trabalhadores (custo pago uma única vez)
+    for (int i = 0; i < n_processos; i++) {
+        pool->n_processos++;
+        if (criar_trabalhador(pool, i) != 0) {
+            pool_processos_destruir(pool);
+            return NULL;
+        }
+    }
+    
+    return pool;
+}
+
+int pool_processos_submeter(PoolProcessos *pool, const DescritorTrabalho *trabalho) {
+    if (pool->n_pendentes == pool->capacidade_pendentes) {
+        size_t capacidade = pool->capacidade_pendentes > 0 ? 2 * pool->capacidade_pendentes : PACOTES_PIPE;
+        Pendente *pendentes = (Pendente*)realloc(pool->pendentes, capacidade * sizeof(Pendente));
+        if (pendentes == NULL) {
+            fprintf(stderr, "Erro ao alocar memória para os trabalhos pendentes\n");
+            return -1;
+        }
+        pool->pendentes = pendentes;
+        pool->capacidade_pendentes = capacidade;
+    }
+    pool->pendentes[pool->n_pendentes].trabalho = *trabalho;
+    pool->pendentes[pool->n_pendentes].tentativas = 1;
+    pool->n_pendentes++;
+    
+    if (escrever_mensagem(pool->trabalhos_fd, trabalho, sizeof(*trabalho)) == -1) {
+        perror("Erro ao enviar trabalho");
+        pool->n_pendentes--;
+        return -1;
+    }
+    return 0;
+}
+
+int pool_processos_receber(PoolProcessos *pool, ResultadoTrabalho *resultado) {
+    for (;;) {
+        // Primeiro os guardados ao recuperar um trabalhador, depois o pipe
+        if (pool->n_prontos > 0) {
+            *resultado = pool->prontos[--pool->n_prontos];
+            return 0;
+        }
+        int lido = ler_resultado(pool, resultado);
+        if (lido == 1) return 0;
+        if (lido == -1) {
+            fprintf(stderr, "Erro ao receber resultado do pool\n");
+            return -1;
+        }
+    
+        // Nada no pipe: espera um resultado ou o término de um trabalhador
+        struct epoll_event eventos[8];
+        int n = epoll_wait(pool->epoll_fd, eventos, 8, -1);
+        if (n == -1) {
+            if (errno == EINTR) continue;
+            perror("Erro ao aguardar resultados do pool");
+            return -1;
+        }
+        for (int e = 0; e < n; e++) {
+            if (eventos[e].data.u64 == 0) continue;
+    
+            int i = (int)(eventos[e].data.u64 - 1);
+            if (recuperar_trabalhador(pool, i) != 0) {
+                fprintf(stderr, "Erro ao receber resultado do pool\n");
+                return -1;
+            }
+        }
+    }
+}
+
+int pool_processos_janela(const PoolProcessos *pool) {
+    // O pipe de trabalhos guarda poucos pacotes; mantém todos ocupados sem encher
+    int janela = 2 * pool->n_processos;
+    return janela < PACOTES_PIPE ? janela : PACOTES_PIPE;
+}
+
+void pool_processos_destruir(PoolProcessos *pool) {
+    // Fechar a fila faz cada trabalhador ler fim de arquivo e encerrar
+    if (pool->trabalhos_fd != -1) close(pool->trabalhos_fd);
+    
+    for (int i = 0; i < pool->n_processos; i++) {
+        if (pool->pids[i] != 0) coletar_trabalhador(pool, i);
+    }
+    
+    if (pool->trabalhos_leitura != -1) close(pool->trabalhos_leitura);
+    if (pool->resultados_fd != -1) close(pool->resultados_fd);
+    if (pool->resultados_escrita != -1) close(pool->resultados_escrita);
+    if (pool->epoll_fd != -1) close(pool->epoll_fd);
+    if (pool->em_andamento != NULL) munmap(pool->em_andamento, pool->bytes_andamento);
+    free(pool->pids);
+    free(pool->pidfds);
+    free(pool->pendentes);
+    free(pool->prontos);
+    free(pool);
+}
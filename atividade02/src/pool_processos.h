@@ -0,0 +1,72 @@
+/*
+ * Instituição: Universidade Federal da Paraíba
+ * Disciplina: Sistemas Operacionais I
+ * Unidade 1 - Atividade 2
+ *
+ * Autor: Rodrigo Monteiro Fortes de Oliveira, 20240097664
+ *
+ * Nome do Módulo: pool_processos.h
+ *
+ * Descrição:
+ *     Conjunto de processos trabalhadores criados uma única vez com
+ *     fork(). Os trabalhadores recebem descritores de trabalho
+ *     (deslocamento e tamanho dentro de um vetor em memória
+ *     compartilhada) por um pipe em modo pacote e devolvem média,
+ *     mediana e desvio padrão por outro pipe. O custo de fork,
+ *     cópia de tabelas de páginas e waitpid deixa de ser pago a cada
+ *     conjunto de dados.
+ */
+
+#ifndef POOL_PROCESSOS_H
+#define POOL_PROCESSOS_H
+
+#include <stddef.h>
+#include "estatisticas.h"
+#include "afinidade.h"
+
+// Trabalho: um conjunto de dados dentro do vetor compartilhado
+typedef struct {
+    size_t id;
+    size_t deslocamento;
+    size_t tamanho;
+} DescritorTrabalho;
+
+// Resultado de um trabalho
+typedef struct {
+    size_t id;
+    double media;
+    double mediana;
+    double desvio;
+} ResultadoTrabalho;
+
+// Área compartilhada (MAP_SHARED) com um slot por trabalho, onde cada
+// trabalhador grava o esboço serializado do seu conjunto
+typedef struct {
+    void *area;
+    size_t bytes_slot;
+    int precisao;      // k dos esboços
+} AreaEsbocos;
+
+typedef struct PoolProcessos PoolProcessos;
+
+// Cria n_processos trabalhadores. 'dados' (valores do tipo 'tipo') deve
+// estar mapeado com MAP_SHARED (ou ser somente leitura) antes da chamada.
+// 'esbocos' pode ser NULL quando não se pedem quantis. O trabalhador i
+// se fixa na CPU do trabalhador i de 'afinidade' (NULL: sem fixar).
+PoolProcessos* pool_processos_criar(int n_processos, const void *dados, TipoElemento tipo,
+                                    Dominio dominio, const AreaEsbocos *esbocos,
+                                    const Afinidade *afinidade);
+
+// Envia um trabalho para a fila; retorna 0 em caso de sucesso
+int pool_processos_submeter(PoolProcessos *pool, const DescritorTrabalho *trabalho);
+
+// Recebe o próximo resultado disponível; retorna 0 em caso de sucesso
+int pool_processos_receber(PoolProcessos *pool, ResultadoTrabalho *resultado);
+
+// Trabalhos que podem ficar em andamento sem bloquear a fila
+int pool_processos_janela(const PoolProcessos *pool);
+
+// Fecha a fila, espera os trabalhadores terminarem e libera o pool
+void pool_processos_destruir(PoolProcessos *pool);
+
+#endif
@@ -0,0 +1,191 @@
+/*
+ * Instituição: Universidade Federal da Paraíba
+ * Disciplina: Sistemas Operacionais I
+ * Unidade 1 - Atividade 2
+ *
+ * Autor: Rodrigo Monteiro Fortes de Oliveira, 20240097664
+ *
+ * Nome do Módulo: pool_threads.c
+ *
+ * Descrição:
+ *     Implementação do pool de threads declarado em pool_threads.h.
+ *     A fila de tarefas é um vetor circular que cresce quando enche,
+ *     protegido por um mutex e duas variáveis de condição.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include "pool_threads.h"
+#include "rastro.h"
+
+#define FILA_CAPACIDADE_INICIAL 64
+
+typedef struct {
+    FuncaoTarefa funcao;
+    void *arg;
+} Tarefa;
+
+struct PoolThreads {
+    pthread_t *threads;
+    int n_threads;
+    
+    // Fila circular de tarefas pendentes
+    Tarefa *fila;
+    size_t capacidade;
+    size_t inicio;
+    size_t quantidade;
+    
+    // Tarefas submetidas que ainda não terminaram (na fila ou executando)
+    size_t pendentes;
+    int encerrando;
+    
+    pthread_mutex_t mutex;
+    pthread_cond_t tem_tarefa;     // sinaliza as trabalhadoras
+    pthread_cond_t tudo_pronto;    // sinaliza quem espera em pool_aguardar
+};
+
+// Laço das threads trabalhadoras
+static void* trabalhadora(void *arg) {
+    PoolThreads *pool = (PoolThreads*)arg;
+    rastro_nomear("pool");
+    
+    pthread_mutex_lock(&pool->mutex);
+    for (;;) {
+        while (pool->quantidade == 0 && !pool->encerrando) {
+            pthread_cond_wait(&pool->tem_tarefa, &pool->mutex);
+        }
+    
+        if (pool->quantidade == 0 && pool->encerrando) {
+            break;
+        }
+    
+        // Retira a tarefa do início da fila
+        Tarefa tarefa = pool->fila[pool->inicio];
+        pool->inicio = (pool->inicio + 1) % pool->capacidade;
+        pool->quantidade--;
+    
+        // Executa fora da região crítica
+        pthread_mutex_unlock(&pool->mutex);
+        tarefa.funcao(tarefa.arg);
+        pthread_mutex_lock(&pool->mutex);
+    
+        pool->pendentes--;
+        if (pool->pendentes == 0) {
+            pthread_cond_broadcast(&pool->tudo_pronto);
+        }
+    }
+    pthread_mutex_unlock(&pool->mutex);
+    
+    return NULL;
+}
+
+PoolThreads* pool_criar(int n_threads, const Afinidade *afinidade) {
+    PoolThreads *pool = (PoolThreads*)calloc(1, sizeof(PoolThreads));
+    if (pool == NULL) {
+        fprintf(stderr, "Erro ao alocar memória para o pool\n");
+        return NULL;
+    }
+    
+    pool->threads = (pthread_t*)malloc(n_threads * sizeof(pthread_t));
+    pool->fila = (Tarefa*)malloc(FILA_CAPACIDADE_INICIAL * sizeof(Tarefa));
+    if (pool->threads == NULL || pool->fila == NULL) {
+        fprintf(stderr, "Erro ao alocar memória para o pool\n");
+        free(pool->threads);
+        free(pool->fila);
+        free(pool);
+        return NULL;
+    }
+    pool->capacidade = FILA_CAPACIDADE_INICIAL;
+    
+    pthread_mutex_init(&pool->mutex, NULL);
+    pthread_cond_init(&pool->tem_tarefa, NULL);
+    pthread_cond_init(&pool->tudo_pronto, NULL);
+    
+    // Cria as trabalhadoras (custo pago uma única vez)
+    for (int i = 0; i < n_threads; i++) {
+        pthread_attr_t atributos;
+        pthread_attr_init(&atributos);
+        afinidade_atributos(afinidade, i, &atributos);
+        int ret = pthread_create(&pool->threads[i], &atributos, trabalhadora, pool);
+        pthread_attr_destroy(&atributos);
+        if (ret != 0) {
+            fprintf(stderr, "Erro ao criar thread do pool: %d\n", ret);
+            pool_destruir(pool);
+            return NULL;
+        }
+        pool->n_threads++;
+    }
+    
+    return pool;
+}
+
+// Dobra a capacidade da fila, desenrolando o vetor circular
+static int fila_crescer(PoolThreads *pool) {
+    size_t nova_capacidade = pool->capacidade * 2;
+    Tarefa *nova = (Tarefa*)malloc(nova_capacidade * sizeof(Tarefa));
+    if (nova == NULL) {
+        return -1;
+    }
+    
+    for (size_t i = 0; i < pool->quantidade; i++) {
+        nova[i] = pool->fila[(pool->inicio + i) % pool->capacidade];
+    }
+    
+    free(pool->fila);
+    pool->fila = nova;
+    pool->capacidade = nova_capacidade;
+    pool->inicio = 0;
+    return 0;
+}
+
+int pool_submeter(PoolThreads *pool, FuncaoTarefa funcao, void *arg) {
+    pthread_mutex_lock(&pool->mutex);
+    
+    if (pool->quantidade == pool->capacidade && fila_crescer(pool) != 0) {
+        pthread_mutex_unlock(&pool->mutex);
+        fprintf(stderr, "Erro ao aumentar a fila de tarefas\n");
+        return -1;
+    }
+    
+    size_t fim = (pool->inicio + pool->quantidade) % pool->capacidade;
+    pool->fila[fim].funcao = funcao;
+    pool->fila[fim].arg = arg;
+    pool->quantidade++;
+    pool->pendentes++;
+    
+    pthread_cond_signal(&pool->tem_tarefa);
+    pthread_mutex_unlock(&pool->mutex);
+    return 0;
+}
+
+void pool_aguardar(PoolThreads *pool) {
+    pthread_mutex_lock(&pool->mutex);
+    while (pool->pendentes > 0) {
+        pthread_cond_wait(&pool->tudo_pronto, &pool->mutex);
+    }
+    pthread_mutex_unlock(&pool->mutex);
+}
+
+void pool_destruir(PoolThreads *pool) {
+    // Acorda todas as trabalhadoras para que percebam o encerramento
+    pthread_mutex_lock(&pool->mutex);
+    pool->encerrando = 1;
+    pthread_cond_broadcast(&pool->tem_tarefa);
+    pthread_mutex_unlock(&pool->mutex);
+    
+    for (int i = 0; i < pool->n_threads; i++) {
+        pthread_join(pool->threads[i], NULL);
+    }
+    
+    pthread_mutex_destroy(&pool->mutex);
+    pthread_cond_destroy(&pool->tem_tarefa);
+    pthread_cond_destroy(&pool->tudo_pronto);
+    free(pool->threads);
+    free(pool->fila);
+    free(pool);
+}
+
+int pool_tamanho(const PoolThreads *pool) {
+    return pool->n_threads;
+}
@@ -0,0 +1,43 @@
+/*
+ * Instituição: Universidade Federal da Paraíba
+ * Disciplina: Sistemas Operacionais I
+ * Unidade 1 - Atividade 2
+ *
+ * Autor: Rodrigo Monteiro Fortes de Oliveira, 20240097664
+ *
+ * Nome do Módulo: pool_threads.h
+ *
+ * Descrição:
+ *     Conjunto fixo de threads trabalhadoras reutilizáveis. As threads
+ *     são criadas uma única vez e ficam à espera de tarefas em uma fila;
+ *     quem usa o pool submete tarefas e aguarda que todas terminem, sem
+ *     pagar a criação de threads a cada conjunto de dados.
+ */
+
+#ifndef POOL_THREADS_H
+#define POOL_THREADS_H
+
+#include "afinidade.h"
+
+// Tarefa: mesma assinatura de uma função de thread do pthread_create
+typedef void* (*FuncaoTarefa)(void *arg);
+
+typedef struct PoolThreads PoolThreads;
+
+// Cria o pool com n_threads trabalhadoras, a i-ésima fixada na CPU do
+// trabalhador i de 'afinidade' (NULL: sem fixar); retorna NULL em caso de erro
+PoolThreads* pool_criar(int n_threads, const Afinidade *afinidade);
+
+// Coloca uma tarefa na fila; retorna 0 em caso de sucesso
+int pool_submeter(PoolThreads *pool, FuncaoTarefa funcao, void *arg);
+
+// Bloqueia até que todas as tarefas submetidas tenham terminado
+void pool_aguardar(PoolThreads *pool);
+
+// Encerra as trabalhadoras (após esvaziar a fila) e libera o pool
+void pool_destruir(PoolThreads *pool);
+
+// Quantidade de threads trabalhadoras do pool
+int pool_tamanho(const PoolThreads *pool);
+
+#endif
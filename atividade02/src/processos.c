@@ -8,26 +8,116 @@
  * Nome do Programa: processos.c
  *
  * Descrição:
- *     Gera 10.000 números aleatórios entre 0 e 100 e calcula média,
+ *     Gera N números aleatórios (padrão: 10.000 entre 0 e 100) e calcula média,
  *     mediana e desvio padrão usando três processos criados com fork().
  *     Cada processo faz um cálculo e envia o resultado para o processo
  *     pai através de pipes. Mede tempo de criação dos processos e
  *     tempo total de execução.
+ *
+ *     Com a opção -s os dados e os resultados passam por uma região de
+ *     memória compartilhada (memfd + mmap MAP_SHARED): os filhos leem
+ *     o vetor sem cópia, gravam o resultado em um slot próprio e
+ *     avisam o pai por um eventfd, com uma chamada de sistema por filho.
+ *
+ *     Com a opção -P N os cálculos são feitos por um pool de N processos
+ *     criados uma única vez, que recebem trabalhos por uma fila; com
+ *     -b L são gerados L conjuntos de dados (modo em lote) e o programa
+ *     informa a vazão em conjuntos e valores por segundo.
+ *
+ *     Com -f os valores vêm de um arquivo binário gerado pelo converter,
+ *     mapeado somente leitura com MAP_SHARED: os filhos e os
+ *     trabalhadores do pool herdam o mapeamento, sem cópia. No modo em
+ *     lote o arquivo é dividido em L conjuntos de tamanho igual.
+ *
+ *     Os dados sintéticos são gerados pelo pai antes dos fork() com o
+ *     gerador paralelo de gerador.c; -S fixa a semente.
+ *
+ *     No modo com pool, -q lista (ex.: -q 0.5,0.9,0.99,0.999) exibe
+ *     quantis de todos os conjuntos juntos: cada trabalhador grava um
+ *     esboço KLL de precisão -K (padrão: 200) do seu conjunto em um
+ *     slot compartilhado e o pai combina os esboços, sem receber os
+ *     valores de volta.
+ *
+ *     Os valores gerados são guardados no menor tipo que cabe no
+ *     intervalo (uint8 para 0 a 100), o que também reduz a região
+ *     compartilhada; -w mantém int32, para comparar.
+ *
+ *     Cada filho dos três cálculos tem um canal próprio (um pipe, ou o
+ *     slot da região no modo -s) e um pidfd. O pai recebe os resultados
+ *     com um epoll, na ordem em que chegarem: acumula leituras parciais,
+ *     trata o fim de arquivo e percebe pelo pidfd o filho que terminou
+ *     sem entregar o resultado. Esse cálculo é redisparado em um filho
+ *     novo, até três tentativas; com -T prazo (ms) o filho que passar do
+ *     prazo é encerrado com SIGKILL e também redisparado.
+ *
+ *     Com -A política (compacto, espalhado ou lista de CPUs, ver
+ *     afinidade.h) o filho i, ou o trabalhador i do pool, se fixa com
+ *     sched_setaffinity na CPU do trabalhador i logo após o fork(). O
+ *     primeiro toque por trabalhador (como no threads -d) não se aplica:
+ *     os três filhos leem o vetor inteiro, os conjuntos do pool vão para
+ *     o trabalhador que estiver livre e as páginas de -f ficam no cache
+ *     de páginas do núcleo.
+ *
+ *     Com ESTATISTICAS_CONTADORES=1 no ambiente são exibidos contadores
+ *     de desempenho por fase (ver contadores.h). O cálculo feito em cada
+ *     filho é somado quando ele termina, ou seja, no transporte ou na
+ *     espera; no modo com pool, no encerramento do pool.
+ *     Com ESTATISTICAS_RASTRO=arquivo.json é gravada a linha do tempo
+ *     (rastro.h): fork, cálculo, envio e coleta de cada filho e as fases.
+ *     ESTATISTICAS_LATENCIA=1 (ou fifo) liga o modo de latência
+ *     (latencia.h) no pai. As travas de memória não passam pelo fork():
+ *     os trabalhadores do pool travam a própria memória ao começar,
+ *     fora dos trabalhos; os três filhos não, pois travar quebraria o
+ *     compartilhamento copy-on-write do vetor dentro da medição.
+ *
+ * Compilação:
+ *     gcc -O2 -pthread processos.c estatisticas.c simd.c selecao.c esboco.c vetor.c dados.c gerador.c contadores.c rastro.c afinidade.c latencia.c pool_processos.c -o processos -lm
  */
 
+#define _GNU_SOURCE
 #include <stdio.h>
 #include <stdlib.h>
-#include <math.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
 #include <unistd.h>
 #include <sys/wait.h>
 #include <sys/types.h>
+#include <sys/mman.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/syscall.h>
 #include <time.h>
-#include <sys/time.h>
+#include "estatisticas.h"
+#include "esboco.h"
+#include "vetor.h"
+#include "dados.h"
+#include "gerador.h"
+#include "tempo.h"
+#include "pool_processos.h"
+#include "contadores.h"
+#include "rastro.h"
+#include "afinidade.h"
+#include "latencia.h"
 
 #define N_ENTRADAS 10000
 #define MIN_VALOR 0
 #define MAX_VALOR 100
 
+// Tentativas de cada cálculo (a primeira e os redisparos)
+#define MAX_TENTATIVAS 3
+
+#ifndef P_PIDFD
+#define P_PIDFD 3
+#endif
+
+// Tipos de evento do coletor (bits baixos do dado do epoll)
+#define EVENTO_CANAL 0
+#define EVENTO_PROCESSO 1
+#define EVENTO_AVISO 2
+
 // Identificadores dos tipos de resultados
 typedef enum {
     RESULTADO_MEDIA = 1,
@@ -35,252 +125,864 @@ typedef enum {
     RESULTADO_DESVIO = 3
 } TipoResultado;
 
-// Vetor global compartilhado (herdado pelos processos filhos via fork)
-int valores[N_ENTRADAS];
+// Mensagem de um filho no modo com pipe: tipo e valor em uma única escrita
+typedef struct {
+    TipoResultado tipo;
+    double valor;
+} MensagemResultado;
+
+// Um dos três cálculos, do ponto de vista do coletor do pai
+typedef struct {
+    pid_t pid;                     // filho da tentativa atual (0: já coletado)
+    int pidfd;
+    int canal_fd;                  // leitura do pipe próprio (-1: modo -s ou fim)
+    MensagemResultado mensagem;    // acumulada entre leituras parciais
+    size_t bytes_recebidos;
+    int recebido;
+    int tentativas;
+    int expirou;                   // tentativa atual encerrada pelo prazo
+    struct timespec inicio;        // da tentativa atual, para o prazo
+} Calculo;
 
-// Compara dois inteiros (usado pelo qsort)
-int comparar(const void *a, const void *b) {
-    int int_a = *((int*)a);
-    int int_b = *((int*)b);
+// Slot de resultado de um filho, em linha de cache própria
+typedef struct {
+    double valor;
+    int pronto;
+} __attribute__((aligned(LINHA_CACHE))) SlotResultado;
+
+// Região compartilhada entre pai e filhos no modo -s
+typedef struct {
+    SlotResultado resultados[3];   // indexado por TipoResultado - 1
+    size_t tamanho;
+    TipoElemento tipo;
+    unsigned char valores[];       // dados de entrada, gravados pelo pai
+} RegiaoCompartilhada;
+
+// Vetor de entrada (herdado pelos processos filhos via fork).
+// No modo -s aponta para dentro da região compartilhada.
+void *valores = NULL;
+TipoElemento tipo_elemento = ELEMENTO_INT32;
+size_t n_entradas = N_ENTRADAS;
+
+// Intervalo dos valores (opção -v)
+Dominio dominio = { MIN_VALOR, MAX_VALOR };
+
+// Posicionamento dos filhos nas CPUs (opção -A)
+Afinidade afinidade = AFINIDADE_NENHUMA;
+
+// Semente do gerador (opção -S)
+uint64_t semente = 0;
+
+// Prazo de cada tentativa de um cálculo em ms (opção -T; 0: sem prazo)
+double prazo_ms = 0;
+
+// Quantis pedidos (opção -q) e precisão dos esboços (opção -K)
+Quantis quantis = { 0 };
+int precisao_esboco = ESBOCO_K_PADRAO;
+
+// Região e eventfd do modo -s (NULL / -1 no modo com pipe)
+RegiaoCompartilhada *regiao = NULL;
+int evento_fd = -1;
+
+// Cria a região compartilhada com espaço para 'tamanho' valores do tipo 'tipo'
+RegiaoCompartilhada* criar_regiao(size_t tamanho, TipoElemento tipo, int paginas_enormes) {
+    size_t bytes = sizeof(RegiaoCompartilhada) + tamanho * elemento_bytes(tipo);
+    
+    int fd = memfd_create("processos_dados", MFD_CLOEXEC);
+    if (fd == -1) {
+        perror("Erro ao criar memfd");
+        return NULL;
+    }
     
-    if (int_a < int_b) return -1;
-    if (int_a > int_b) return 1;
+    if (ftruncate(fd, bytes) == -1) {
+        perror("Erro ao dimensionar memfd");
+        close(fd);
+        return NULL;
+    }
+    
+    void *endereco = mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (endereco == MAP_FAILED) {
+        perror("Erro ao mapear memfd");
+        return NULL;
+    }
+    
+    // Páginas enormes em memória compartilhada dependem de shmem_enabled
+    if (paginas_enormes && madvise(endereco, bytes, MADV_HUGEPAGE) == -1) {
+        perror("Aviso: páginas enormes indisponíveis");
+    }
+    
+    // A memória de um memfd recém-criado já vem zerada
+    RegiaoCompartilhada *nova = (RegiaoCompartilhada*)endereco;
+    nova->tamanho = tamanho;
+    nova->tipo = tipo;
+    return nova;
+}
+
+// Escreve exatamente 'bytes' bytes, repetindo em escritas parciais
+int escrever_completo(int fd, const void *buffer, size_t bytes) {
+    const char *origem = (const char*)buffer;
+    while (bytes > 0) {
+        ssize_t escritos = write(fd, origem, bytes);
+        if (escritos == -1) {
+            if (errno == EINTR) continue;
+            return -1;
+        }
+        origem += escritos;
+        bytes -= escritos;
+    }
     return 0;
 }
 
+// Lê exatamente 'bytes' bytes; retorna 0 em fim de arquivo antes disso
+int ler_completo(int fd, void *buffer, size_t bytes) {
+    char *destino = (char*)buffer;
+    while (bytes > 0) {
+        ssize_t lidos = read(fd, destino, bytes);
+        if (lidos == -1) {
+            if (errno == EINTR) continue;
+            return -1;
+        }
+        if (lidos == 0) return 0;
+        destino += lidos;
+        bytes -= lidos;
+    }
+    return 1;
+}
+
+// Entrega o resultado ao pai (pipe ou região compartilhada) e encerra o filho
+void enviar_resultado(int write_fd, TipoResultado tipo, double valor) {
+    if (regiao != NULL) {
+        // Grava no slot e só então marca como pronto
+        SlotResultado *slot = &regiao->resultados[tipo - 1];
+        slot->valor = valor;
+        __atomic_store_n(&slot->pronto, 1, __ATOMIC_RELEASE);
+    
+        // Um único aviso por filho
+        uint64_t um = 1;
+        if (escrever_completo(evento_fd, &um, sizeof(um)) == -1) {
+            perror("Erro ao sinalizar eventfd");
+            _exit(EXIT_FAILURE);
+        }
+        rastro_marcar("enviado", tipo);
+        _exit(EXIT_SUCCESS);
+    }
+    
+    // Tipo e valor seguem juntos em uma única escrita (atômica no pipe)
+    MensagemResultado mensagem = { tipo, valor };
+    
+    if (escrever_completo(write_fd, &mensagem, sizeof(mensagem)) == -1) {
+        perror("Erro ao escrever resultado no pipe");
+        _exit(EXIT_FAILURE);
+    }
+    rastro_marcar("enviado", tipo);
+    
+    _exit(EXIT_SUCCESS);
+}
+
 // Processo filho que calcula a média
 void calcular_media(int write_fd) {
-    long long soma = 0;
+    rastro_nomear("media");
+    rastro_comecar("media");
     
-    // Soma todos os valores
-    for (int i = 0; i < N_ENTRADAS; i++) {
-        soma += valores[i];
-    }
+    // Só os momentos interessam: dispensa o histograma
+    Resumo resumo;
+    resumo_iniciar(&resumo, DOMINIO_ILIMITADO);
+    resumo_acumular_elementos(&resumo, valores, tipo_elemento, n_entradas);
     
     // Calcula a média
-    double media = (double)soma / N_ENTRADAS;
+    double media = resumo_media(&resumo);
+    rastro_terminar("media");
     
-    // Envia o resultado pelo pipe
-    TipoResultado tipo = RESULTADO_MEDIA;
-    if (write(write_fd, &tipo, sizeof(TipoResultado)) == -1) {
-        perror("Erro ao escrever tipo no pipe");
-        _exit(EXIT_FAILURE);
+    enviar_resultado(write_fd, RESULTADO_MEDIA, media);
+}
+
+// Processo filho que calcula a mediana
+void calcular_mediana(int write_fd) {
+    rastro_nomear("mediana");
+    rastro_comecar("mediana");
+    
+    // Conta os valores no histograma do domínio (sem cópia nem ordenação)
+    Resumo resumo;
+    resumo_iniciar(&resumo, dominio);
+    resumo_acumular_elementos(&resumo, valores, tipo_elemento, n_entradas);
+    double mediana = resumo_mediana_elementos(&resumo, valores, tipo_elemento, n_entradas);
+    resumo_liberar(&resumo);
+    rastro_terminar("mediana");
+    
+    enviar_resultado(write_fd, RESULTADO_MEDIANA, mediana);
+}
+
+// Processo filho que calcula o desvio padrão
+void calcular_desvio_padrao(int write_fd) {
+    rastro_nomear("desvio");
+    rastro_comecar("desvio");
+    
+    // Soma e soma dos quadrados na mesma passada (sem recalcular a média)
+    Resumo resumo;
+    resumo_iniciar(&resumo, DOMINIO_ILIMITADO);
+    resumo_acumular_elementos(&resumo, valores, tipo_elemento, n_entradas);
+    
+    // Calcula o desvio padrão
+    double desvio = resumo_desvio_padrao(&resumo);
+    rastro_terminar("desvio");
+    
+    enviar_resultado(write_fd, RESULTADO_DESVIO, desvio);
+}
+
+// Guarda o valor recebido na variável correspondente ao tipo
+void registrar_resultado(TipoResultado tipo, double valor, double *media,
+                         double *mediana, double *desvio) {
+    switch (tipo) {
+        case RESULTADO_MEDIA:
+            *media = valor;
+            break;
+        case RESULTADO_MEDIANA:
+            *mediana = valor;
+            break;
+        case RESULTADO_DESVIO:
+            *desvio = valor;
+            break;
+    }
+}
+
+// Funções e nomes dos três cálculos, na ordem de TipoResultado
+void (*const CALCULOS[3])(int) = { calcular_media, calcular_mediana, calcular_desvio_padrao };
+const char *const NOMES_CALCULOS[3] = { "média", "mediana", "desvio padrão" };
+
+// Registra um descritor no epoll do coletor com o cálculo e o tipo de evento
+int observar(int epoll_fd, int fd, int i, int tipo) {
+    struct epoll_event evento;
+    evento.events = EPOLLIN;
+    evento.data.u64 = ((uint64_t)i << 2) | tipo;
+    return epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &evento);
+}
+
+// Cria o filho do cálculo i, com um pipe próprio no modo com pipe, e
+// registra o pipe e o pidfd dele no coletor; retorna 0 em caso de sucesso
+int disparar_calculo(int epoll_fd, Calculo *calculos, int i) {
+    Calculo *calculo = &calculos[i];
+    int canal[2] = { -1, -1 };
+    if (regiao == NULL && pipe(canal) == -1) {
+        perror("Erro ao criar pipe");
+        return -1;
     }
     
-    if (write(write_fd, &media, sizeof(double)) == -1) {
-        perror("Erro ao escrever média no pipe");
-        _exit(EXIT_FAILURE);
+    pid_t pid = fork();
+    if (pid == 0) {
+        // Processo filho: fecha o lado de leitura do pipe
+        if (canal[0] != -1) close(canal[0]);
+        afinidade_fixar(&afinidade, i);
+        CALCULOS[i](canal[1]);
+    } else if (pid < 0) {
+        fprintf(stderr, "Erro ao criar fork para %s: %s\n", NOMES_CALCULOS[i], strerror(errno));
+        if (canal[0] != -1) {
+            close(canal[0]);
+            close(canal[1]);
+        }
+        return -1;
+    }
+    rastro_marcar("fork", pid);
+    
+    // Pai: fecha a escrita; só o filho a mantém, então o fim de arquivo
+    // no pipe indica que ele não escreverá mais
+    if (canal[1] != -1) close(canal[1]);
+    calculo->pid = pid;
+    calculo->canal_fd = canal[0];
+    calculo->bytes_recebidos = 0;
+    calculo->expirou = 0;
+    calculo->tentativas++;
+    marcar_instante(&calculo->inicio);
+    
+    calculo->pidfd = (int)syscall(SYS_pidfd_open, pid, 0);
+    if (calculo->pidfd == -1 || observar(epoll_fd, calculo->pidfd, i, EVENTO_PROCESSO) == -1) {
+        perror("Erro ao acompanhar o filho");
+        return -1;
+    }
+    if (canal[0] != -1) {
+        fcntl(canal[0], F_SETFL, O_NONBLOCK);
+        if (observar(epoll_fd, canal[0], i, EVENTO_CANAL) == -1) {
+            perror("Erro ao acompanhar o pipe do filho");
+            return -1;
+        }
     }
+    return 0;
+}
+
+// Fecha o pipe do cálculo (fim de arquivo, mensagem completa ou falha)
+void fechar_canal(int epoll_fd, Calculo *calculo) {
+    if (calculo->canal_fd == -1) return;
+    epoll_ctl(epoll_fd, EPOLL_CTL_DEL, calculo->canal_fd, NULL);
+    close(calculo->canal_fd);
+    calculo->canal_fd = -1;
+}
+
+// Lê o que houver no pipe, acumulando leituras parciais até completar a mensagem
+void ler_canal(int epoll_fd, Calculo *calculo) {
+    while (calculo->canal_fd != -1 && !calculo->recebido) {
+        char *destino = (char*)&calculo->mensagem + calculo->bytes_recebidos;
+        ssize_t lidos = read(calculo->canal_fd, destino,
+                             sizeof(MensagemResultado) - calculo->bytes_recebidos);
+        if (lidos > 0) {
+            calculo->bytes_recebidos += lidos;
+            calculo->recebido = calculo->bytes_recebidos == sizeof(MensagemResultado);
+            continue;
+        }
+        if (lidos == -1 && errno == EINTR) continue;
+        if (lidos == -1 && errno == EAGAIN) return;
     
-    _exit(EXIT_SUCCESS);
+        // Fim de arquivo (ou erro) antes da mensagem completa
+        break;
+    }
+    fechar_canal(epoll_fd, calculo);
 }
 
-// Processo filho que calcula a mediana
-void calcular_mediana(int write_fd) {
-    // Copia o vetor para não alterar o original
-    int *copia = (int*)malloc(N_ENTRADAS * sizeof(int));
-    if (copia == NULL) {
-        fprintf(stderr, "Erro ao alocar memória para cópia do vetor\n");
-        _exit(EXIT_FAILURE);
+// Modo -s: consulta o slot do cálculo i na região compartilhada
+void verificar_slot(Calculo *calculos, int i) {
+    SlotResultado *slot = &regiao->resultados[i];
+    if (!calculos[i].recebido && __atomic_load_n(&slot->pronto, __ATOMIC_ACQUIRE)) {
+        calculos[i].mensagem.tipo = (TipoResultado)(i + 1);
+        calculos[i].mensagem.valor = slot->valor;
+        calculos[i].recebido = 1;
     }
+}
+
+// Coleta o filho do cálculo pelo pidfd (bloqueia se ele ainda não terminou)
+void coletar_filho(int epoll_fd, Calculo *calculo) {
+    epoll_ctl(epoll_fd, EPOLL_CTL_DEL, calculo->pidfd, NULL);
     
-    for (int i = 0; i < N_ENTRADAS; i++) {
-        copia[i] = valores[i];
+    siginfo_t informacao;
+    while (waitid((idtype_t)P_PIDFD, (id_t)calculo->pidfd, &informacao, WEXITED) == -1 &&
+           errno == EINTR) {
     }
+    close(calculo->pidfd);
+    rastro_marcar("coletado", calculo->pid);
+    calculo->pid = 0;
+}
+
+// Recebe os resultados com um epoll sobre os pipes (ou o eventfd) e os
+// pidfds dos filhos, na ordem em que chegarem. Um filho que termina sem
+// entregar o resultado, ou que estoura o prazo (-T) e é encerrado, tem o
+// cálculo redisparado, até MAX_TENTATIVAS tentativas. Retorna quantos
+// resultados chegaram e soma os redisparos em 'redisparos'.
+int coletar_resultados(int epoll_fd, Calculo *calculos, int *redisparos) {
+    int recebidos = 0;
+    int desistiu = 0;
+    while (recebidos < 3 && !desistiu) {
+        // Prazo: encerra quem passou dele e dorme até o próximo
+        int espera = -1;
+        if (prazo_ms > 0) {
+            struct timespec agora;
+            marcar_instante(&agora);
+            for (int i = 0; i < 3; i++) {
+                Calculo *calculo = &calculos[i];
+                if (calculo->recebido || calculo->pid == 0 || calculo->expirou) continue;
+    
+                double restante = prazo_ms - diferenca_ms(calculo->inicio, agora);
+                if (restante <= 0) {
+                    // Pelo pidfd: o término chega como evento do processo
+                    syscall(SYS_pidfd_send_signal, calculo->pidfd, SIGKILL, NULL, 0);
+                    calculo->expirou = 1;
+                } else if (espera < 0 || restante + 1 < espera) {
+                    espera = (int)restante + 1;
+                }
+            }
+        }
     
-    // Ordena o vetor
-    qsort(copia, N_ENTRADAS, sizeof(int), comparar);
+        struct epoll_event eventos[8];
+        int n = epoll_wait(epoll_fd, eventos, 8, espera);
+        if (n == -1) {
+            if (errno == EINTR) continue;
+            perror("Erro ao aguardar os resultados");
+            break;
+        }
+    
+        for (int e = 0; e < n; e++) {
+            int i = (int)(eventos[e].data.u64 >> 2);
+            int tipo = (int)(eventos[e].data.u64 & 3);
+            Calculo *calculo = &calculos[i];
+    
+            if (tipo == EVENTO_CANAL) {
+                ler_canal(epoll_fd, calculo);
+            } else if (tipo == EVENTO_AVISO) {
+                // O eventfd acumula os avisos; os slots dizem de quem são
+                uint64_t avisos;
+                if (ler_completo(evento_fd, &avisos, sizeof(avisos)) != 1) {
+                    perror("Erro ao ler eventfd");
+                }
+                for (int j = 0; j < 3; j++) {
+                    verificar_slot(calculos, j);
+                }
+            } else if (calculo->pid != 0) {
+                // O filho terminou: o que ele enviou antes já está no pipe ou no slot
+                ler_canal(epoll_fd, calculo);
+                if (regiao != NULL) verificar_slot(calculos, i);
+                coletar_filho(epoll_fd, calculo);
+    
+                if (!calculo->recebido) {
+                    fechar_canal(epoll_fd, calculo);
+                    fprintf(stderr, "Aviso: o filho (%s) terminou sem resultado%s (tentativa %d de %d)\n",
+                            NOMES_CALCULOS[i], calculo->expirou ? ", prazo esgotado" : "",
+                            calculo->tentativas, MAX_TENTATIVAS);
+                    if (calculo->tentativas < MAX_TENTATIVAS &&
+                        disparar_calculo(epoll_fd, calculos, i) == 0) {
+                        (*redisparos)++;
+                    } else {
+                        desistiu = 1;
+                    }
+                }
+            }
+        }
+    
+        recebidos = 0;
+        for (int i = 0; i < 3; i++) {
+            recebidos += calculos[i].recebido;
+        }
+    }
     
-    double mediana;
-    if (N_ENTRADAS % 2 == 0) {
-        // Par: média dos dois do meio
-        mediana = (copia[N_ENTRADAS/2] + copia[N_ENTRADAS/2 - 1]) / 2.0;
+    return recebidos;
+}
+
+// Processa n_conjuntos conjuntos de n_entradas valores com um pool de processos.
+// 'vetor' já mapeado (opção -f) fornece os conjuntos em vez da geração aleatória.
+int executar_pool(int n_processos, int n_conjuntos, int paginas_enormes, Vetor *vetor) {
+    size_t total_valores;
+    if (vetor->valores != NULL) {
+        // Arquivo dividido em conjuntos iguais (o resto fica de fora)
+        n_entradas = vetor->tamanho / n_conjuntos;
+        if (n_entradas == 0) {
+            fprintf(stderr, "Arquivo menor que o número de conjuntos\n");
+            return EXIT_FAILURE;
+        }
+        total_valores = (size_t)n_conjuntos * n_entradas;
+        valores = vetor->valores;
     } else {
-        // Ímpar: elemento do meio
-        mediana = copia[N_ENTRADAS/2];
+        // Todos os conjuntos ficam lado a lado em uma região compartilhada
+        total_valores = (size_t)n_conjuntos * n_entradas;
+        regiao = criar_regiao(total_valores, tipo_elemento, paginas_enormes);
+        if (regiao == NULL) {
+            return EXIT_FAILURE;
+        }
+        valores = regiao->valores;
+    
+        // Preenche em paralelo com valores do intervalo [min, max] (sem viés)
+        contadores_entrar("geracao");
+        if (gerador_preencher(valores, tipo_elemento, total_valores, dominio, semente, 0, NULL) != 0) {
+            return EXIT_FAILURE;
+        }
+        contadores_sair();
     }
     
-    free(copia);
+    // Modo de latência (ESTATISTICAS_LATENCIA), antes de criar o pool
+    latencia_iniciar(valores, total_valores * elemento_bytes(tipo_elemento), 0);
     
-    // Envia o resultado pelo pipe
-    TipoResultado tipo = RESULTADO_MEDIANA;
-    if (write(write_fd, &tipo, sizeof(TipoResultado)) == -1) {
-        perror("Erro ao escrever tipo no pipe");
-        _exit(EXIT_FAILURE);
+    printf("========================================\n");
+    printf("  EXECUÇÃO COM POOL DE %d PROCESSOS\n", n_processos);
+    printf("========================================\n\n");
+    printf("PID do processo pai: %d\n", getpid());
+    printf("Armazenamento: %s, %zu B por valor\n", elemento_nome(tipo_elemento),
+           elemento_bytes(tipo_elemento));
+    afinidade_exibir(&afinidade);
+    latencia_exibir();
+    printf("\n");
+    
+    // Slots dos esboços, herdados pelos trabalhadores no fork
+    AreaEsbocos esbocos = { NULL, 0, precisao_esboco };
+    if (quantis.quantidade > 0) {
+        esbocos.bytes_slot = esboco_bytes_maximos(precisao_esboco);
+        esbocos.area = mmap(NULL, n_conjuntos * esbocos.bytes_slot, PROT_READ | PROT_WRITE,
+                            MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+        if (esbocos.area == MAP_FAILED) {
+            perror("Erro ao mapear área dos esboços");
+            return EXIT_FAILURE;
+        }
     }
     
-    if (write(write_fd, &mediana, sizeof(double)) == -1) {
-        perror("Erro ao escrever mediana no pipe");
-        _exit(EXIT_FAILURE);
+    // Cria o pool uma única vez
+    struct timespec inicio_criacao, fim_criacao;
+    marcar_instante(&inicio_criacao);
+    contadores_entrar("criacao");
+    
+    PoolProcessos *pool = pool_processos_criar(n_processos, valores, tipo_elemento, dominio,
+                                               esbocos.area != NULL ? &esbocos : NULL,
+                                               &afinidade);
+    if (pool == NULL) {
+        return EXIT_FAILURE;
     }
     
-    _exit(EXIT_SUCCESS);
-}
-
-// Processo filho que calcula o desvio padrão
-void calcular_desvio_padrao(int write_fd) {
-    // Calcula a média primeiro (precisa para o desvio)
-    long long soma = 0;
+    marcar_instante(&fim_criacao);
     
-    for (int i = 0; i < N_ENTRADAS; i++) {
-        soma += valores[i];
+    // Resultados, indexados pelo id do trabalho
+    ResultadoTrabalho *resultados = (ResultadoTrabalho*)malloc(n_conjuntos * sizeof(ResultadoTrabalho));
+    if (resultados == NULL) {
+        fprintf(stderr, "Erro ao alocar memória para os resultados\n");
+        pool_processos_destruir(pool);
+        return EXIT_FAILURE;
+    }
+    
+    // Mantém no máximo 'janela' trabalhos em andamento
+    struct timespec inicio_lote, fim_lote;
+    marcar_instante(&inicio_lote);
+    contadores_entrar("lote");
+    
+    int janela = pool_processos_janela(pool);
+    int enviados = 0;
+    int recebidos = 0;
+    int status = EXIT_SUCCESS;
+    while (recebidos < n_conjuntos) {
+        while (enviados < n_conjuntos && enviados - recebidos < janela) {
+            DescritorTrabalho trabalho;
+            trabalho.id = enviados;
+            trabalho.deslocamento = (size_t)enviados * n_entradas;
+            trabalho.tamanho = n_entradas;
+            if (pool_processos_submeter(pool, &trabalho) != 0) {
+                status = EXIT_FAILURE;
+                break;
+            }
+            enviados++;
+        }
+        if (status != EXIT_SUCCESS) {
+            break;
+        }
+    
+        ResultadoTrabalho resultado;
+        if (pool_processos_receber(pool, &resultado) != 0) {
+            status = EXIT_FAILURE;
+            break;
+        }
+        resultados[resultado.id] = resultado;
+        recebidos++;
     }
     
-    double media = (double)soma / N_ENTRADAS;
+    marcar_instante(&fim_lote);
+    
+    contadores_entrar("encerramento");
+    pool_processos_destruir(pool);
+    contadores_sair();
+    
+    // Combina os esboços de todos os conjuntos
+    if (status == EXIT_SUCCESS && esbocos.area != NULL) {
+        contadores_entrar("combinacao");
+        Esboco total, parcial;
+        esboco_iniciar(&total, precisao_esboco);
+        for (int c = 0; c < n_conjuntos && status == EXIT_SUCCESS; c++) {
+            char *slot = (char*)esbocos.area + c * esbocos.bytes_slot;
+            if (esboco_desserializar(&parcial, slot, esbocos.bytes_slot) != 0) {
+                fprintf(stderr, "Esboço inválido no conjunto %d\n", c);
+                status = EXIT_FAILURE;
+                break;
+            }
+            esboco_combinar(&total, &parcial);
+            esboco_liberar(&parcial);
+        }
+        for (int i = 0; i < quantis.quantidade; i++) {
+            quantis.valor[i] = esboco_quantil(&total, quantis.q[i]);
+        }
+        quantis.aproximado = 1;
+        esboco_liberar(&total);
+        contadores_sair();
+    }
     
-    // Soma dos quadrados das diferenças
-    double soma_quadrados = 0.0;
+    struct timespec fim_total;
+    marcar_instante(&fim_total);
     
-    for (int i = 0; i < N_ENTRADAS; i++) {
-        double diferenca = valores[i] - media;
-        soma_quadrados += diferenca * diferenca;
+    if (esbocos.area != NULL) {
+        munmap(esbocos.area, n_conjuntos * esbocos.bytes_slot);
+    }
+    if (status != EXIT_SUCCESS) {
+        free(resultados);
+        return status;
     }
     
-    // Calcula o desvio padrão
-    double variancia = soma_quadrados / N_ENTRADAS;
-    double desvio = sqrt(variancia);
+    double tempo_criacao = diferenca_ms(inicio_criacao, fim_criacao);
+    double tempo_lote = diferenca_ms(inicio_lote, fim_lote);
+    double tempo_total = diferenca_ms(inicio_criacao, fim_total);
     
-    // Envia o resultado pelo pipe
-    TipoResultado tipo = RESULTADO_DESVIO;
-    if (write(write_fd, &tipo, sizeof(TipoResultado)) == -1) {
-        perror("Erro ao escrever tipo no pipe");
-        _exit(EXIT_FAILURE);
+    // Exibe resultados estatísticos (do primeiro conjunto)
+    printf("--- RESULTADOS ESTATÍSTICOS ---\n");
+    printf("Conjuntos processados: %d\n", n_conjuntos);
+    printf("Quantidade de valores por conjunto: %zu\n", n_entradas);
+    if (regiao != NULL) {
+        printf("Semente do gerador: %llu\n", (unsigned long long)semente);
+    }
+    printf("Média aritmética (conjunto 0): %.6f\n", resultados[0].media);
+    printf("Mediana (conjunto 0): %.6f\n", resultados[0].mediana);
+    printf("Desvio padrão populacional (conjunto 0): %.6f\n", resultados[0].desvio);
+    if (quantis.quantidade > 0) {
+        printf("Quantis de todos os conjuntos (%zu valores):\n", total_valores);
+        quantis_exibir(&quantis);
     }
+    printf("\n");
     
-    if (write(write_fd, &desvio, sizeof(double)) == -1) {
-        perror("Erro ao escrever desvio padrão no pipe");
-        _exit(EXIT_FAILURE);
+    // Exibe métricas de tempo
+    printf("--- MÉTRICAS DE TEMPO ---\n");
+    printf("Tempo total de execução: %.3f ms\n", tempo_total);
+    printf("Tempo de criação do pool: %.3f ms\n", tempo_criacao);
+    printf("Tempo do lote: %.3f ms\n", tempo_lote);
+    printf("Latência média por conjunto: %.3f ms\n", tempo_lote / n_conjuntos);
+    printf("Vazão: %.1f conjuntos/s (%.3e valores/s)\n",
+           n_conjuntos / (tempo_lote / 1000.0), total_valores / (tempo_lote / 1000.0));
+    contadores_exibir();
+    contadores_fechar();
+    
+    free(resultados);
+    if (regiao != NULL) {
+        munmap(regiao, sizeof(RegiaoCompartilhada) + regiao->tamanho * elemento_bytes(regiao->tipo));
     }
+    vetor_liberar(vetor);
     
-    _exit(EXIT_SUCCESS);
+    printf("\n========================================\n");
+    printf("  Execução finalizada com sucesso\n");
+    printf("========================================\n");
+    
+    return EXIT_SUCCESS;
 }
 
-int main() {
-    // Inicializa gerador aleatório
-    srand(time(NULL));
+int main(int argc, char *argv[]) {
+    int memoria_compartilhada = 0;
+    int n_processos_pool = 0;
+    int n_conjuntos = 1;
+    int paginas_enormes = 0;
+    const char *arquivo = NULL;
+    int dominio_informado = 0;
+    int armazenamento_largo = 0;
+    semente = gerador_semente_padrao();
+    
+    // Lê as opções da linha de comando
+    int opcao;
+    while ((opcao = getopt(argc, argv, "n:v:Hf:S:sP:b:q:K:wA:T:")) != -1) {
+        switch (opcao) {
+            case 'n':
+                n_entradas = strtoull(optarg, NULL, 10);
+                break;
+            case 'v':
+                if (dominio_ler(optarg, &dominio) != 0) {
+                    fprintf(stderr, "Intervalo inválido: %s (use min:max)\n", optarg);
+                    return EXIT_FAILURE;
+                }
+                dominio_informado = 1;
+                break;
+            case 'H':
+                paginas_enormes = 1;
+                break;
+            case 'f':
+                arquivo = optarg;
+                break;
+            case 'S':
+                semente = strtoull(optarg, NULL, 10);
+                break;
+            case 's':
+                memoria_compartilhada = 1;
+                break;
+            case 'P':
+                n_processos_pool = atoi(optarg);
+                break;
+            case 'b':
+                n_conjuntos = atoi(optarg);
+                break;
+            case 'q':
+                if (quantis_ler(optarg, &quantis) != 0) {
+                    fprintf(stderr, "Lista de quantis inválida: %s (ex.: 0.5,0.9,0.99)\n", optarg);
+                    return EXIT_FAILURE;
+                }
+                break;
+            case 'K':
+                precisao_esboco = atoi(optarg);
+                if (precisao_esboco < 8) {
+                    fprintf(stderr, "Precisão do esboço inválida: %s (mínimo 8)\n", optarg);
+                    return EXIT_FAILURE;
+                }
+                break;
+            case 'w':
+                armazenamento_largo = 1;
+                break;
+            case 'A':
+                if (afinidade_ler(optarg, &afinidade) != 0) {
+                    fprintf(stderr, "Afinidade inválida: %s (compacto, espalhado ou lista, ex.: 0,2,4-7)\n", optarg);
+                    return EXIT_FAILURE;
+                }
+                break;
+            case 'T':
+                prazo_ms = atof(optarg);
+                break;
+            default:
+                fprintf(stderr, "Uso: %s [-n quantidade] [-v min:max] [-H] [-f arquivo.bin] [-S semente] [-w] [-A afinidade] [-s] [-T prazo_ms] [-P processos [-b conjuntos] [-q quantis] [-K precisão]]\n", argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
     
-    // Preenche o vetor com números aleatórios de 0 a 100
-    for (int i = 0; i < N_ENTRADAS; i++) {
-        valores[i] = rand() % (MAX_VALOR - MIN_VALOR + 1) + MIN_VALOR;
+    // Contadores e rastro por fase, se pedidos pelo ambiente
+    // (ESTATISTICAS_CONTADORES e ESTATISTICAS_RASTRO)
+    contadores_abrir();
+    rastro_iniciar();
+    rastro_nomear("pai");
+    
+    // Conjunto preparado com o converter: mapeado sem conversão nem cópia.
+    // Sem -v, o intervalo gravado no cabeçalho define o histograma.
+    Vetor vetor = { 0 };
+    if (arquivo != NULL) {
+        if (dados_mapear(&vetor, arquivo, dominio_informado ? NULL : &dominio) != 0) {
+            return EXIT_FAILURE;
+        }
+        n_entradas = vetor.tamanho;
+        valores = vetor.valores;
+        tipo_elemento = vetor.tipo;
+    } else if (!armazenamento_largo) {
+        // Valores gerados: menor tipo que cabe no intervalo
+        tipo_elemento = dominio_tipo_elemento(dominio);
     }
     
-    printf("========================================\n");
-    printf("  EXECUÇÃO COM TRÊS PROCESSOS\n");
-    printf("========================================\n\n");
-    printf("PID do processo pai: %d\n\n", getpid());
+    if (n_entradas == 0) {
+        fprintf(stderr, "Quantidade de valores inválida\n");
+        return EXIT_FAILURE;
+    }
     
-    // Cria o pipe para comunicação
-    int pipe_fds[2];
-    if (pipe(pipe_fds) == -1) {
-        perror("Erro ao criar pipe");
+    if (quantis.quantidade > 0 && n_processos_pool <= 0) {
+        fprintf(stderr, "A opção -q exige o modo com pool (-P)\n");
         return EXIT_FAILURE;
     }
     
-    // Começa a medir o tempo total
-    struct timeval inicio_total, fim_total;
-    gettimeofday(&inicio_total, NULL);
+    if (n_processos_pool > 0) {
+        return executar_pool(n_processos_pool, n_conjuntos > 0 ? n_conjuntos : 1, paginas_enormes, &vetor);
+    }
     
-    // Começa a medir o tempo de criação
-    struct timeval inicio_criacao, fim_criacao;
-    gettimeofday(&inicio_criacao, NULL);
+    // Aloca o vetor: na região compartilhada ou na memória do pai.
+    // Com -f a região guarda só os resultados; os dados ficam no arquivo.
+    if (memoria_compartilhada) {
+        regiao = criar_regiao(arquivo != NULL ? 0 : n_entradas, tipo_elemento, paginas_enormes);
+        if (regiao == NULL) {
+            return EXIT_FAILURE;
+        }
+        if (arquivo == NULL) {
+            valores = regiao->valores;
+        }
+    
+        evento_fd = eventfd(0, EFD_CLOEXEC);
+        if (evento_fd == -1) {
+            perror("Erro ao criar eventfd");
+            return EXIT_FAILURE;
+        }
+    } else if (arquivo == NULL) {
+        if (vetor_alocar(&vetor, n_entradas, tipo_elemento,
+                         paginas_enormes ? VETOR_PAGINAS_ENORMES : 0) != 0) {
+            return EXIT_FAILURE;
+        }
+        valores = vetor.valores;
+    }
     
-    // PIDs dos processos filhos
-    pid_t pids[3];
+    // Sem arquivo: gera os valores
+    if (arquivo == NULL) {
+        // Preenche em paralelo com valores do intervalo [min, max] (sem viés)
+        contadores_entrar("geracao");
+        if (gerador_preencher(valores, tipo_elemento, n_entradas, dominio, semente, 0, NULL) != 0) {
+            return EXIT_FAILURE;
+        }
+        contadores_sair();
+    }
     
-    // Cria processo da média
-    pids[0] = fork();
-    if (pids[0] == 0) {
-        // Processo filho: fecha o lado de leitura do pipe
-        close(pipe_fds[0]);
-        calcular_media(pipe_fds[1]);
-    } else if (pids[0] < 0) {
-        perror("Erro ao criar fork para média");
-        return EXIT_FAILURE;
+    // Modo de latência (ESTATISTICAS_LATENCIA), antes dos fork()
+    latencia_iniciar(valores, n_entradas * elemento_bytes(tipo_elemento), 0);
+    
+    printf("========================================\n");
+    if (memoria_compartilhada) {
+        printf("  EXECUÇÃO COM TRÊS PROCESSOS (MEMÓRIA COMPARTILHADA)\n");
+    } else {
+        printf("  EXECUÇÃO COM TRÊS PROCESSOS\n");
+    }
+    printf("========================================\n\n");
+    printf("PID do processo pai: %d\n", getpid());
+    printf("Armazenamento: %s, %zu B por valor\n", elemento_nome(tipo_elemento),
+           elemento_bytes(tipo_elemento));
+    afinidade_exibir(&afinidade);
+    latencia_exibir();
+    if (prazo_ms > 0) {
+        printf("Prazo por cálculo: %.0f ms (até %d tentativas)\n", prazo_ms, MAX_TENTATIVAS);
     }
+    printf("\n");
     
-    // Cria processo da mediana
-    pids[1] = fork();
-    if (pids[1] == 0) {
-        // Processo filho: fecha o lado de leitura do pipe
-        close(pipe_fds[0]);
-        calcular_mediana(pipe_fds[1]);
-    } else if (pids[1] < 0) {
-        perror("Erro ao criar fork para mediana");
+    // Coletor: epoll sobre os pipes (ou o eventfd) e os pidfds dos filhos
+    int epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    if (epoll_fd == -1) {
+        perror("Erro ao criar epoll");
         return EXIT_FAILURE;
     }
-    
-    // Cria processo do desvio padrão
-    pids[2] = fork();
-    if (pids[2] == 0) {
-        // Processo filho: fecha o lado de leitura do pipe
-        close(pipe_fds[0]);
-        calcular_desvio_padrao(pipe_fds[1]);
-    } else if (pids[2] < 0) {
-        perror("Erro ao criar fork para desvio padrão");
+    if (memoria_compartilhada && observar(epoll_fd, evento_fd, 0, EVENTO_AVISO) == -1) {
+        perror("Erro ao acompanhar o eventfd");
         return EXIT_FAILURE;
     }
+    Calculo calculos[3] = { { 0 } };
+    
+    // Começa a medir o tempo total
+    struct timespec inicio_total, fim_total;
+    marcar_instante(&inicio_total);
+    
+    // Começa a medir o tempo de criação
+    struct timespec inicio_criacao, fim_criacao;
+    marcar_instante(&inicio_criacao);
+    contadores_entrar("criacao");
+    
+    // Cria os processos da média, da mediana e do desvio padrão, cada um
+    // com o próprio canal
+    for (int i = 0; i < 3; i++) {
+        if (disparar_calculo(epoll_fd, calculos, i) != 0) {
+            return EXIT_FAILURE;
+        }
+    }
     
     // Para de medir o tempo de criação
-    gettimeofday(&fim_criacao, NULL);
+    marcar_instante(&fim_criacao);
+    contadores_entrar("transporte");
+    
+    // Recebe os resultados, redisparando os cálculos que falharem
+    int redisparos = 0;
+    int resultados_recebidos = coletar_resultados(epoll_fd, calculos, &redisparos);
     
-    // Pai: fecha escrita do pipe
-    close(pipe_fds[1]);
+    // Espera os filhos que ainda não foram coletados (após uma desistência,
+    // os que restam são encerrados)
+    contadores_entrar("espera");
+    for (int i = 0; i < 3; i++) {
+        fechar_canal(epoll_fd, &calculos[i]);
+        if (calculos[i].pid == 0) continue;
+        if (resultados_recebidos < 3) {
+            syscall(SYS_pidfd_send_signal, calculos[i].pidfd, SIGKILL, NULL, 0);
+        }
+        coletar_filho(epoll_fd, &calculos[i]);
+    }
+    contadores_sair();
+    close(epoll_fd);
+    if (evento_fd != -1) close(evento_fd);
     
     // Resultados recebidos
     double resultado_media = 0.0;
     double resultado_mediana = 0.0;
     double resultado_desvio = 0.0;
-    
-    // Lê todos os resultados dos filhos
-    int resultados_recebidos = 0;
-    while (resultados_recebidos < 3) {
-        TipoResultado tipo;
-        double valor;
-        
-        ssize_t bytes_lidos_tipo = read(pipe_fds[0], &tipo, sizeof(TipoResultado));
-        if (bytes_lidos_tipo > 0) {
-            ssize_t bytes_lidos_valor = read(pipe_fds[0], &valor, sizeof(double));
-            if (bytes_lidos_valor > 0) {
-                switch (tipo) {
-                    case RESULTADO_MEDIA:
-                        resultado_media = valor;
-                        break;
-                    case RESULTADO_MEDIANA:
-                        resultado_mediana = valor;
-                        break;
-                    case RESULTADO_DESVIO:
-                        resultado_desvio = valor;
-                        break;
-                }
-                resultados_recebidos++;
-            }
+    for (int i = 0; i < 3; i++) {
+        if (calculos[i].recebido) {
+            registrar_resultado(calculos[i].mensagem.tipo, calculos[i].mensagem.valor,
+                                &resultado_media, &resultado_mediana, &resultado_desvio);
         }
     }
     
-    // Fecha leitura do pipe
-    close(pipe_fds[0]);
+    // Para de medir o tempo total
+    marcar_instante(&fim_total);
     
-    // Espera todos os filhos terminarem
-    for (int i = 0; i < 3; i++) {
-        waitpid(pids[i], NULL, 0);
+    if (resultados_recebidos < 3) {
+        fprintf(stderr, "Erro: apenas %d de 3 resultados recebidos\n", resultados_recebidos);
+        return EXIT_FAILURE;
     }
     
-    // Para de medir o tempo total
-    gettimeofday(&fim_total, NULL);
-    
     // Calcula tempo de criação (ms)
-    long segundos_criacao = fim_criacao.tv_sec - inicio_criacao.tv_sec;
-    long microsegundos_criacao = fim_criacao.tv_usec - inicio_criacao.tv_usec;
-    double tempo_criacao = (segundos_criacao * 1000.0) + (microsegundos_criacao / 1000.0);
+    double tempo_criacao = diferenca_ms(inicio_criacao, fim_criacao);
     
     // Calcula tempo total (ms)
-    long segundos_total = fim_total.tv_sec - inicio_total.tv_sec;
-    long microsegundos_total = fim_total.tv_usec - inicio_total.tv_usec;
-    double tempo_total = (segundos_total * 1000.0) + (microsegundos_total / 1000.0);
+    double tempo_total = diferenca_ms(inicio_total, fim_total);
     
     // Exibe resultados estatísticos
     printf("--- RESULTADOS ESTATÍSTICOS ---\n");
-    printf("Quantidade de valores processados: %d\n", N_ENTRADAS);
+    printf("Quantidade de valores processados: %zu\n", n_entradas);
+    if (arquivo == NULL) {
+        printf("Semente do gerador: %llu\n", (unsigned long long)semente);
+    }
     printf("Média aritmética: %.6f\n", resultado_media);
     printf("Mediana: %.6f\n", resultado_mediana);
     printf("Desvio padrão populacional: %.6f\n\n", resultado_desvio);
@@ -289,6 +991,17 @@ int main() {
     printf("--- MÉTRICAS DE TEMPO ---\n");
     printf("Tempo total de execução: %.3f ms\n", tempo_total);
     printf("Tempo de criação dos processos: %.3f ms\n", tempo_criacao);
+    if (redisparos > 0) {
+        printf("Cálculos redisparados: %d\n", redisparos);
+    }
+    contadores_exibir();
+    contadores_fechar();
+    
+    // Libera a região compartilhada e o vetor (alocado ou mapeado)
+    if (regiao != NULL) {
+        munmap(regiao, sizeof(RegiaoCompartilhada) + regiao->tamanho * elemento_bytes(regiao->tipo));
+    }
+    vetor_liberar(&vetor);
     
     printf("\n========================================\n");
     printf("  Execução finalizada com sucesso\n");
@@ -296,4 +1009,3 @@ int main() {
     
     return EXIT_SUCCESS;
 }
-
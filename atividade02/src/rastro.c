@@ -0,0 +1,195 @@
+/*
+ * Instituição: Universidade Federal da Paraíba
+ * Disciplina: Sistemas Operacionais I
+ * Unidade 1 - Atividade 2
+ *
+ * Autor: Rodrigo Monteiro Fortes de Oliveira, 20240097664
+ *
+ * Nome do Módulo: rastro.c
+ *
+ * Descrição:
+ *     Implementação do rastro declarado em rastro.h. Cada buffer tem um
+ *     único escritor (a thread dona); o contador de eventos é publicado
+ *     com ordem de liberação depois do evento. O processo inicial só lê
+ *     os buffers na saída, depois de esperar threads e filhos. Após um
+ *     fork() o filho esquece o buffer herdado e reserva um novo no
+ *     primeiro registro (pthread_atfork).
+ */
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include "rastro.h"
+#include "tempo.h"
+
+typedef struct {
+    uint64_t instante_ns;
+    const char *nome;
+    long long valor;
+    char tipo;
+} EventoRastro;
+
+typedef struct {
+    int pid;
+    int tid;
+    const char *nome;
+    uint32_t quantidade;
+    EventoRastro eventos[RASTRO_EVENTOS];
+} BufferRastro;
+
+// Área compartilhada por todos os processos do rastro
+typedef struct {
+    uint64_t origem_ns;
+    uint32_t n_buffers;    // reservados (pode passar de RASTRO_MAX_BUFFERS)
+    uint32_t perdidos;     // eventos sem espaço
+    BufferRastro buffers[RASTRO_MAX_BUFFERS];
+} AreaRastro;
+
+int rastro_ativo = 0;
+
+static AreaRastro *area = NULL;
+static const char *caminho_saida = NULL;
+static pid_t pid_inicial = 0;
+static __thread BufferRastro *buffer_atual = NULL;
+
+static uint64_t agora_ns(void) {
+    struct timespec instante;
+    marcar_instante(&instante);
+    return (uint64_t)instante.tv_sec * 1000000000ULL + instante.tv_nsec;
+}
+
+// No filho de um fork(): o buffer herdado pertence à thread do pai
+static void esquecer_buffer(void) {
+    buffer_atual = NULL;
+}
+
+// Reserva o buffer da thread atual (NULL se a área estiver cheia)
+static BufferRastro* reservar_buffer(void) {
+    uint32_t indice = __atomic_fetch_add(&area->n_buffers, 1, __ATOMIC_RELAXED);
+    if (indice >= RASTRO_MAX_BUFFERS) {
+        return NULL;
+    }
+    
+    BufferRastro *buffer = &area->buffers[indice];
+    buffer->pid = getpid();
+    buffer->tid = (int)syscall(SYS_gettid);
+    buffer->nome = NULL;
+    buffer->quantidade = 0;
+    return buffer;
+}
+
+void rastro_registrar(char tipo, const char *nome, long long valor) {
+    uint64_t instante = agora_ns();
+    
+    if (buffer_atual == NULL) {
+        buffer_atual = reservar_buffer();
+    }
+    BufferRastro *buffer = buffer_atual;
+    if (buffer == NULL || buffer->quantidade == RASTRO_EVENTOS) {
+        __atomic_fetch_add(&area->perdidos, 1, __ATOMIC_RELAXED);
+        return;
+    }
+    
+    EventoRastro *evento = &buffer->eventos[buffer->quantidade];
+    evento->instante_ns = instante;
+    evento->nome = nome;
+    evento->valor = valor;
+    evento->tipo = tipo;
+    __atomic_store_n(&buffer->quantidade, buffer->quantidade + 1, __ATOMIC_RELEASE);
+}
+
+void rastro_nomear(const char *nome) {
+    if (!rastro_ativo) return;
+    
+    if (buffer_atual == NULL) {
+        buffer_atual = reservar_buffer();
+    }
+    if (buffer_atual != NULL && buffer_atual->nome == NULL) {
+        buffer_atual->nome = nome;
+    }
+}
+
+// Grava o JSON; só o processo que iniciou o rastro escreve o arquivo
+static void gravar_rastro(void) {
+    if (!rastro_ativo || getpid() != pid_inicial) return;
+    
+    FILE *arquivo = fopen(caminho_saida, "w");
+    if (arquivo == NULL) {
+        perror("Erro ao criar o arquivo de rastro");
+        return;
+    }
+    
+    uint32_t n_buffers = __atomic_load_n(&area->n_buffers, __ATOMIC_ACQUIRE);
+    if (n_buffers > RASTRO_MAX_BUFFERS) n_buffers = RASTRO_MAX_BUFFERS;
+    
+    fprintf(arquivo, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    int primeiro = 1;
+    for (uint32_t b = 0; b < n_buffers; b++) {
+        const BufferRastro *buffer = &area->buffers[b];
+    
+        // Metadados: nome da thread e, na thread principal, do processo
+        if (buffer->nome != NULL) {
+            fprintf(arquivo, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":%d,"
+                    "\"args\":{\"name\":\"%s\"}}", primeiro ? "" : ",\n",
+                    buffer->pid, buffer->tid, buffer->nome);
+            primeiro = 0;
+            if (buffer->tid == buffer->pid) {
+                fprintf(arquivo, ",\n{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%d,"
+                        "\"args\":{\"name\":\"%s (%d)\"}}", buffer->pid, buffer->nome, buffer->pid);
+            }
+        }
+    
+        uint32_t quantidade = __atomic_load_n(&buffer->quantidade, __ATOMIC_ACQUIRE);
+        for (uint32_t e = 0; e < quantidade; e++) {
+            const EventoRastro *evento = &buffer->eventos[e];
+            double ts = (double)(evento->instante_ns - area->origem_ns) / 1000.0;
+            fprintf(arquivo, "%s{\"name\":\"%s\",\"ph\":\"%c\",\"ts\":%.3f,\"pid\":%d,\"tid\":%d",
+                    primeiro ? "" : ",\n", evento->nome, evento->tipo, ts,
+                    buffer->pid, buffer->tid);
+            primeiro = 0;
+            if (evento->tipo == 'i') {
+                fprintf(arquivo, ",\"s\":\"t\"");
+                if (evento->valor != -1) {
+                    fprintf(arquivo, ",\"args\":{\"valor\":%lld}", evento->valor);
+                }
+            }
+            fprintf(arquivo, "}");
+        }
+    }
+    fprintf(arquivo, "\n]}\n");
+    
+    if (area->perdidos > 0) {
+        fprintf(stderr, "Aviso: %u eventos do rastro descartados (buffers cheios)\n",
+                area->perdidos);
+    }
+    if (fclose(arquivo) != 0) {
+        perror("Erro ao gravar o arquivo de rastro");
+    }
+}
+
+void rastro_iniciar(void) {
+    caminho_saida = getenv("ESTATISTICAS_RASTRO");
+    if (caminho_saida == NULL || *caminho_saida == '\0' || rastro_ativo) {
+        return;
+    }
+    
+    // Só as páginas tocadas ocupam memória
+    void *endereco = mmap(NULL, sizeof(AreaRastro), PROT_READ | PROT_WRITE,
+                          MAP_SHARED | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (endereco == MAP_FAILED) {
+        perror("Aviso: rastro desligado, erro ao mapear a área");
+        return;
+    }
+    
+    area = (AreaRastro*)endereco;
+    area->origem_ns = agora_ns();
+    pid_inicial = getpid();
+    pthread_atfork(NULL, NULL, esquecer_buffer);
+    atexit(gravar_rastro);
+    rastro_ativo = 1;
+}
@@ -0,0 +1,65 @@
+/*
+ * Instituição: Universidade Federal da Paraíba
+ * Disciplina: Sistemas Operacionais I
+ * Unidade 1 - Atividade 2
+ *
+ * Autor: Rodrigo Monteiro Fortes de Oliveira, 20240097664
+ *
+ * Nome do Módulo: rastro.h
+ *
+ * Descrição:
+ *     Linha do tempo da execução no formato Chrome trace (JSON), aberta
+ *     no Perfetto (ui.perfetto.dev) ou em chrome://tracing. Registra o
+ *     ciclo de vida de threads e processos (criação, execução, fim e
+ *     coleta pelo pai) e as fases de cada um, com o relógio monotônico.
+ *
+ *     Cada thread ou processo escreve em um buffer próprio, reservado
+ *     com uma única operação atômica em uma área MAP_SHARED criada antes
+ *     dos fork(): não há trava, e os eventos dos filhos ficam visíveis
+ *     para o processo inicial, que grava o arquivo ao terminar (atexit).
+ *     Os nomes dos eventos devem ser literais, válidos em todos os
+ *     processos criados por fork() sem exec.
+ *
+ *     O rastro só é ligado com ESTATISTICAS_RASTRO=arquivo.json no
+ *     ambiente. Desligado, cada ponto de registro custa um desvio sobre
+ *     uma variável global, sem chamada de função.
+ */
+
+#ifndef RASTRO_H
+#define RASTRO_H
+
+// Buffers (threads e processos) e eventos por buffer
+#define RASTRO_MAX_BUFFERS 1024
+#define RASTRO_EVENTOS 4096
+
+// Diferente de zero quando o rastro está ligado
+extern int rastro_ativo;
+
+// Liga o rastro se ESTATISTICAS_RASTRO estiver definida. Deve ser chamada
+// antes de criar threads ou processos; o arquivo é gravado na saída.
+void rastro_iniciar(void);
+
+// Registra um evento da thread atual: 'B' (começo), 'E' (fim) ou 'i'
+// (instante, com 'valor' nos argumentos; -1 omite)
+void rastro_registrar(char tipo, const char *nome, long long valor);
+
+// Dá nome à thread atual na linha do tempo (e ao processo, se for a
+// principal). Vale o primeiro nome: uma thread do pool que se nomeia ao
+// começar não é renomeada pelas tarefas que executa.
+void rastro_nomear(const char *nome);
+
+// Começo e fim de uma fase da thread atual
+static inline void rastro_comecar(const char *nome) {
+    if (__builtin_expect(rastro_ativo, 0)) rastro_registrar('B', nome, -1);
+}
+
+static inline void rastro_terminar(const char *nome) {
+    if (__builtin_expect(rastro_ativo, 0)) rastro_registrar('E', nome, -1);
+}
+
+// Acontecimento pontual (ex.: "criado" com o PID do filho, "coletado")
+static inline void rastro_marcar(const char *nome, long long valor) {
+    if (__builtin_expect(rastro_ativo, 0)) rastro_registrar('i', nome, valor);
+}
+
+#endif
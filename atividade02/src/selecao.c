@@ -0,0 +1,451 @@
+/*
+ * Instituição: Universidade Federal da Paraíba
+ * Disciplina: Sistemas Operacionais I
+ * Unidade 1 - Atividade 2
+ *
+ * Autor: Rodrigo Monteiro Fortes de Oliveira, 20240097664
+ *
+ * Nome do Módulo: selecao.c
+ *
+ * Descrição:
+ *     Implementação das seleções declaradas em selecao.h. O introselect
+ *     é definido uma vez por macro para int e para double. Na seleção
+ *     radix a chave de 32 bits é o valor com o bit de sinal invertido
+ *     (mesma ordem, sem sinal), resolvida em três passadas de 11, 11 e
+ *     10 bits; as threads se sincronizam por uma barreira e a thread
+ *     principal soma as contagens e escolhe o dígito de cada passada.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+#include <unistd.h>
+#include <pthread.h>
+#include "estatisticas.h"
+#include "selecao.h"
+
+// Trechos menores que isso são ordenados por inserção
+#define LIMIAR_INSERCAO 16
+
+// Dígitos da seleção radix, do mais para o menos significativo
+#define RADIX_MAX_PASSADAS 6
+#define RADIX_CLASSES (1 << 11)
+
+typedef struct {
+    int passadas;
+    int deslocamento[RADIX_MAX_PASSADAS];
+    int bits[RADIX_MAX_PASSADAS];
+} DigitosRadix;
+
+// int: chave de 32 bits em 3 passadas; double: 64 bits em 6
+static const DigitosRadix DIGITOS_INT = { 3, { 21, 10, 0 }, { 11, 11, 10 } };
+static const DigitosRadix DIGITOS_DOUBLE = { 6, { 53, 42, 31, 20, 10, 0 }, { 11, 11, 11, 11, 10, 10 } };
+
+static int comparar_double(const void *a, const void *b) {
+    double double_a = *((const double*)a);
+    double double_b = *((const double*)b);
+    
+    if (double_a < double_b) return -1;
+    if (double_a > double_b) return 1;
+    return 0;
+}
+
+// Profundidade máxima do quickselect antes de recorrer à ordenação
+static int profundidade_maxima(size_t tamanho) {
+    int niveis = 0;
+    while (tamanho > 1) {
+        tamanho >>= 1;
+        niveis++;
+    }
+    return 2 * niveis;
+}
+
+// Introselect para o tipo 'tipo'; 'comparar_tipo' é usado no qsort de reserva
+#define DEFINIR_SELECAO(nome, tipo, comparar_tipo)                                  \
+tipo nome(tipo *trabalho, size_t tamanho, size_t k) {                               \
+    size_t esquerda = 0, direita = tamanho;                                         \
+    int profundidade = profundidade_maxima(tamanho);                                \
+                                                                                    \
+    while (direita - esquerda > LIMIAR_INSERCAO) {                                  \
+        if (profundidade-- == 0) {                                                  \
+            /* Pivôs ruins demais: garante O(n log n) no trecho restante */         \
+            qsort(trabalho + esquerda, direita - esquerda, sizeof(tipo),            \
+                  comparar_tipo);                                                   \
+            return trabalho[k];                                                     \
+        }                                                                           \
+                                                                                    \
+        /* Pivô: mediana entre o primeiro, o do meio e o último */                  \
+        tipo a = trabalho[esquerda];                                                \
+        tipo b = trabalho[esquerda + (direita - esquerda) / 2];                     \
+        tipo c = trabalho[direita - 1];                                             \
+        tipo pivo = a < b ? (b < c ? b : (a < c ? c : a))                           \
+                          : (a < c ? a : (b < c ? c : b));                          \
+                                                                                    \
+        /* Três vias: [esq, menores) < pivô, [menores, maiores) == pivô */          \
+        size_t menores = esquerda, i = esquerda, maiores = direita;                 \
+        while (i < maiores) {                                                       \
+            tipo valor = trabalho[i];                                               \
+            if (valor < pivo) {                                                     \
+                trabalho[i++] = trabalho[menores];                                  \
+                trabalho[menores++] = valor;                                        \
+            } else if (pivo < valor) {                                              \
+                trabalho[i] = trabalho[--maiores];                                  \
+                trabalho[maiores] = valor;                                          \
+            } else {                                                                \
+                i++;                                                                \
+            }                                                                       \
+        }                                                                           \
+                                                                                    \
+        if (k < menores) {                                                          \
+            direita = menores;                                                      \
+        } else if (k >= maiores) {                                                  \
+            esquerda = maiores;                                                     \
+        } else {                                                                    \
+            return pivo;    /* k caiu entre os iguais ao pivô */                    \
+        }                                                                           \
+    }                                                                               \
+                                                                                    \
+    /* Trecho pequeno: inserção */                                                  \
+    for (size_t i = esquerda + 1; i < direita; i++) {                               \
+        tipo valor = trabalho[i];                                                   \
+        size_t j = i;                                                               \
+        while (j > esquerda && valor < trabalho[j - 1]) {                           \
+            trabalho[j] = trabalho[j - 1];                                          \
+            j--;                                                                    \
+        }                                                                           \
+        trabalho[j] = valor;                                                        \
+    }                                                                               \
+    return trabalho[k];                                                             \
+}
+
+DEFINIR_SELECAO(selecao_int, int, comparar)
+DEFINIR_SELECAO(selecao_double, double, comparar_double)
+
+// Área reservada por selecao_reservar (modo de latência)
+static int *reserva = NULL;
+static size_t reserva_tamanho = 0;
+static int reserva_em_uso = 0;
+
+int selecao_reservar(size_t tamanho) {
+    if (reserva != NULL && reserva_tamanho >= tamanho) {
+        return 0;
+    }
+    
+    int *area = (int*)malloc((tamanho > 0 ? tamanho : 1) * sizeof(int));
+    if (area == NULL) {
+        return -1;
+    }
+    // Escreve em todas as páginas: as faltas acontecem aqui, não na medição
+    memset(area, 0, tamanho * sizeof(int));
+    
+    free(reserva);
+    reserva = area;
+    reserva_tamanho = tamanho;
+    return 0;
+}
+
+int* selecao_trabalho(size_t tamanho) {
+    if (reserva != NULL && tamanho <= reserva_tamanho &&
+        !__atomic_exchange_n(&reserva_em_uso, 1, __ATOMIC_ACQUIRE)) {
+        return reserva;
+    }
+    
+    int *trabalho = (int*)malloc((tamanho > 0 ? tamanho : 1) * sizeof(int));
+    if (trabalho == NULL) {
+        fprintf(stderr, "Erro ao alocar memória para cópia do vetor\n");
+        exit(EXIT_FAILURE);
+    }
+    return trabalho;
+}
+
+void selecao_devolver(int *trabalho) {
+    if (trabalho != NULL && trabalho == reserva) {
+        __atomic_store_n(&reserva_em_uso, 0, __ATOMIC_RELEASE);
+    } else {
+        free(trabalho);
+    }
+}
+
+// Cópia de trabalho do vetor (encerra o programa se faltar memória)
+static int* copiar_trabalho(const int *valores, size_t tamanho) {
+    int *copia = selecao_trabalho(tamanho);
+    memcpy(copia, valores, tamanho * sizeof(int));
+    return copia;
+}
+
+int selecao_elemento(const int *valores, size_t tamanho, size_t k) {
+    int *copia = copiar_trabalho(valores, tamanho);
+    int elemento = selecao_int(copia, tamanho, k);
+    selecao_devolver(copia);
+    return elemento;
+}
+
+double mediana_selecao(const int *valores, size_t tamanho) {
+    if (tamanho == 0) return NAN;
+    
+    int *copia = copiar_trabalho(valores, tamanho);
+    size_t meio = tamanho / 2;
+    
+    double mediana = selecao_int(copia, tamanho, meio);
+    if (tamanho % 2 == 0) {
+        // Par: o outro elemento do meio é o maior da metade inferior,
+        // que a seleção já deixou à esquerda
+        int anterior = copia[0];
+        for (size_t i = 1; i < meio; i++) {
+            if (copia[i] > anterior) anterior = copia[i];
+        }
+        mediana = (anterior + mediana) / 2.0;
+    }
+    
+    selecao_devolver(copia);
+    return mediana;
+}
+
+// --- Seleção radix paralela ---
+
+typedef struct TrechoRadix TrechoRadix;
+
+typedef struct {
+    const int *valores;             // um dos dois vetores, o outro NULL
+    const double *valores_double;
+    const DigitosRadix *digitos;
+    TrechoRadix *trechos;
+    int n_threads;
+    
+    // Resposta parcial: bits já fixados da chave e posição dentro deles
+    uint64_t prefixo;
+    uint64_t mascara;
+    size_t k;
+    
+    pthread_barrier_t barreira;
+} SelecaoRadix;
+
+struct TrechoRadix {
+    SelecaoRadix *selecao;
+    size_t inicio;
+    size_t fim;
+    size_t contagem[RADIX_CLASSES];
+} __attribute__((aligned(LINHA_CACHE)));
+
+// Chave sem sinal com a mesma ordem do int
+static inline uint64_t chave_radix(int valor) {
+    return (uint32_t)valor ^ 0x80000000u;
+}
+
+// Chave sem sinal com a mesma ordem do double: nos positivos basta
+// ligar o bit de sinal; nos negativos todos os bits são invertidos
+static inline uint64_t chave_radix_double(double valor) {
+    uint64_t bits;
+    memcpy(&bits, &valor, sizeof(bits));
+    return (bits & 0x8000000000000000ull) ? ~bits : bits ^ 0x8000000000000000ull;
+}
+
+static inline double double_da_chave(uint64_t chave) {
+    uint64_t bits = (chave & 0x8000000000000000ull) ? chave ^ 0x8000000000000000ull : ~chave;
+    double valor;
+    memcpy(&valor, &bits, sizeof(valor));
+    return valor;
+}
+
+// Uma única thread por passada: soma as contagens e fixa o dígito
+static void escolher_digito(SelecaoRadix *selecao, int passada) {
+    TrechoRadix *trechos = selecao->trechos;
+    int classes = 1 << selecao->digitos->bits[passada];
+    int deslocamento = selecao->digitos->deslocamento[passada];
+    size_t acumulado = 0;
+    
+    for (int d = 0; d < classes; d++) {
+        size_t contagem = 0;
+        for (int t = 0; t < selecao->n_threads; t++) {
+            contagem += trechos[t].contagem[d];
+        }
+        if (acumulado + contagem > selecao->k) {
+            selecao->k -= acumulado;
+            selecao->prefixo |= (uint64_t)d << deslocamento;
+            selecao->mascara |= (uint64_t)(classes - 1) << deslocamento;
+            return;
+        }
+        acumulado += contagem;
+    }
+}
+
+// Conta os dígitos das chaves do trecho que ainda podem ser a resposta
+#define CONTAR_TRECHO(vetor, chave_de)                                              \
+    for (size_t i = trecho->inicio; i < trecho->fim; i++) {                         \
+        uint64_t chave = chave_de(vetor[i]);                                        \
+        if ((chave & mascara) == prefixo) {                                         \
+            trecho->contagem[(chave >> deslocamento) & digito]++;                   \
+        }                                                                           \
+    }
+
+// Laço de cada thread: conta os dígitos do seu trecho em cada passada
+static void* contar_digitos(void *arg) {
+    TrechoRadix *trecho = (TrechoRadix*)arg;
+    SelecaoRadix *selecao = trecho->selecao;
+    const DigitosRadix *digitos = selecao->digitos;
+    
+    for (int passada = 0; passada < digitos->passadas; passada++) {
+        uint64_t prefixo = selecao->prefixo;
+        uint64_t mascara = selecao->mascara;
+        int deslocamento = digitos->deslocamento[passada];
+        uint64_t digito = (1u << digitos->bits[passada]) - 1;
+    
+        memset(trecho->contagem, 0, sizeof(trecho->contagem));
+        if (selecao->valores != NULL) {
+            CONTAR_TRECHO(selecao->valores, chave_radix)
+        } else {
+            CONTAR_TRECHO(selecao->valores_double, chave_radix_double)
+        }
+    
+        // Todas as contagens prontas; uma das threads escolhe o dígito
+        if (pthread_barrier_wait(&selecao->barreira) == PTHREAD_BARRIER_SERIAL_THREAD) {
+            escolher_digito(selecao, passada);
+        }
+        pthread_barrier_wait(&selecao->barreira);
+    }
+    
+    return NULL;
+}
+
+// Threads efetivas da versão paralela; 1 significa usar a sequencial
+static int threads_selecao(size_t tamanho, int n_threads) {
+    if (n_threads <= 0) {
+        long nucleos = sysconf(_SC_NPROCESSORS_ONLN);
+        n_threads = nucleos > 0 ? (int)nucleos : 1;
+    }
+    return tamanho < SELECAO_MINIMO_PARALELO ? 1 : n_threads;
+}
+
+// Fixa todos os bits da chave do k-ésimo elemento com n_threads threads
+static void selecao_radix(SelecaoRadix *selecao, size_t tamanho, size_t k, int n_threads) {
+    selecao->n_threads = n_threads;
+    selecao->prefixo = 0;
+    selecao->mascara = 0;
+    selecao->k = k;
+    
+    pthread_t *threads = (pthread_t*)malloc(n_threads * sizeof(pthread_t));
+    selecao->trechos = (TrechoRadix*)aligned_alloc(LINHA_CACHE, n_threads * sizeof(TrechoRadix));
+    if (threads == NULL || selecao->trechos == NULL) {
+        fprintf(stderr, "Erro ao alocar memória para a seleção paralela\n");
+        exit(EXIT_FAILURE);
+    }
+    pthread_barrier_init(&selecao->barreira, NULL, n_threads);
+    
+    // Trechos contíguos; a thread que chama processa o trecho 0
+    for (int t = 0; t < n_threads; t++) {
+        selecao->trechos[t].selecao = selecao;
+        selecao->trechos[t].inicio = tamanho * t / n_threads;
+        selecao->trechos[t].fim = tamanho * (t + 1) / n_threads;
+    }
+    for (int t = 1; t < n_threads; t++) {
+        int ret = pthread_create(&threads[t], NULL, contar_digitos, &selecao->trechos[t]);
+        if (ret != 0) {
+            // A barreira espera n_threads: sem todas, não há como continuar
+            fprintf(stderr, "Erro ao criar thread da seleção: %d\n", ret);
+            exit(EXIT_FAILURE);
+        }
+    }
+    contar_digitos(&selecao->trechos[0]);
+    for (int t = 1; t < n_threads; t++) {
+        pthread_join(threads[t], NULL);
+    }
+    
+    pthread_barrier_destroy(&selecao->barreira);
+    free(selecao->trechos);
+    free(threads);
+}
+
+int selecao_paralela(const int *valores, size_t tamanho, size_t k, int n_threads) {
+    n_threads = threads_selecao(tamanho, n_threads);
+    if (n_threads == 1) {
+        return selecao_elemento(valores, tamanho, k);
+    }
+    
+    SelecaoRadix selecao;
+    selecao.valores = valores;
+    selecao.valores_double = NULL;
+    selecao.digitos = &DIGITOS_INT;
+    selecao_radix(&selecao, tamanho, k, n_threads);
+    
+    // Todos os 32 bits fixados: a chave é o próprio elemento
+    return (int)((uint32_t)selecao.prefixo ^ 0x80000000u);
+}
+
+double mediana_paralela(const int *valores, size_t tamanho, int n_threads) {
+    // Sequencial: uma única seleção já entrega os dois elementos do meio
+    n_threads = threads_selecao(tamanho, n_threads);
+    if (n_threads == 1) {
+        return mediana_selecao(valores, tamanho);
+    }
+    
+    if (tamanho % 2 == 0) {
+        // Par: média dos dois do meio
+        int menor = selecao_paralela(valores, tamanho, tamanho/2 - 1, n_threads);
+        int maior = selecao_paralela(valores, tamanho, tamanho/2, n_threads);
+        return ((double)menor + maior) / 2.0;
+    }
+    
+    // Ímpar: elemento do meio
+    return selecao_paralela(valores, tamanho, tamanho/2, n_threads);
+}
+
+// Seleção sequencial de double sobre uma cópia (k e, se 'k_anterior' não
+// for NULL, também o elemento k - 1, que fica à esquerda)
+static double selecao_double_copia(const double *valores, size_t tamanho, size_t k,
+                                   double *k_anterior) {
+    double *copia = (double*)malloc(tamanho * sizeof(double));
+    if (copia == NULL) {
+        fprintf(stderr, "Erro ao alocar memória para a seleção\n");
+        exit(EXIT_FAILURE);
+    }
+    memcpy(copia, valores, tamanho * sizeof(double));
+    
+    double elemento = selecao_double(copia, tamanho, k);
+    if (k_anterior != NULL) {
+        double anterior = copia[0];
+        for (size_t i = 1; i < k; i++) {
+            if (copia[i] > anterior) anterior = copia[i];
+        }
+        *k_anterior = anterior;
+    }
+    
+    free(copia);
+    return elemento;
+}
+
+double selecao_paralela_double(const double *valores, size_t tamanho, size_t k, int n_threads) {
+    n_threads = threads_selecao(tamanho, n_threads);
+    if (n_threads == 1) {
+        return selecao_double_copia(valores, tamanho, k, NULL);
+    }
+    
+    SelecaoRadix selecao;
+    selecao.valores = NULL;
+    selecao.valores_double = valores;
+    selecao.digitos = &DIGITOS_DOUBLE;
+    selecao_radix(&selecao, tamanho, k, n_threads);
+    
+    // Todos os 64 bits fixados: desfaz o mapeamento da chave
+    return double_da_chave(selecao.prefixo);
+}
+
+double mediana_paralela_double(const double *valores, size_t tamanho, int n_threads) {
+    if (tamanho == 0) return NAN;
+    
+    n_threads = threads_selecao(tamanho, n_threads);
+    if (n_threads == 1) {
+        double anterior;
+        double mediana = selecao_double_copia(valores, tamanho, tamanho / 2,
+                                              tamanho % 2 == 0 ? &anterior : NULL);
+        return tamanho % 2 == 0 ? (anterior + mediana) / 2.0 : mediana;
+    }
+    
+    if (tamanho % 2 == 0) {
+        double menor = selecao_paralela_double(valores, tamanho, tamanho/2 - 1, n_threads);
+        double maior = selecao_paralela_double(valores, tamanho, tamanho/2, n_threads);
+        return (menor + maior) / 2.0;
+    }
+    return selecao_paralela_double(valores, tamanho, tamanho/2, n_threads);
+}
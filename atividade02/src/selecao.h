@@ -0,0 +1,68 @@
+/*
+ * Instituição: Universidade Federal da Paraíba
+ * Disciplina: Sistemas Operacionais I
+ * Unidade 1 - Atividade 2
+ *
+ * Autor: Rodrigo Monteiro Fortes de Oliveira, 20240097664
+ *
+ * Nome do Módulo: selecao.h
+ *
+ * Descrição:
+ *     Estatísticas de ordem (k-ésimo menor elemento, com k = 0 para o
+ *     mínimo) quando o histograma não se aplica: domínio ilimitado ou
+ *     valores de ponto flutuante. A seleção sequencial é um introselect
+ *     (quickselect com partição em três vias e, se a recursão passar de
+ *     2·log2(n) níveis, ordenação do trecho restante), O(n) esperado e
+ *     feito no próprio buffer de trabalho. A versão paralela é uma
+ *     seleção radix: cada passada conta, por thread, os dígitos dos
+ *     valores que ainda podem ser a resposta e fixa mais bits dela, sem
+ *     copiar nem mover o vetor.
+ */
+
+#ifndef SELECAO_H
+#define SELECAO_H
+
+#include <stddef.h>
+
+// Abaixo deste tamanho a versão paralela recorre à sequencial
+#define SELECAO_MINIMO_PARALELO (1 << 16)
+
+// k-ésimo elemento de 'trabalho', reorganizando-o: ao final trabalho[k]
+// é o elemento, os anteriores são <= e os seguintes >= a ele
+int selecao_int(int *trabalho, size_t tamanho, size_t k);
+
+// Idem para double (sem NaN)
+double selecao_double(double *trabalho, size_t tamanho, size_t k);
+
+// Reserva e toca, fora da medição, a área de trabalho das cópias feitas
+// pelas seleções (mediana_selecao, selecao_elemento e quantis exatos),
+// para 'tamanho' valores. Retorna 0 em caso de sucesso.
+int selecao_reservar(size_t tamanho);
+
+// Área de trabalho para 'tamanho' valores: a reservada, se couber e
+// estiver livre (uma chamada por vez), ou uma nova alocação. Encerra o
+// programa se faltar memória.
+int* selecao_trabalho(size_t tamanho);
+
+// Devolve a área obtida com selecao_trabalho
+void selecao_devolver(int *trabalho);
+
+// k-ésimo elemento sem alterar 'valores' (seleção sobre uma cópia)
+int selecao_elemento(const int *valores, size_t tamanho, size_t k);
+
+// Mediana por seleção sobre uma cópia (O(n) esperado; NAN se vazio)
+double mediana_selecao(const int *valores, size_t tamanho);
+
+// k-ésimo elemento por seleção radix com n_threads threads
+// (n_threads <= 0: uma por núcleo)
+int selecao_paralela(const int *valores, size_t tamanho, size_t k, int n_threads);
+
+// Mediana por seleção radix paralela
+double mediana_paralela(const int *valores, size_t tamanho, int n_threads);
+
+// Idem para double (sem NaN): a chave de 64 bits preserva a ordem
+// (bit de sinal ligado nos positivos, todos os bits invertidos nos negativos)
+double selecao_paralela_double(const double *valores, size_t tamanho, size_t k, int n_threads);
+double mediana_paralela_double(const double *valores, size_t tamanho, int n_threads);
+
+#endif
@@ -0,0 +1,412 @@
+/*
+ * Instituição: Universidade Federal da Paraíba
+ * Disciplina: Sistemas Operacionais I
+ * Unidade 1 - Atividade 2
+ *
+ * Autor: Rodrigo Monteiro Fortes de Oliveira, 20240097664
+ *
+ * Nome do Programa: series.c
+ *
+ * Descrição:
+ *     Calcula média, mediana e desvio padrão de muitas séries
+ *     independentes em uma única execução (lote.h), em vez de um
+ *     processo por série. Os N valores (padrão: 1.000.000 entre 0 e 100)
+ *     formam um único vetor, dividido em -b séries (padrão: 1.000) com
+ *     tamanhos sorteados por -D:
+ *
+ *       fixo      todas do mesmo tamanho;
+ *       uniforme  tamanhos uniformes entre 0 e o dobro da média (padrão);
+ *       cauda     cauda pesada (Pareto, alfa 1,2): poucas séries muito
+ *                 longas, onde o balanceamento pelo tamanho faz diferença.
+ *
+ *     Com -f os valores vêm de um arquivo binário do converter; com -i
+ *     indice.txt as séries são as do índice (uma por linha:
+ *     "deslocamento tamanho"), senão o arquivo é dividido como acima.
+ *
+ *     As séries são distribuídas a -t threads (padrão: uma por núcleo),
+ *     as maiores primeiro; -e usa a ordem de entrada, para comparar. Cada
+ *     série produz uma linha no CSV de -o (padrão: resultados_series.csv).
+ *     Ao final são exibidas a vazão em séries e valores por segundo e a
+ *     carga de cada thread.
+ *
+ *     -v, -S, -w e -A como nos demais programas. ESTATISTICAS_CONTADORES
+ *     e ESTATISTICAS_RASTRO no ambiente ligam os contadores por fase e a
+ *     linha do tempo.
+ *
+ * Uso:
+ *     ./series [-n quantidade] [-b séries] [-D fixo|uniforme|cauda] [-t threads] [-e]
+ *              [-v min:max] [-f arquivo.bin [-i indice.txt]] [-S semente] [-w]
+ *              [-A afinidade] [-o saida.csv]
+ *
+ * Compilação:
+ *     gcc -O2 -pthread series.c lote.c estatisticas.c simd.c selecao.c esboco.c vetor.c dados.c gerador.c contadores.c rastro.c afinidade.c -o series -lm
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <unistd.h>
+#include "estatisticas.h"
+#include "simd.h"
+#include "vetor.h"
+#include "dados.h"
+#include "gerador.h"
+#include "lote.h"
+#include "contadores.h"
+#include "rastro.h"
+#include "afinidade.h"
+#include "tempo.h"
+
+#define N_ENTRADAS 1000000
+#define N_SERIES 1000
+#define MIN_VALOR 0
+#define MAX_VALOR 100
+
+// Expoente da distribuição de Pareto em -D cauda
+#define ALFA_CAUDA 1.2
+
+// Sorteia os tamanhos de 'n_series' séries que somam 'total' (cada uma
+// com pelo menos um valor) e preenche os deslocamentos, lado a lado.
+// Retorna 0 em caso de sucesso.
+int sortear_tamanhos(const char *distribuicao, size_t total, size_t n_series, uint64_t semente,
+                     size_t *deslocamentos, size_t *tamanhos) {
+    double *pesos = (double*)malloc(n_series * sizeof(double));
+    if (pesos == NULL) {
+        fprintf(stderr, "Erro ao alocar memória para os tamanhos\n");
+        return -1;
+    }
+    
+    // Fluxo próprio: os valores das séries não mudam com a distribuição
+    Gerador gerador;
+    gerador_iniciar(&gerador, semente ^ 0x5e41e5ULL);
+    
+    double soma = 0.0;
+    for (size_t s = 0; s < n_series; s++) {
+        // Uniforme em (0, 1]
+        double u = ((gerador_proximo(&gerador) >> 11) + 1) * 0x1.0p-53;
+        if (strcmp(distribuicao, "fixo") == 0) {
+            pesos[s] = 1.0;
+        } else if (strcmp(distribuicao, "uniforme") == 0) {
+            pesos[s] = u;
+        } else if (strcmp(distribuicao, "cauda") == 0) {
+            pesos[s] = pow(u, -1.0 / ALFA_CAUDA);
+        } else {
+            fprintf(stderr, "Distribuição inválida: %s (fixo, uniforme ou cauda)\n", distribuicao);
+            free(pesos);
+            return -1;
+        }
+        soma += pesos[s];
+    }
+    
+    // Um valor por série e o restante na proporção dos pesos; o que sobra
+    // do arredondamento vai para as primeiras séries
+    size_t restante = total - n_series;
+    size_t distribuidos = 0;
+    for (size_t s = 0; s < n_series; s++) {
+        tamanhos[s] = 1 + (size_t)(restante * (pesos[s] / soma));
+        distribuidos += tamanhos[s] - 1;
+    }
+    for (size_t s = 0; distribuidos < restante; s = (s + 1) % n_series) {
+        tamanhos[s]++;
+        distribuidos++;
+    }
+    
+    size_t deslocamento = 0;
+    for (size_t s = 0; s < n_series; s++) {
+        deslocamentos[s] = deslocamento;
+        deslocamento += tamanhos[s];
+    }
+    
+    free(pesos);
+    return 0;
+}
+
+// Lê o índice de séries ("deslocamento tamanho" por linha, '#' inicia
+// comentário) de um vetor com 'total' valores. Retorna a quantidade de
+// séries (com as colunas alocadas em *deslocamentos e *tamanhos) ou -1.
+long ler_indice(const char *caminho, size_t total, size_t **deslocamentos, size_t **tamanhos) {
+    FILE *arquivo = fopen(caminho, "r");
+    if (arquivo == NULL) {
+        perror("Erro ao abrir o índice de séries");
+        return -1;
+    }
+    
+    size_t capacidade = 1024, quantidade = 0;
+    *deslocamentos = (size_t*)malloc(capacidade * sizeof(size_t));
+    *tamanhos = (size_t*)malloc(capacidade * sizeof(size_t));
+    
+    char linha[256];
+    int numero = 0;
+    while (*deslocamentos != NULL && *tamanhos != NULL && fgets(linha, sizeof(linha), arquivo) != NULL) {
+        numero++;
+        char *comentario = strchr(linha, '#');
+        if (comentario != NULL) *comentario = '\0';
+    
+        unsigned long long deslocamento, tamanho;
+        char resto;
+        int lidos = sscanf(linha, "%llu %llu %c", &deslocamento, &tamanho, &resto);
+        if (lidos <= 0) continue;
+        if (lidos != 2 || deslocamento > total || tamanho > total - deslocamento) {
+            fprintf(stderr, "Linha %d do índice inválida (esperado \"deslocamento tamanho\" dentro de %zu valores)\n",
+                    numero, total);
+            fclose(arquivo);
+            return -1;
+        }
+    
+        if (quantidade == capacidade) {
+            capacidade *= 2;
+            *deslocamentos = (size_t*)realloc(*deslocamentos, capacidade * sizeof(size_t));
+            *tamanhos = (size_t*)realloc(*tamanhos, capacidade * sizeof(size_t));
+            if (*deslocamentos == NULL || *tamanhos == NULL) break;
+        }
+        (*deslocamentos)[quantidade] = deslocamento;
+        (*tamanhos)[quantidade] = tamanho;
+        quantidade++;
+    }
+    fclose(arquivo);
+    
+    if (*deslocamentos == NULL || *tamanhos == NULL) {
+        fprintf(stderr, "Erro ao alocar memória para o índice\n");
+        return -1;
+    }
+    return (long)quantidade;
+}
+
+int main(int argc, char *argv[]) {
+    size_t n_entradas = N_ENTRADAS;
+    size_t n_series = N_SERIES;
+    const char *distribuicao = "uniforme";
+    Dominio dominio = { MIN_VALOR, MAX_VALOR };
+    const char *arquivo = NULL;
+    const char *arquivo_indice = NULL;
+    const char *arquivo_saida = "resultados_series.csv";
+    uint64_t semente = gerador_semente_padrao();
+    int dominio_informado = 0;
+    int armazenamento_largo = 0;
+    int ordem = LOTE_ORDEM_TAMANHO;
+    Afinidade afinidade = AFINIDADE_NENHUMA;
+    long nucleos = sysconf(_SC_NPROCESSORS_ONLN);
+    int n_threads = nucleos > 0 ? (int)nucleos : 1;
+    
+    // Lê as opções da linha de comando
+    int opcao;
+    while ((opcao = getopt(argc, argv, "n:b:D:t:ev:f:i:S:wA:o:")) != -1) {
+        switch (opcao) {
+            case 'n':
+                n_entradas = strtoull(optarg, NULL, 10);
+                break;
+            case 'b':
+                n_series = strtoull(optarg, NULL, 10);
+                break;
+            case 'D':
+                distribuicao = optarg;
+                break;
+            case 't':
+                n_threads = atoi(optarg);
+                break;
+            case 'e':
+                ordem = LOTE_ORDEM_ENTRADA;
+                break;
+            case 'v':
+                if (dominio_ler(optarg, &dominio) != 0) {
+                    fprintf(stderr, "Intervalo inválido: %s (use min:max)\n", optarg);
+                    return EXIT_FAILURE;
+                }
+                dominio_informado = 1;
+                break;
+            case 'f':
+                arquivo = optarg;
+                break;
+            case 'i':
+                arquivo_indice = optarg;
+                break;
+            case 'S':
+                semente = strtoull(optarg, NULL, 10);
+                break;
+            case 'w':
+                armazenamento_largo = 1;
+                break;
+            case 'A':
+                if (afinidade_ler(optarg, &afinidade) != 0) {
+                    fprintf(stderr, "Afinidade inválida: %s (compacto, espalhado ou lista, ex.: 0,2,4-7)\n", optarg);
+                    return EXIT_FAILURE;
+                }
+                break;
+            case 'o':
+                arquivo_saida = optarg;
+                break;
+            default:
+                fprintf(stderr, "Uso: %s [-n quantidade] [-b séries] [-D fixo|uniforme|cauda] [-t threads] [-e] "
+                        "[-v min:max] [-f arquivo.bin [-i indice.txt]] [-S semente] [-w] [-A afinidade] "
+                        "[-o saida.csv]\n", argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+    
+    if (n_threads < 1) {
+        fprintf(stderr, "Quantidade de threads inválida\n");
+        return EXIT_FAILURE;
+    }
+    if (arquivo_indice != NULL && arquivo == NULL) {
+        fprintf(stderr, "A opção -i exige -f\n");
+        return EXIT_FAILURE;
+    }
+    
+    // Contadores e rastro por fase, se pedidos pelo ambiente
+    // (ESTATISTICAS_CONTADORES e ESTATISTICAS_RASTRO)
+    contadores_abrir();
+    rastro_iniciar();
+    rastro_nomear("principal");
+    
+    // Conjunto preparado com o converter: mapeado sem conversão nem cópia.
+    // Sem -v, o intervalo gravado no cabeçalho define o histograma.
+    Vetor vetor;
+    if (arquivo != NULL) {
+        if (dados_mapear(&vetor, arquivo, dominio_informado ? NULL : &dominio) != 0) {
+            return EXIT_FAILURE;
+        }
+        n_entradas = vetor.tamanho;
+    }
+    
+    // Colunas das séries: do índice ou sorteadas
+    size_t *deslocamentos = NULL;
+    size_t *tamanhos = NULL;
+    if (arquivo_indice != NULL) {
+        long lidas = ler_indice(arquivo_indice, n_entradas, &deslocamentos, &tamanhos);
+        if (lidas < 0) {
+            return EXIT_FAILURE;
+        }
+        n_series = (size_t)lidas;
+    } else {
+        if (n_series > n_entradas) n_series = n_entradas;
+        deslocamentos = (size_t*)malloc((n_series > 0 ? n_series : 1) * sizeof(size_t));
+        tamanhos = (size_t*)malloc((n_series > 0 ? n_series : 1) * sizeof(size_t));
+        if (deslocamentos == NULL || tamanhos == NULL) {
+            fprintf(stderr, "Erro ao alocar memória para as séries\n");
+            return EXIT_FAILURE;
+        }
+        if (n_series > 0 &&
+            sortear_tamanhos(distribuicao, n_entradas, n_series, semente, deslocamentos, tamanhos) != 0) {
+            return EXIT_FAILURE;
+        }
+    }
+    
+    if (n_entradas == 0 || n_series == 0) {
+        fprintf(stderr, "Quantidade de valores ou de séries inválida\n");
+        return EXIT_FAILURE;
+    }
+    
+    // Sem arquivo: um único vetor com todas as séries, no menor tipo do intervalo
+    if (arquivo == NULL) {
+        TipoElemento tipo = armazenamento_largo ? ELEMENTO_INT32 : dominio_tipo_elemento(dominio);
+        if (vetor_alocar(&vetor, n_entradas, tipo, 0) != 0) {
+            return EXIT_FAILURE;
+        }
+    
+        // Preenche em paralelo com valores do intervalo [min, max] (sem viés)
+        contadores_entrar("geracao");
+        if (gerador_preencher(vetor.valores, vetor.tipo, n_entradas, dominio, semente, 0, NULL) != 0) {
+            return EXIT_FAILURE;
+        }
+        contadores_sair();
+    }
+    
+    ResultadoSerie *resultados = (ResultadoSerie*)malloc(n_series * sizeof(ResultadoSerie));
+    CargaTrabalhador *cargas = (CargaTrabalhador*)calloc(n_threads, sizeof(CargaTrabalhador));
+    if (resultados == NULL || cargas == NULL) {
+        fprintf(stderr, "Erro ao alocar memória para os resultados\n");
+        return EXIT_FAILURE;
+    }
+    
+    // Menor e maior série, para o cabeçalho, e valores percorridos: com
+    // -i as séries podem cobrir só parte do arquivo ou se sobrepor
+    size_t menor = tamanhos[0], maior = tamanhos[0];
+    size_t valores_series = 0;
+    for (size_t s = 0; s < n_series; s++) {
+        if (tamanhos[s] < menor) menor = tamanhos[s];
+        if (tamanhos[s] > maior) maior = tamanhos[s];
+        valores_series += tamanhos[s];
+    }
+    
+    printf("========================================\n");
+    printf("  LOTE DE SÉRIES COM %d THREADS\n", n_threads);
+    printf("========================================\n\n");
+    printf("Núcleos SIMD: %s\n", simd_nucleos()->nome);
+    printf("Armazenamento: %s, %zu B por valor\n", elemento_nome(vetor.tipo), elemento_bytes(vetor.tipo));
+    afinidade_exibir(&afinidade);
+    printf("Séries: %zu (%s), de %zu a %zu valores\n", n_series,
+           arquivo_indice != NULL ? "índice" : distribuicao, menor, maior);
+    printf("Distribuição às threads: %s\n\n",
+           ordem == LOTE_ORDEM_TAMANHO ? "maiores primeiro" : "ordem de entrada");
+    
+    // Começa a medir o tempo
+    struct timespec inicio, fim;
+    marcar_instante(&inicio);
+    contadores_entrar("lote");
+    
+    ConjuntoSeries series = { vetor.valores, vetor.tipo, deslocamentos, tamanhos, n_series };
+    if (lote_processar(&series, dominio, n_threads, ordem, &afinidade, resultados, cargas) != 0) {
+        return EXIT_FAILURE;
+    }
+    
+    // Para de medir o tempo
+    contadores_sair();
+    marcar_instante(&fim);
+    double tempo_total = diferenca_ms(inicio, fim);
+    
+    // Uma linha por série
+    FILE *csv = fopen(arquivo_saida, "w");
+    if (csv == NULL) {
+        perror("Erro ao abrir o arquivo de saída");
+        return EXIT_FAILURE;
+    }
+    fprintf(csv, "Serie,Deslocamento,Tamanho,Media,Mediana,Desvio\n");
+    for (size_t s = 0; s < n_series; s++) {
+        fprintf(csv, "%zu,%zu,%zu,%.6f,%.6f,%.6f\n", s, deslocamentos[s], tamanhos[s],
+                resultados[s].media, resultados[s].mediana, resultados[s].desvio);
+    }
+    fclose(csv);
+    
+    // Carga das threads: o tempo da mais demorada define o do lote
+    double carga_minima = cargas[0].tempo_ms, carga_maxima = cargas[0].tempo_ms, carga_total = 0.0;
+    for (int t = 0; t < n_threads; t++) {
+        if (cargas[t].tempo_ms < carga_minima) carga_minima = cargas[t].tempo_ms;
+        if (cargas[t].tempo_ms > carga_maxima) carga_maxima = cargas[t].tempo_ms;
+        carga_total += cargas[t].tempo_ms;
+    }
+    
+    // Exibe resultados estatísticos
+    printf("--- RESULTADOS ESTATÍSTICOS ---\n");
+    printf("Séries processadas: %zu\n", n_series);
+    printf("Quantidade de valores processados: %zu\n", valores_series);
+    if (arquivo == NULL) {
+        printf("Semente do gerador: %llu\n", (unsigned long long)semente);
+    }
+    printf("Média aritmética (série 0): %.6f\n", resultados[0].media);
+    printf("Mediana (série 0): %.6f\n", resultados[0].mediana);
+    printf("Desvio padrão populacional (série 0): %.6f\n", resultados[0].desvio);
+    printf("Resultados por série gravados em %s\n\n", arquivo_saida);
+    
+    // Exibe métricas de tempo
+    printf("--- MÉTRICAS DE TEMPO ---\n");
+    printf("Tempo total de execução: %.3f ms\n", tempo_total);
+    printf("Vazão: %.1f séries/s (%.3e valores/s)\n",
+           n_series / (tempo_total / 1000.0), valores_series / (tempo_total / 1000.0));
+    printf("Carga por thread: mín %.3f ms, máx %.3f ms (máx/média %.2f)\n", carga_minima,
+           carga_maxima, carga_total > 0 ? carga_maxima / (carga_total / n_threads) : 1.0);
+    contadores_exibir();
+    contadores_fechar();
+    
+    free(resultados);
+    free(cargas);
+    free(deslocamentos);
+    free(tamanhos);
+    vetor_liberar(&vetor);
+    
+    printf("\n========================================\n");
+    printf("  Execução finalizada com sucesso\n");
+    printf("========================================\n");
+    
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,627 @@
+/*
+ * Instituição: Universidade Federal da Paraíba
+ * Disciplina: Sistemas Operacionais I
+ * Unidade 1 - Atividade 2
+ *
+ * Autor: Rodrigo Monteiro Fortes de Oliveira, 20240097664
+ *
+ * Nome do Módulo: simd.c
+ *
+ * Descrição:
+ *     Implementação dos núcleos declarados em simd.h. Cada versão
+ *     vetorizada é compilada com __attribute__((target)), de modo que o
+ *     programa inteiro continua compilando sem -mavx2 e só usa as
+ *     instruções que o processador anuncia.
+ *
+ *     A soma dos quadrados é exata: cada quadrado (até 2^62) é separado
+ *     em 32 bits altos e baixos, acumulados em faixas de 64 bits que
+ *     não transbordam dentro de um bloco de MOMENTOS_BLOCO valores; ao
+ *     fim do bloco as faixas são somadas em __int128.
+ *
+ *     Nos núcleos de 8 e 16 bits os quadrados cabem em 32 bits: em 8
+ *     bits, _mm_madd_epi16 soma pares de quadrados em faixas de 32
+ *     bits, esvaziadas a cada MOMENTOS_BLOCO_ESTREITO iterações, e a
+ *     soma vem de _mm_sad_epu8; em 16 bits os valores são estendidos
+ *     para 32 bits e multiplicados com _mm_mul_epu32. A versão AVX-512
+ *     usa os núcleos estreitos de AVX2 (os de 512 bits pediriam AVX512BW).
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "simd.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define SIMD_X86 1
+#endif
+
+// Valores por bloco antes de esvaziar as faixas de 64 bits
+#define MOMENTOS_BLOCO (1 << 24)
+
+// Iterações antes de esvaziar as faixas de 32 bits dos núcleos estreitos
+// (cada faixa recebe no máximo 4·65535 ou 2·65535 por iteração)
+#define MOMENTOS_BLOCO_ESTREITO 8192
+
+static void momentos_escalar(const int *valores, size_t tamanho, Momentos *momentos) {
+    long long soma = 0;
+    __int128 soma_quadrados = 0;
+    int minimo = momentos->minimo;
+    int maximo = momentos->maximo;
+    
+    for (size_t i = 0; i < tamanho; i++) {
+        int valor = valores[i];
+        soma += valor;
+        soma_quadrados += (long long)valor * valor;
+        if (valor < minimo) minimo = valor;
+        if (valor > maximo) maximo = valor;
+    }
+    
+    momentos->soma += soma;
+    momentos->soma_quadrados += soma_quadrados;
+    momentos->minimo = minimo;
+    momentos->maximo = maximo;
+}
+
+static size_t histograma_escalar(const int *valores, size_t tamanho, size_t *histograma,
+                                 int base, size_t classes) {
+    for (size_t i = 0; i < tamanho; i++) {
+        size_t indice = (size_t)((unsigned int)valores[i] - (unsigned int)base);
+        if (indice >= classes) return i;
+        histograma[indice]++;
+    }
+    return tamanho;
+}
+
+// Momentos de valores sem sinal de 8 ou 16 bits; o quadrado de um
+// valor de 16 bits ainda cabe em 64 bits sem sinal
+#define DEFINIR_MOMENTOS_ESTREITOS(nome, tipo)                                  \
+static void nome(const tipo *valores, size_t tamanho, Momentos *momentos) {     \
+    unsigned long long soma = 0;                                                \
+    __int128 soma_quadrados = 0;                                                \
+    int minimo = momentos->minimo;                                              \
+    int maximo = momentos->maximo;                                              \
+                                                                                \
+    for (size_t i = 0; i < tamanho; i++) {                                      \
+        int valor = valores[i];                                                 \
+        soma += valor;                                                          \
+        soma_quadrados += (unsigned long long)valor * valor;                    \
+        if (valor < minimo) minimo = valor;                                     \
+        if (valor > maximo) maximo = valor;                                     \
+    }                                                                           \
+                                                                                \
+    momentos->soma += soma;                                                     \
+    momentos->soma_quadrados += soma_quadrados;                                 \
+    momentos->minimo = minimo;                                                  \
+    momentos->maximo = maximo;                                                  \
+}
+
+DEFINIR_MOMENTOS_ESTREITOS(momentos_u8_escalar, uint8_t)
+DEFINIR_MOMENTOS_ESTREITOS(momentos_u16_escalar, uint16_t)
+
+static const NucleosSimd NUCLEOS_ESCALAR = {
+    "escalar", momentos_escalar, histograma_escalar,
+    momentos_u8_escalar, momentos_u16_escalar
+};
+
+#ifdef SIMD_X86
+
+// Soma as faixas de um bloco aos momentos: Σx, Σ(q >> 32) e Σ(q & 0xffffffff)
+static void esvaziar_faixas(Momentos *momentos, const int64_t *soma,
+                           const uint64_t *altos, const uint64_t *baixos, int faixas) {
+    for (int k = 0; k < faixas; k++) {
+        momentos->soma += soma[k];
+        momentos->soma_quadrados += ((__int128)altos[k] << 32) + baixos[k];
+    }
+}
+
+// --- SSE2 (4 valores por iteração) ---
+
+__attribute__((target("sse2")))
+static void momentos_sse2(const int *valores, size_t tamanho, Momentos *momentos) {
+    const __m128i mascara_baixa = _mm_set1_epi64x(0xffffffffLL);
+    __m128i minimo = _mm_set1_epi32(momentos->minimo);
+    __m128i maximo = _mm_set1_epi32(momentos->maximo);
+    size_t i = 0;
+    
+    while (tamanho - i >= 4) {
+        size_t fim = tamanho - i > MOMENTOS_BLOCO ? i + MOMENTOS_BLOCO : tamanho;
+        __m128i soma = _mm_setzero_si128();
+        __m128i altos = _mm_setzero_si128();
+        __m128i baixos = _mm_setzero_si128();
+    
+        for (; i + 4 <= fim; i += 4) {
+            __m128i x = _mm_loadu_si128((const __m128i*)(valores + i));
+            __m128i sinal = _mm_srai_epi32(x, 31);
+    
+            // Mínimo e máximo por seleção (SSE2 não tem min/max de 32 bits)
+            __m128i menor = _mm_cmpgt_epi32(minimo, x);
+            minimo = _mm_or_si128(_mm_and_si128(menor, x), _mm_andnot_si128(menor, minimo));
+            __m128i maior = _mm_cmpgt_epi32(x, maximo);
+            maximo = _mm_or_si128(_mm_and_si128(maior, x), _mm_andnot_si128(maior, maximo));
+    
+            // Extensão de sinal para 64 bits
+            soma = _mm_add_epi64(soma, _mm_add_epi64(_mm_unpacklo_epi32(x, sinal),
+                                                     _mm_unpackhi_epi32(x, sinal)));
+    
+            // x² = |x|², com o produto sem sinal de 32x32 -> 64 bits
+            __m128i absoluto = _mm_sub_epi32(_mm_xor_si128(x, sinal), sinal);
+            __m128i impares = _mm_srli_epi64(absoluto, 32);
+            __m128i quadrados = _mm_add_epi64(_mm_mul_epu32(absoluto, absoluto),
+                                              _mm_mul_epu32(impares, impares));
+            altos = _mm_add_epi64(altos, _mm_srli_epi64(quadrados, 32));
+            baixos = _mm_add_epi64(baixos, _mm_and_si128(quadrados, mascara_baixa));
+        }
+    
+        int64_t faixa_soma[2];
+        uint64_t faixa_altos[2], faixa_baixos[2];
+        _mm_storeu_si128((__m128i*)faixa_soma, soma);
+        _mm_storeu_si128((__m128i*)faixa_altos, altos);
+        _mm_storeu_si128((__m128i*)faixa_baixos, baixos);
+        esvaziar_faixas(momentos, faixa_soma, faixa_altos, faixa_baixos, 2);
+    }
+    
+    int faixa_min[4], faixa_max[4];
+    _mm_storeu_si128((__m128i*)faixa_min, minimo);
+    _mm_storeu_si128((__m128i*)faixa_max, maximo);
+    for (int k = 0; k < 4; k++) {
+        if (faixa_min[k] < momentos->minimo) momentos->minimo = faixa_min[k];
+        if (faixa_max[k] > momentos->maximo) momentos->maximo = faixa_max[k];
+    }
+    
+    momentos_escalar(valores + i, tamanho - i, momentos);
+}
+
+__attribute__((target("sse2")))
+static size_t histograma_sse2(const int *valores, size_t tamanho, size_t *histograma,
+                              int base, size_t classes) {
+    // Comparação sem sinal: inverte o bit de sinal dos dois lados
+    const __m128i bit_sinal = _mm_set1_epi32(INT32_MIN);
+    const __m128i vetor_base = _mm_set1_epi32(base);
+    const __m128i limite = _mm_set1_epi32((int)((unsigned int)(classes - 1) ^ 0x80000000u));
+    size_t i = 0;
+    
+    for (; i + 4 <= tamanho; i += 4) {
+        __m128i x = _mm_loadu_si128((const __m128i*)(valores + i));
+        __m128i indice = _mm_sub_epi32(x, vetor_base);
+        __m128i fora = _mm_cmpgt_epi32(_mm_xor_si128(indice, bit_sinal), limite);
+        if (_mm_movemask_epi8(fora) != 0) {
+            return i + histograma_escalar(valores + i, 4, histograma, base, classes);
+        }
+    
+        for (int k = 0; k < 4; k++) {
+            histograma[(unsigned int)valores[i + k] - (unsigned int)base]++;
+        }
+    }
+    
+    return i + histograma_escalar(valores + i, tamanho - i, histograma, base, classes);
+}
+
+// Mínimo e máximo das faixas de 8 bits somados aos momentos
+static void esvaziar_extremos(Momentos *momentos, const uint8_t *faixa_min,
+                              const uint8_t *faixa_max, int faixas) {
+    for (int k = 0; k < faixas; k++) {
+        if (faixa_min[k] < momentos->minimo) momentos->minimo = faixa_min[k];
+        if (faixa_max[k] > momentos->maximo) momentos->maximo = faixa_max[k];
+    }
+}
+
+__attribute__((target("sse2")))
+static void momentos_u8_sse2(const uint8_t *valores, size_t tamanho, Momentos *momentos) {
+    const __m128i zero = _mm_setzero_si128();
+    __m128i minimo = _mm_set1_epi8((char)0xff);
+    __m128i maximo = zero;
+    size_t i = 0;
+    
+    while (tamanho - i >= 16) {
+        size_t fim = (tamanho - i) / 16 > MOMENTOS_BLOCO_ESTREITO ?
+                     i + 16 * MOMENTOS_BLOCO_ESTREITO : tamanho;
+        __m128i soma = zero;
+        __m128i quadrados = zero;
+    
+        for (; i + 16 <= fim; i += 16) {
+            __m128i x = _mm_loadu_si128((const __m128i*)(valores + i));
+            minimo = _mm_min_epu8(minimo, x);
+            maximo = _mm_max_epu8(maximo, x);
+    
+            // Soma das diferenças absolutas contra zero: dois totais de 8 bytes
+            soma = _mm_add_epi64(soma, _mm_sad_epu8(x, zero));
+    
+            __m128i baixa = _mm_unpacklo_epi8(x, zero);
+            __m128i alta = _mm_unpackhi_epi8(x, zero);
+            quadrados = _mm_add_epi32(quadrados, _mm_add_epi32(_mm_madd_epi16(baixa, baixa),
+                                                               _mm_madd_epi16(alta, alta)));
+        }
+    
+        uint64_t faixa_soma[2];
+        uint32_t faixa_quadrados[4];
+        _mm_storeu_si128((__m128i*)faixa_soma, soma);
+        _mm_storeu_si128((__m128i*)faixa_quadrados, quadrados);
+        momentos->soma += faixa_soma[0] + faixa_soma[1];
+        for (int k = 0; k < 4; k++) {
+            momentos->soma_quadrados += faixa_quadrados[k];
+        }
+    }
+    
+    uint8_t faixa_min[16], faixa_max[16];
+    _mm_storeu_si128((__m128i*)faixa_min, minimo);
+    _mm_storeu_si128((__m128i*)faixa_max, maximo);
+    if (i > 0) {
+        esvaziar_extremos(momentos, faixa_min, faixa_max, 16);
+    }
+    
+    momentos_u8_escalar(valores + i, tamanho - i, momentos);
+}
+
+__attribute__((target("sse2")))
+static void momentos_u16_sse2(const uint16_t *valores, size_t tamanho, Momentos *momentos) {
+    // SSE2 só tem mínimo/máximo de 16 bits com sinal: desloca por 0x8000
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i desvio = _mm_set1_epi16((short)0x8000);
+    __m128i minimo = _mm_set1_epi16(0x7fff);
+    __m128i maximo = _mm_set1_epi16((short)0x8000);
+    size_t i = 0;
+    
+    while (tamanho - i >= 8) {
+        size_t fim = (tamanho - i) / 8 > MOMENTOS_BLOCO_ESTREITO ?
+                     i + 8 * MOMENTOS_BLOCO_ESTREITO : tamanho;
+        __m128i soma = zero;
+        __m128i quadrados = zero;
+    
+        for (; i + 8 <= fim; i += 8) {
+            __m128i x = _mm_loadu_si128((const __m128i*)(valores + i));
+            __m128i deslocado = _mm_xor_si128(x, desvio);
+            minimo = _mm_min_epi16(minimo, deslocado);
+            maximo = _mm_max_epi16(maximo, deslocado);
+    
+            __m128i baixa = _mm_unpacklo_epi16(x, zero);
+            __m128i alta = _mm_unpackhi_epi16(x, zero);
+            soma = _mm_add_epi32(soma, _mm_add_epi32(baixa, alta));
+    
+            // Quadrados de 32 bits (até 2^32) em faixas de 64 bits
+            __m128i pares = _mm_add_epi64(_mm_mul_epu32(baixa, baixa), _mm_mul_epu32(alta, alta));
+            baixa = _mm_srli_epi64(baixa, 32);
+            alta = _mm_srli_epi64(alta, 32);
+            __m128i impares = _mm_add_epi64(_mm_mul_epu32(baixa, baixa), _mm_mul_epu32(alta, alta));
+            quadrados = _mm_add_epi64(quadrados, _mm_add_epi64(pares, impares));
+        }
+    
+        uint32_t faixa_soma[4];
+        uint64_t faixa_quadrados[2];
+        _mm_storeu_si128((__m128i*)faixa_soma, soma);
+        _mm_storeu_si128((__m128i*)faixa_quadrados, quadrados);
+        for (int k = 0; k < 4; k++) {
+            momentos->soma += faixa_soma[k];
+        }
+        momentos->soma_quadrados += (__int128)faixa_quadrados[0] + faixa_quadrados[1];
+    }
+    
+    uint16_t faixa_min[8], faixa_max[8];
+    _mm_storeu_si128((__m128i*)faixa_min, _mm_xor_si128(minimo, desvio));
+    _mm_storeu_si128((__m128i*)faixa_max, _mm_xor_si128(maximo, desvio));
+    for (int k = 0; k < 8 && i > 0; k++) {
+        if (faixa_min[k] < momentos->minimo) momentos->minimo = faixa_min[k];
+        if (faixa_max[k] > momentos->maximo) momentos->maximo = faixa_max[k];
+    }
+    
+    momentos_u16_escalar(valores + i, tamanho - i, momentos);
+}
+
+// --- AVX2 (8 valores por iteração) ---
+
+__attribute__((target("avx2")))
+static void momentos_avx2(const int *valores, size_t tamanho, Momentos *momentos) {
+    const __m256i mascara_baixa = _mm256_set1_epi64x(0xffffffffLL);
+    __m256i minimo = _mm256_set1_epi32(momentos->minimo);
+    __m256i maximo = _mm256_set1_epi32(momentos->maximo);
+    size_t i = 0;
+    
+    while (tamanho - i >= 8) {
+        size_t fim = tamanho - i > MOMENTOS_BLOCO ? i + MOMENTOS_BLOCO : tamanho;
+        __m256i soma = _mm256_setzero_si256();
+        __m256i altos = _mm256_setzero_si256();
+        __m256i baixos = _mm256_setzero_si256();
+    
+        for (; i + 8 <= fim; i += 8) {
+            __m256i x = _mm256_loadu_si256((const __m256i*)(valores + i));
+            minimo = _mm256_min_epi32(minimo, x);
+            maximo = _mm256_max_epi32(maximo, x);
+    
+            __m256i baixa = _mm256_cvtepi32_epi64(_mm256_castsi256_si128(x));
+            __m256i alta = _mm256_cvtepi32_epi64(_mm256_extracti128_si256(x, 1));
+            soma = _mm256_add_epi64(soma, _mm256_add_epi64(baixa, alta));
+    
+            // Dois quadrados de até 2^62 cabem em 64 bits sem sinal
+            __m256i quadrados = _mm256_add_epi64(_mm256_mul_epi32(baixa, baixa),
+                                                 _mm256_mul_epi32(alta, alta));
+            altos = _mm256_add_epi64(altos, _mm256_srli_epi64(quadrados, 32));
+            baixos = _mm256_add_epi64(baixos, _mm256_and_si256(quadrados, mascara_baixa));
+        }
+    
+        int64_t faixa_soma[4];
+        uint64_t faixa_altos[4], faixa_baixos[4];
+        _mm256_storeu_si256((__m256i*)faixa_soma, soma);
+        _mm256_storeu_si256((__m256i*)faixa_altos, altos);
+        _mm256_storeu_si256((__m256i*)faixa_baixos, baixos);
+        esvaziar_faixas(momentos, faixa_soma, faixa_altos, faixa_baixos, 4);
+    }
+    
+    int faixa_min[8], faixa_max[8];
+    _mm256_storeu_si256((__m256i*)faixa_min, minimo);
+    _mm256_storeu_si256((__m256i*)faixa_max, maximo);
+    for (int k = 0; k < 8; k++) {
+        if (faixa_min[k] < momentos->minimo) momentos->minimo = faixa_min[k];
+        if (faixa_max[k] > momentos->maximo) momentos->maximo = faixa_max[k];
+    }
+    
+    momentos_escalar(valores + i, tamanho - i, momentos);
+}
+
+__attribute__((target("avx2")))
+static size_t histograma_avx2(const int *valores, size_t tamanho, size_t *histograma,
+                              int base, size_t classes) {
+    const __m256i vetor_base = _mm256_set1_epi32(base);
+    const __m256i limite = _mm256_set1_epi32((int)(classes - 1));
+    size_t i = 0;
+    
+    for (; i + 8 <= tamanho; i += 8) {
+        __m256i x = _mm256_loadu_si256((const __m256i*)(valores + i));
+        __m256i indice = _mm256_sub_epi32(x, vetor_base);
+    
+        // indice <= limite (sem sinal) exatamente quando min(indice, limite) == indice
+        __m256i dentro = _mm256_cmpeq_epi32(_mm256_min_epu32(indice, limite), indice);
+        if (_mm256_movemask_epi8(dentro) != -1) {
+            return i + histograma_escalar(valores + i, 8, histograma, base, classes);
+        }
+    
+        for (int k = 0; k < 8; k++) {
+            histograma[(unsigned int)valores[i + k] - (unsigned int)base]++;
+        }
+    }
+    
+    return i + histograma_escalar(valores + i, tamanho - i, histograma, base, classes);
+}
+
+__attribute__((target("avx2")))
+static void momentos_u8_avx2(const uint8_t *valores, size_t tamanho, Momentos *momentos) {
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i minimo = _mm256_set1_epi8((char)0xff);
+    __m256i maximo = zero;
+    size_t i = 0;
+    
+    while (tamanho - i >= 32) {
+        size_t fim = (tamanho - i) / 32 > MOMENTOS_BLOCO_ESTREITO ?
+                     i + 32 * MOMENTOS_BLOCO_ESTREITO : tamanho;
+        __m256i soma = zero;
+        __m256i quadrados = zero;
+    
+        for (; i + 32 <= fim; i += 32) {
+            __m256i x = _mm256_loadu_si256((const __m256i*)(valores + i));
+            minimo = _mm256_min_epu8(minimo, x);
+            maximo = _mm256_max_epu8(maximo, x);
+            soma = _mm256_add_epi64(soma, _mm256_sad_epu8(x, zero));
+    
+            __m256i baixa = _mm256_cvtepu8_epi16(_mm256_castsi256_si128(x));
+            __m256i alta = _mm256_cvtepu8_epi16(_mm256_extracti128_si256(x, 1));
+            quadrados = _mm256_add_epi32(quadrados,
+                                         _mm256_add_epi32(_mm256_madd_epi16(baixa, baixa),
+                                                          _mm256_madd_epi16(alta, alta)));
+        }
+    
+        uint64_t faixa_soma[4];
+        uint32_t faixa_quadrados[8];
+        _mm256_storeu_si256((__m256i*)faixa_soma, soma);
+        _mm256_storeu_si256((__m256i*)faixa_quadrados, quadrados);
+        for (int k = 0; k < 4; k++) {
+            momentos->soma += faixa_soma[k];
+        }
+        for (int k = 0; k < 8; k++) {
+            momentos->soma_quadrados += faixa_quadrados[k];
+        }
+    }
+    
+    uint8_t faixa_min[32], faixa_max[32];
+    _mm256_storeu_si256((__m256i*)faixa_min, minimo);
+    _mm256_storeu_si256((__m256i*)faixa_max, maximo);
+    if (i > 0) {
+        esvaziar_extremos(momentos, faixa_min, faixa_max, 32);
+    }
+    
+    momentos_u8_escalar(valores + i, tamanho - i, momentos);
+}
+
+__attribute__((target("avx2")))
+static void momentos_u16_avx2(const uint16_t *valores, size_t tamanho, Momentos *momentos) {
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i minimo = _mm256_set1_epi16((short)0xffff);
+    __m256i maximo = zero;
+    size_t i = 0;
+    
+    while (tamanho - i >= 16) {
+        size_t fim = (tamanho - i) / 16 > MOMENTOS_BLOCO_ESTREITO ?
+                     i + 16 * MOMENTOS_BLOCO_ESTREITO : tamanho;
+        __m256i soma = zero;
+        __m256i quadrados = zero;
+    
+        for (; i + 16 <= fim; i += 16) {
+            __m256i x = _mm256_loadu_si256((const __m256i*)(valores + i));
+            minimo = _mm256_min_epu16(minimo, x);
+            maximo = _mm256_max_epu16(maximo, x);
+    
+            __m256i baixa = _mm256_cvtepu16_epi32(_mm256_castsi256_si128(x));
+            __m256i alta = _mm256_cvtepu16_epi32(_mm256_extracti128_si256(x, 1));
+            soma = _mm256_add_epi32(soma, _mm256_add_epi32(baixa, alta));
+    
+            __m256i pares = _mm256_add_epi64(_mm256_mul_epu32(baixa, baixa),
+                                             _mm256_mul_epu32(alta, alta));
+            baixa = _mm256_srli_epi64(baixa, 32);
+            alta = _mm256_srli_epi64(alta, 32);
+            __m256i impares = _mm256_add_epi64(_mm256_mul_epu32(baixa, baixa),
+                                               _mm256_mul_epu32(alta, alta));
+            quadrados = _mm256_add_epi64(quadrados, _mm256_add_epi64(pares, impares));
+        }
+    
+        uint32_t faixa_soma[8];
+        uint64_t faixa_quadrados[4];
+        _mm256_storeu_si256((__m256i*)faixa_soma, soma);
+        _mm256_storeu_si256((__m256i*)faixa_quadrados, quadrados);
+        for (int k = 0; k < 8; k++) {
+            momentos->soma += faixa_soma[k];
+        }
+        for (int k = 0; k < 4; k++) {
+            momentos->soma_quadrados += faixa_quadrados[k];
+        }
+    }
+    
+    uint16_t faixa_min[16], faixa_max[16];
+    _mm256_storeu_si256((__m256i*)faixa_min, minimo);
+    _mm256_storeu_si256((__m256i*)faixa_max, maximo);
+    for (int k = 0; k < 16 && i > 0; k++) {
+        if (faixa_min[k] < momentos->minimo) momentos->minimo = faixa_min[k];
+        if (faixa_max[k] > momentos->maximo) momentos->maximo = faixa_max[k];
+    }
+    
+    momentos_u16_escalar(valores + i, tamanho - i, momentos);
+}
+
+// --- AVX-512 (16 valores por iteração) ---
+
+__attribute__((target("avx512f")))
+static void momentos_avx512(const int *valores, size_t tamanho, Momentos *momentos) {
+    const __m512i mascara_baixa = _mm512_set1_epi64(0xffffffffLL);
+    __m512i minimo = _mm512_set1_epi32(momentos->minimo);
+    __m512i maximo = _mm512_set1_epi32(momentos->maximo);
+    size_t i = 0;
+    
+    while (tamanho - i >= 16) {
+        size_t fim = tamanho - i > MOMENTOS_BLOCO ? i + MOMENTOS_BLOCO : tamanho;
+        __m512i soma = _mm512_setzero_si512();
+        __m512i altos = _mm512_setzero_si512();
+        __m512i baixos = _mm512_setzero_si512();
+    
+        for (; i + 16 <= fim; i += 16) {
+            __m512i x = _mm512_loadu_si512((const void*)(valores + i));
+            minimo = _mm512_min_epi32(minimo, x);
+            maximo = _mm512_max_epi32(maximo, x);
+    
+            __m512i baixa = _mm512_cvtepi32_epi64(_mm512_castsi512_si256(x));
+            __m512i alta = _mm512_cvtepi32_epi64(_mm512_extracti64x4_epi64(x, 1));
+            soma = _mm512_add_epi64(soma, _mm512_add_epi64(baixa, alta));
+    
+            __m512i quadrados = _mm512_add_epi64(_mm512_mul_epi32(baixa, baixa),
+                                                 _mm512_mul_epi32(alta, alta));
+            altos = _mm512_add_epi64(altos, _mm512_srli_epi64(quadrados, 32));
+            baixos = _mm512_add_epi64(baixos, _mm512_and_si512(quadrados, mascara_baixa));
+        }
+    
+        int64_t faixa_soma[8];
+        uint64_t faixa_altos[8], faixa_baixos[8];
+        _mm512_storeu_si512((void*)faixa_soma, soma);
+        _mm512_storeu_si512((void*)faixa_altos, altos);
+        _mm512_storeu_si512((void*)faixa_baixos, baixos);
+        esvaziar_faixas(momentos, faixa_soma, faixa_altos, faixa_baixos, 8);
+    }
+    
+    int menor = _mm512_reduce_min_epi32(minimo);
+    int maior = _mm512_reduce_max_epi32(maximo);
+    if (menor < momentos->minimo) momentos->minimo = menor;
+    if (maior > momentos->maximo) momentos->maximo = maior;
+    
+    momentos_escalar(valores + i, tamanho - i, momentos);
+}
+
+__attribute__((target("avx512f")))
+static size_t histograma_avx512(const int *valores, size_t tamanho, size_t *histograma,
+                                int base, size_t classes) {
+    const __m512i vetor_base = _mm512_set1_epi32(base);
+    const __m512i limite = _mm512_set1_epi32((int)(classes - 1));
+    size_t i = 0;
+    
+    for (; i + 16 <= tamanho; i += 16) {
+        __m512i x = _mm512_loadu_si512((const void*)(valores + i));
+        __m512i indice = _mm512_sub_epi32(x, vetor_base);
+        if (_mm512_cmpgt_epu32_mask(indice, limite) != 0) {
+            return i + histograma_escalar(valores + i, 16, histograma, base, classes);
+        }
+    
+        for (int k = 0; k < 16; k++) {
+            histograma[(unsigned int)valores[i + k] - (unsigned int)base]++;
+        }
+    }
+    
+    return i + histograma_escalar(valores + i, tamanho - i, histograma, base, classes);
+}
+
+static const NucleosSimd NUCLEOS_SSE2 = {
+    "sse2", momentos_sse2, histograma_sse2, momentos_u8_sse2, momentos_u16_sse2
+};
+static const NucleosSimd NUCLEOS_AVX2 = {
+    "avx2", momentos_avx2, histograma_avx2, momentos_u8_avx2, momentos_u16_avx2
+};
+static const NucleosSimd NUCLEOS_AVX512 = {
+    "avx512", momentos_avx512, histograma_avx512, momentos_u8_avx2, momentos_u16_avx2
+};
+
+#endif
+
+// Versão em uso, escolhida antes de main()
+static const NucleosSimd *nucleos_escolhidos = &NUCLEOS_ESCALAR;
+
+// Retorna 1 se o processador executa a versão pedida
+static int nucleos_suportados(const NucleosSimd *nucleos) {
+#ifdef SIMD_X86
+    if (nucleos == &NUCLEOS_AVX512) return __builtin_cpu_supports("avx512f");
+    if (nucleos == &NUCLEOS_AVX2) return __builtin_cpu_supports("avx2");
+    if (nucleos == &NUCLEOS_SSE2) return __builtin_cpu_supports("sse2");
+#endif
+    return nucleos == &NUCLEOS_ESCALAR;
+}
+
+__attribute__((constructor))
+static void escolher_nucleos(void) {
+    // Da mais larga para a mais estreita
+    const NucleosSimd *candidatos[] = {
+#ifdef SIMD_X86
+        &NUCLEOS_AVX512, &NUCLEOS_AVX2, &NUCLEOS_SSE2,
+#endif
+        &NUCLEOS_ESCALAR
+    };
+    size_t n_candidatos = sizeof(candidatos) / sizeof(candidatos[0]);
+    
+#ifdef SIMD_X86
+    __builtin_cpu_init();
+#endif
+    
+    // Versão pedida em ESTATISTICAS_SIMD, se o processador a executa
+    const char *pedido = getenv("ESTATISTICAS_SIMD");
+    if (pedido != NULL) {
+        for (size_t i = 0; i < n_candidatos; i++) {
+            if (strcmp(pedido, candidatos[i]->nome) == 0 && nucleos_suportados(candidatos[i])) {
+                nucleos_escolhidos = candidatos[i];
+                return;
+            }
+        }
+    }
+    
+    // Caso contrário, a mais larga disponível
+    for (size_t i = 0; i < n_candidatos; i++) {
+        if (nucleos_suportados(candidatos[i])) {
+            nucleos_escolhidos = candidatos[i];
+            break;
+        }
+    }
+    
+    if (pedido != NULL) {
+        fprintf(stderr, "Aviso: núcleos '%s' indisponíveis; usando %s\n", pedido,
+                nucleos_escolhidos->nome);
+    }
+}
+
+const NucleosSimd* simd_nucleos(void) {
+    return nucleos_escolhidos;
+}
+
+const NucleosSimd* simd_escalar(void) {
+    return &NUCLEOS_ESCALAR;
+}
@@ -0,0 +1,59 @@
+/*
+ * Instituição: Universidade Federal da Paraíba
+ * Disciplina: Sistemas Operacionais I
+ * Unidade 1 - Atividade 2
+ *
+ * Autor: Rodrigo Monteiro Fortes de Oliveira, 20240097664
+ *
+ * Nome do Módulo: simd.h
+ *
+ * Descrição:
+ *     Núcleos vetorizados (SSE2, AVX2 e AVX-512) para a soma, a soma
+ *     dos quadrados, o mínimo/máximo e a contagem no histograma. A
+ *     versão é escolhida uma única vez, ao carregar o programa, de
+ *     acordo com o processador; a versão escalar serve de referência
+ *     para conferir as demais. A variável de ambiente ESTATISTICAS_SIMD
+ *     (escalar, sse2, avx2 ou avx512) força uma versão específica.
+ *
+ *     Os momentos também têm núcleos para valores guardados em 8 e 16
+ *     bits sem sinal (armazenamento compacto, ver TipoElemento em
+ *     estatisticas.h): 16 a 32 valores por registrador de 128/256 bits.
+ */
+
+#ifndef SIMD_H
+#define SIMD_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Momentos acumulados pelos núcleos (somas exatas)
+typedef struct {
+    long long soma;
+    __int128 soma_quadrados;
+    int minimo;
+    int maximo;
+} Momentos;
+
+typedef struct {
+    const char *nome;
+    
+    // Soma os momentos de 'valores' aos já presentes em 'momentos'
+    void (*momentos)(const int *valores, size_t tamanho, Momentos *momentos);
+    
+    // Conta os valores no histograma das classes [base, base + classes).
+    // Para no primeiro valor fora do domínio e retorna quantos contou.
+    size_t (*histograma)(const int *valores, size_t tamanho, size_t *histograma,
+                         int base, size_t classes);
+    
+    // Momentos de valores em 8 e 16 bits sem sinal
+    void (*momentos_u8)(const uint8_t *valores, size_t tamanho, Momentos *momentos);
+    void (*momentos_u16)(const uint16_t *valores, size_t tamanho, Momentos *momentos);
+} NucleosSimd;
+
+// Núcleos escolhidos para este processador
+const NucleosSimd* simd_nucleos(void);
+
+// Versão escalar de referência
+const NucleosSimd* simd_escalar(void);
+
+#endif
@@ -8,139 +8,204 @@
  * Nome do Programa: single_thread.c
  *
  * Descrição:
- *     Gera 10.000 números aleatórios entre 0 e 100 e calcula média,
+ *     Gera N números aleatórios (padrão: 10.000 entre 0 e 100) e calcula média,
  *     mediana e desvio padrão de forma sequencial (sem threads).
  *     Usado como referência para comparar com versões paralelas.
  *     Mostra o tempo total de execução.
+ *
+ *     Com -f os valores vêm de um arquivo binário gerado pelo converter,
+ *     mapeado na memória em vez de gerado a cada execução. Sem -f, a
+ *     geração (fora da medição) usa o gerador paralelo de gerador.c e
+ *     -S fixa a semente, para repetir a mesma entrada.
+ *
+ *     Com -q lista (ex.: -q 0.5,0.9,0.99,0.999) também são exibidos
+ *     esses quantis, exatos: pelo histograma ou por seleção.
+ *
+ *     ESTATISTICAS_CONTADORES=1 e ESTATISTICAS_RASTRO=arquivo.json no
+ *     ambiente ligam os contadores por fase (contadores.h) e a linha do
+ *     tempo (rastro.h); ESTATISTICAS_LATENCIA=1 (ou fifo) liga o modo
+ *     de latência (latencia.h).
+ *
+ *     Os valores gerados são guardados no menor tipo que cabe no
+ *     intervalo (uint8 para 0 a 100); -w mantém int32, para comparar.
+ *
+ * Compilação:
+ *     gcc -O2 -pthread single_thread.c estatisticas.c simd.c selecao.c esboco.c vetor.c dados.c gerador.c contadores.c rastro.c afinidade.c latencia.c -o single_thread -lm
  */
 
 #include <stdio.h>
 #include <stdlib.h>
-#include <math.h>
 #include <time.h>
-#include <sys/time.h>
+#include <unistd.h>
+#include "estatisticas.h"
+#include "simd.h"
+#include "vetor.h"
+#include "contadores.h"
+#include "rastro.h"
+#include "latencia.h"
+#include "dados.h"
+#include "gerador.h"
+#include "tempo.h"
 
 #define N_ENTRADAS 10000
 #define MIN_VALOR 0
 #define MAX_VALOR 100
 
-// Compara dois inteiros (usado pelo qsort)
-int comparar(const void *a, const void *b) {
-    int int_a = *((int*)a);
-    int int_b = *((int*)b);
-    
-    if (int_a < int_b) return -1;
-    if (int_a > int_b) return 1;
-    return 0;
-}
-
-// Calcula a média
-double calcular_media(int *valores, int tamanho) {
-    long long soma = 0;
-    
-    for (int i = 0; i < tamanho; i++) {
-        soma += valores[i];
+int main(int argc, char *argv[]) {
+    size_t n_entradas = N_ENTRADAS;
+    Dominio dominio = { MIN_VALOR, MAX_VALOR };
+    int opcoes_vetor = 0;
+    const char *arquivo = NULL;
+    uint64_t semente = gerador_semente_padrao();
+    int dominio_informado = 0;
+    Quantis quantis = { 0 };
+    int armazenamento_largo = 0;
+    
+    // Lê as opções da linha de comando
+    int opcao;
+    while ((opcao = getopt(argc, argv, "n:v:Hf:S:q:w")) != -1) {
+        switch (opcao) {
+            case 'n':
+                n_entradas = strtoull(optarg, NULL, 10);
+                break;
+            case 'v':
+                if (dominio_ler(optarg, &dominio) != 0) {
+                    fprintf(stderr, "Intervalo inválido: %s (use min:max)\n", optarg);
+                    return EXIT_FAILURE;
+                }
+                dominio_informado = 1;
+                break;
+            case 'H':
+                opcoes_vetor |= VETOR_PAGINAS_ENORMES;
+                break;
+            case 'f':
+                arquivo = optarg;
+                break;
+            case 'S':
+                semente = strtoull(optarg, NULL, 10);
+                break;
+            case 'q':
+                if (quantis_ler(optarg, &quantis) != 0) {
+                    fprintf(stderr, "Lista de quantis inválida: %s (ex.: 0.5,0.9,0.99)\n", optarg);
+                    return EXIT_FAILURE;
+                }
+                break;
+            case 'w':
+                armazenamento_largo = 1;
+                break;
+            default:
+                fprintf(stderr, "Uso: %s [-n quantidade] [-v min:max] [-H] [-f arquivo.bin] [-S semente] [-q quantis] [-w]\n", argv[0]);
+                return EXIT_FAILURE;
+        }
     }
     
-    return (double)soma / tamanho;
-}
-
-// Calcula a mediana
-double calcular_mediana(int *valores, int tamanho) {
-    // Copia o vetor para não alterar o original
-    int *copia = (int*)malloc(tamanho * sizeof(int));
-    if (copia == NULL) {
-        fprintf(stderr, "Erro ao alocar memória para cópia do vetor\n");
-        exit(EXIT_FAILURE);
-    }
-    
-    for (int i = 0; i < tamanho; i++) {
-        copia[i] = valores[i];
-    }
-    
-    // Ordena o vetor
-    qsort(copia, tamanho, sizeof(int), comparar);
-    
-    double mediana;
-    if (tamanho % 2 == 0) {
-        // Par: média dos dois do meio
-        mediana = (copia[tamanho/2] + copia[tamanho/2 - 1]) / 2.0;
-    } else {
-        // Ímpar: elemento do meio
-        mediana = copia[tamanho/2];
+    // Contadores e rastro por fase, se pedidos pelo ambiente
+    // (ESTATISTICAS_CONTADORES e ESTATISTICAS_RASTRO)
+    contadores_abrir();
+    rastro_iniciar();
+    rastro_nomear("principal");
+    
+    // Conjunto preparado com o converter: mapeado sem conversão nem cópia.
+    // Sem -v, o intervalo gravado no cabeçalho define o histograma.
+    Vetor vetor;
+    if (arquivo != NULL) {
+        if (dados_mapear(&vetor, arquivo, dominio_informado ? NULL : &dominio) != 0) {
+            return EXIT_FAILURE;
+        }
+        n_entradas = vetor.tamanho;
     }
     
-    free(copia);
-    return mediana;
-}
-
-// Calcula o desvio padrão
-double calcular_desvio_padrao(int *valores, int tamanho, double media) {
-    double soma_quadrados = 0.0;
-    
-    for (int i = 0; i < tamanho; i++) {
-        double diferenca = valores[i] - media;
-        soma_quadrados += diferenca * diferenca;
+    if (n_entradas == 0) {
+        fprintf(stderr, "Quantidade de valores inválida\n");
+        return EXIT_FAILURE;
     }
     
-    double variancia = soma_quadrados / tamanho;
-    return sqrt(variancia);
-}
-
-int main() {
-    // Aloca memória para o vetor
-    int *valores = (int*)malloc(N_ENTRADAS * sizeof(int));
-    if (valores == NULL) {
-        fprintf(stderr, "Erro ao alocar memória para o vetor\n");
+    // Aloca memória para o vetor (mmap quando grande), no menor tipo do intervalo
+    TipoElemento tipo = armazenamento_largo ? ELEMENTO_INT32 : dominio_tipo_elemento(dominio);
+    if (arquivo == NULL && vetor_alocar(&vetor, n_entradas, tipo, opcoes_vetor) != 0) {
         return EXIT_FAILURE;
     }
-    
-    // Inicializa gerador aleatório
-    srand(time(NULL));
-    
-    // Preenche o vetor com números aleatórios de 0 a 100
-    for (int i = 0; i < N_ENTRADAS; i++) {
-        valores[i] = rand() % (MAX_VALOR - MIN_VALOR + 1) + MIN_VALOR;
+    void *valores = vetor.valores;
+    tipo = vetor.tipo;
+    
+    // Sem arquivo: gera os valores
+    if (arquivo == NULL) {
+        // Preenche em paralelo com valores do intervalo [min, max] (sem viés)
+        contadores_entrar("geracao");
+        if (gerador_preencher(valores, tipo, n_entradas, dominio, semente, 0, NULL) != 0) {
+            return EXIT_FAILURE;
+        }
+        contadores_sair();
     }
     
+    // Modo de latência (ESTATISTICAS_LATENCIA): memória travada e área de
+    // trabalho da seleção reservada antes da medição
+    latencia_iniciar(valores, n_entradas * elemento_bytes(tipo),
+                     tipo == ELEMENTO_INT32 && !dominio_limitado(dominio) ? n_entradas : 0);
+    
     printf("========================================\n");
     printf("  EXECUÇÃO EM UMA ÚNICA THREAD\n");
     printf("========================================\n\n");
+    printf("Núcleos SIMD: %s\n", simd_nucleos()->nome);
+    printf("Armazenamento: %s, %zu B por valor\n", elemento_nome(tipo), elemento_bytes(tipo));
+    latencia_exibir();
+    printf("\n");
     
     // Começa a medir o tempo
-    struct timeval inicio, fim;
-    gettimeofday(&inicio, NULL);
+    struct timespec inicio, fim;
+    marcar_instante(&inicio);
+    
+    // Percorre o vetor uma única vez: soma, soma dos quadrados e histograma
+    contadores_entrar("acumulo");
+    Resumo resumo;
+    resumo_iniciar(&resumo, dominio);
+    resumo_acumular_elementos(&resumo, valores, tipo, n_entradas);
     
     // Calcula média
-    double media = calcular_media(valores, N_ENTRADAS);
+    double media = resumo_media(&resumo);
     
     // Calcula mediana
-    double mediana = calcular_mediana(valores, N_ENTRADAS);
+    contadores_entrar("mediana");
+    double mediana = resumo_mediana_elementos(&resumo, valores, tipo, n_entradas);
     
     // Calcula desvio padrão
-    double desvio = calcular_desvio_padrao(valores, N_ENTRADAS, media);
+    double desvio = resumo_desvio_padrao(&resumo);
+    
+    // Calcula os quantis pedidos
+    if (quantis.quantidade > 0) {
+        contadores_entrar("quantis");
+        resumo_quantis_elementos(&resumo, valores, tipo, n_entradas, &quantis);
+    }
+    
+    resumo_liberar(&resumo);
+    contadores_sair();
     
     // Para de medir o tempo
-    gettimeofday(&fim, NULL);
+    marcar_instante(&fim);
     
     // Calcula tempo total (ms)
-    long segundos = fim.tv_sec - inicio.tv_sec;
-    long microsegundos = fim.tv_usec - inicio.tv_usec;
-    double tempo_total = (segundos * 1000.0) + (microsegundos / 1000.0);
+    double tempo_total = diferenca_ms(inicio, fim);
     
     // Exibe resultados estatísticos
     printf("--- RESULTADOS ESTATÍSTICOS ---\n");
-    printf("Quantidade de valores processados: %d\n", N_ENTRADAS);
+    printf("Quantidade de valores processados: %zu\n", n_entradas);
+    if (arquivo == NULL) {
+        printf("Semente do gerador: %llu\n", (unsigned long long)semente);
+    }
     printf("Média aritmética: %.6f\n", media);
     printf("Mediana: %.6f\n", mediana);
-    printf("Desvio padrão populacional: %.6f\n\n", desvio);
+    printf("Desvio padrão populacional: %.6f\n", desvio);
+    quantis_exibir(&quantis);
+    printf("\n");
     
     // Exibe métricas de tempo
     printf("--- MÉTRICAS DE TEMPO ---\n");
     printf("Tempo total de execução: %.3f ms\n", tempo_total);
+    contadores_exibir();
+    contadores_fechar();
     
     // Libera memória alocada
-    free(valores);
+    vetor_liberar(&vetor);
     
     printf("\n========================================\n");
     printf("  Execução finalizada com sucesso\n");
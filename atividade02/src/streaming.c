@@ -0,0 +1,285 @@
+/*
+ * Instituição: Universidade Federal da Paraíba
+ * Disciplina: Sistemas Operacionais I
+ * Unidade 1 - Atividade 2
+ *
+ * Autor: Rodrigo Monteiro Fortes de Oliveira, 20240097664
+ *
+ * Nome do Programa: streaming.c
+ *
+ * Descrição:
+ *     Lê inteiros da entrada padrão ou de um arquivo e calcula média,
+ *     mediana e desvio padrão sem guardar os dados: cada lote lido
+ *     atualiza o mesmo resumo (momentos e histograma) usado pelas
+ *     demais versões, de modo que a memória ocupada depende apenas do
+ *     domínio dos valores e não da quantidade lida. A mediana exata
+ *     exige que todos os valores estejam no intervalo informado em -v.
+ *
+ *     Com -q lista (ex.: -q 0.5,0.9,0.99,0.999) também são exibidos
+ *     esses quantis: exatos pelo histograma ou, se algum valor sair do
+ *     domínio, aproximados por um esboço KLL de precisão -K (padrão:
+ *     200), que também não depende da quantidade lida.
+ *
+ *     Com -j W as estatísticas passam a ser as dos últimos W valores,
+ *     atualizadas a cada valor lido por uma janela deslizante (janela.h)
+ *     em vez de recalculadas sobre a janela inteira. Com -o saida.csv
+ *     cada valor lido gera uma linha com a média, a mediana e o desvio
+ *     padrão da janela naquele ponto.
+ *
+ * Uso:
+ *     ./streaming [-v min:max] [-q quantis] [-K precisão] [-j largura [-o saida.csv]] [arquivo | -]
+ *
+ * Compilação:
+ *     gcc -O2 -pthread streaming.c estatisticas.c simd.c selecao.c esboco.c gerador.c afinidade.c leitor.c janela.c -o streaming -lm
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <unistd.h>
+#include "estatisticas.h"
+#include "esboco.h"
+#include "leitor.h"
+#include "janela.h"
+#include "tempo.h"
+
+#define MIN_VALOR 0
+#define MAX_VALOR 100
+
+// Valores convertidos por lote antes de atualizar o resumo
+#define TAMANHO_LOTE 65536
+
+// Estatísticas dos últimos 'largura' valores, atualizadas a cada valor lido
+int executar_janela(Leitor *leitor, int *lote, size_t largura, Dominio dominio,
+                    const char *arquivo_saida) {
+    Janela janela;
+    if (janela_iniciar(&janela, largura, dominio) != 0) {
+        return EXIT_FAILURE;
+    }
+    
+    FILE *csv = NULL;
+    if (arquivo_saida != NULL) {
+        csv = fopen(arquivo_saida, "w");
+        if (csv == NULL) {
+            perror("Erro ao abrir o arquivo de saída");
+            janela_liberar(&janela);
+            return EXIT_FAILURE;
+        }
+        fprintf(csv, "Posicao,Media,Mediana,Desvio\n");
+    }
+    
+    printf("========================================\n");
+    printf("  EXECUÇÃO EM FLUXO COM JANELA DE %zu\n", largura);
+    printf("========================================\n\n");
+    
+    // Começa a medir o tempo
+    struct timespec inicio, fim;
+    marcar_instante(&inicio);
+    
+    // Cada valor entra na janela e as três estatísticas são refeitas
+    size_t total = 0;
+    double media = NAN, mediana = NAN, desvio = NAN;
+    int erro = 0;
+    size_t lidos;
+    while (!erro && (lidos = leitor_ler(leitor, lote, TAMANHO_LOTE)) > 0) {
+        for (size_t i = 0; i < lidos; i++) {
+            if (janela_inserir(&janela, lote[i]) != 0) {
+                erro = 1;
+                break;
+            }
+            media = janela_media(&janela);
+            mediana = janela_mediana(&janela);
+            desvio = janela_desvio_padrao(&janela);
+            if (csv != NULL) {
+                fprintf(csv, "%zu,%.6f,%.6f,%.6f\n", total, media, mediana, desvio);
+            }
+            total++;
+        }
+    }
+    
+    // Para de medir o tempo
+    marcar_instante(&fim);
+    
+    if (csv != NULL) fclose(csv);
+    if (erro || leitor->erro) {
+        janela_liberar(&janela);
+        return EXIT_FAILURE;
+    }
+    if (total == 0) {
+        fprintf(stderr, "Nenhum valor lido\n");
+        janela_liberar(&janela);
+        return EXIT_FAILURE;
+    }
+    
+    // Calcula tempo total (ms)
+    double tempo_total = diferenca_ms(inicio, fim);
+    
+    // Exibe resultados estatísticos da última janela
+    printf("--- RESULTADOS ESTATÍSTICOS ---\n");
+    printf("Quantidade de valores processados: %zu\n", total);
+    printf("Valores na última janela: %zu\n", janela.quantidade);
+    printf("Mediana da janela por: %s\n", janela_usa_histograma(&janela) ? "histograma" : "heaps");
+    printf("Média aritmética: %.6f\n", media);
+    printf("Mediana: %.6f\n", mediana);
+    printf("Desvio padrão populacional: %.6f\n", desvio);
+    if (arquivo_saida != NULL) {
+        printf("Estatísticas de cada janela gravadas em %s\n", arquivo_saida);
+    }
+    printf("\n");
+    
+    // Exibe métricas de tempo
+    printf("--- MÉTRICAS DE TEMPO ---\n");
+    printf("Tempo total de execução: %.3f ms\n", tempo_total);
+    printf("Vazão: %.3e atualizações/s\n", total / (tempo_total / 1000.0));
+    
+    janela_liberar(&janela);
+    
+    printf("\n========================================\n");
+    printf("  Execução finalizada com sucesso\n");
+    printf("========================================\n");
+    
+    return EXIT_SUCCESS;
+}
+
+int main(int argc, char *argv[]) {
+    Dominio dominio = { MIN_VALOR, MAX_VALOR };
+    Quantis quantis = { 0 };
+    int precisao_esboco = ESBOCO_K_PADRAO;
+    size_t largura_janela = 0;
+    const char *arquivo_saida = NULL;
+    
+    // Lê as opções da linha de comando
+    int opcao;
+    while ((opcao = getopt(argc, argv, "v:q:K:j:o:")) != -1) {
+        switch (opcao) {
+            case 'v':
+                if (dominio_ler(optarg, &dominio) != 0) {
+                    fprintf(stderr, "Intervalo inválido: %s (use min:max)\n", optarg);
+                    return EXIT_FAILURE;
+                }
+                break;
+            case 'q':
+                if (quantis_ler(optarg, &quantis) != 0) {
+                    fprintf(stderr, "Lista de quantis inválida: %s (ex.: 0.5,0.9,0.99)\n", optarg);
+                    return EXIT_FAILURE;
+                }
+                break;
+            case 'K':
+                precisao_esboco = atoi(optarg);
+                if (precisao_esboco < 8) {
+                    fprintf(stderr, "Precisão do esboço inválida: %s (mínimo 8)\n", optarg);
+                    return EXIT_FAILURE;
+                }
+                break;
+            case 'j':
+                largura_janela = strtoull(optarg, NULL, 10);
+                if (largura_janela == 0) {
+                    fprintf(stderr, "Largura da janela inválida: %s\n", optarg);
+                    return EXIT_FAILURE;
+                }
+                break;
+            case 'o':
+                arquivo_saida = optarg;
+                break;
+            default:
+                fprintf(stderr, "Uso: %s [-v min:max] [-q quantis] [-K precisão] [-j largura [-o saida.csv]] "
+                        "[arquivo | -]\n", argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+    const char *caminho = optind < argc ? argv[optind] : "-";
+    if (arquivo_saida != NULL && largura_janela == 0) {
+        fprintf(stderr, "A opção -o exige -j\n");
+        return EXIT_FAILURE;
+    }
+    
+    Leitor leitor;
+    if (leitor_abrir(&leitor, caminho) != 0) {
+        return EXIT_FAILURE;
+    }
+    
+    // Lote reaproveitado a cada leitura (memória constante)
+    int *lote = (int*)malloc(TAMANHO_LOTE * sizeof(int));
+    if (lote == NULL) {
+        fprintf(stderr, "Erro ao alocar memória para o lote\n");
+        leitor_fechar(&leitor);
+        return EXIT_FAILURE;
+    }
+    
+    if (largura_janela > 0) {
+        int status = executar_janela(&leitor, lote, largura_janela, dominio, arquivo_saida);
+        leitor_fechar(&leitor);
+        free(lote);
+        return status;
+    }
+    
+    printf("========================================\n");
+    printf("  EXECUÇÃO EM FLUXO (STREAMING)\n");
+    printf("========================================\n\n");
+    
+    // Começa a medir o tempo
+    struct timespec inicio, fim;
+    marcar_instante(&inicio);
+    
+    // Atualiza o resumo lote a lote
+    Resumo resumo;
+    resumo_iniciar(&resumo, dominio);
+    if (quantis.quantidade > 0) {
+        resumo_ativar_esboco(&resumo, precisao_esboco);
+    }
+    
+    size_t lidos;
+    while ((lidos = leitor_ler(&leitor, lote, TAMANHO_LOTE)) > 0) {
+        resumo_acumular(&resumo, lote, lidos);
+    }
+    
+    // Para de medir o tempo
+    marcar_instante(&fim);
+    
+    int erro = leitor.erro;
+    leitor_fechar(&leitor);
+    free(lote);
+    
+    if (erro) {
+        resumo_liberar(&resumo);
+        return EXIT_FAILURE;
+    }
+    if (resumo.contagem == 0) {
+        fprintf(stderr, "Nenhum valor lido\n");
+        resumo_liberar(&resumo);
+        return EXIT_FAILURE;
+    }
+    
+    // Calcula tempo total (ms)
+    double tempo_total = diferenca_ms(inicio, fim);
+    
+    // Exibe resultados estatísticos
+    printf("--- RESULTADOS ESTATÍSTICOS ---\n");
+    printf("Quantidade de valores processados: %zu\n", resumo.contagem);
+    printf("Média aritmética: %.6f\n", resumo_media(&resumo));
+    if (resumo.histograma != NULL) {
+        printf("Mediana: %.6f\n", resumo_mediana(&resumo, NULL, 0));
+    } else {
+        // Sem histograma seria preciso guardar todos os valores
+        printf("Mediana: indisponível (valores fora de [%d, %d]; mín. %d, máx. %d)\n",
+               dominio.min, dominio.max, resumo.minimo, resumo.maximo);
+    }
+    printf("Desvio padrão populacional: %.6f\n", resumo_desvio_padrao(&resumo));
+    if (quantis.quantidade > 0) {
+        resumo_quantis(&resumo, NULL, 0, &quantis);
+        quantis_exibir(&quantis);
+    }
+    printf("\n");
+    
+    // Exibe métricas de tempo
+    printf("--- MÉTRICAS DE TEMPO ---\n");
+    printf("Tempo total de execução: %.3f ms\n", tempo_total);
+    
+    resumo_liberar(&resumo);
+    
+    printf("\n========================================\n");
+    printf("  Execução finalizada com sucesso\n");
+    printf("========================================\n");
+    
+    return EXIT_SUCCESS;
+}
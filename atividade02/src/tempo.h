@@ -0,0 +1,33 @@
+/*
+ * Instituição: Universidade Federal da Paraíba
+ * Disciplina: Sistemas Operacionais I
+ * Unidade 1 - Atividade 2
+ *
+ * Autor: Rodrigo Monteiro Fortes de Oliveira, 20240097664
+ *
+ * Nome do Módulo: tempo.h
+ *
+ * Descrição:
+ *     Medição de tempo pelo relógio monotônico (CLOCK_MONOTONIC), que
+ *     não sofre ajustes de data/hora durante a execução, ao contrário
+ *     de gettimeofday.
+ */
+
+#ifndef TEMPO_H
+#define TEMPO_H
+
+#include <time.h>
+
+// Registra o instante atual
+static inline void marcar_instante(struct timespec *instante) {
+    clock_gettime(CLOCK_MONOTONIC, instante);
+}
+
+// Diferença entre dois instantes em milissegundos
+static inline double diferenca_ms(struct timespec inicio, struct timespec fim) {
+    long segundos = fim.tv_sec - inicio.tv_sec;
+    long nanossegundos = fim.tv_nsec - inicio.tv_nsec;
+    return (segundos * 1000.0) + (nanossegundos / 1000000.0);
+}
+
+#endif
@@ -8,19 +8,78 @@
  * Nome do Programa: threads.c
  *
  * Descrição:
- *     Gera 10.000 números aleatórios entre 0 e 100 e calcula média,
+ *     Gera N números aleatórios (padrão: 10.000 entre 0 e 100) e calcula média,
  *     mediana e desvio padrão usando três threads paralelas.
  *     Cada thread faz um cálculo diferente e salva o resultado em
  *     variáveis globais. A thread principal mostra os resultados
  *     depois que todas terminam. Mede tempo de criação e execução.
+ *
+ *     Com a opção -d o programa passa a usar paralelismo de dados:
+ *     o vetor é dividido em blocos, um por thread (-t N, padrão: um
+ *     por núcleo), cada thread resume o seu bloco em uma área própria
+ *     alinhada à linha de cache e a thread principal combina os
+ *     resumos parciais.
+ *
+ *     Com a opção -p as tarefas são submetidas a um pool de threads
+ *     criado uma única vez; com -r R o cálculo é repetido R vezes,
+ *     simulando um serviço que processa vários conjuntos de dados.
+ *     O tempo de preparação do pool é exibido separado da latência
+ *     média de cada execução.
+ *
+ *     Com -f os valores vêm de um arquivo binário gerado pelo converter,
+ *     mapeado na memória em vez de gerado a cada execução. Sem -f, a
+ *     geração (fora da medição) usa o gerador paralelo de gerador.c e
+ *     -S fixa a semente, para repetir a mesma entrada.
+ *
+ *     Com -q lista (ex.: -q 0.5,0.9,0.99,0.999) também são exibidos
+ *     esses quantis. No modo de tarefas a thread da mediana os calcula
+ *     exatos; no modo -d, quando não há histograma, cada thread mantém
+ *     um esboço KLL de precisão -K (padrão: 200) e a thread principal
+ *     combina os esboços, sem reler os dados.
+ *
+ *     Os valores gerados são guardados no menor tipo que cabe no
+ *     intervalo (uint8 para 0 a 100); -w mantém int32, para comparar.
+ *
+ *     Com -A política (compacto, espalhado ou lista de CPUs, ver
+ *     afinidade.h) cada thread é criada já fixada na sua CPU: a thread
+ *     do bloco t (ou a t-ésima tarefa) na CPU do trabalhador t. No modo
+ *     -d a geração usa as mesmas CPUs e divide o vetor nos mesmos
+ *     trechos, de modo que as páginas de cada bloco são tocadas pela
+ *     primeira vez (e alocadas) no nó NUMA da thread que o resume. No
+ *     pool as trabalhadoras também são fixadas, mas a tarefa vai para a
+ *     que estiver livre, sem garantia de localidade.
+ *
+ *     Com ESTATISTICAS_CONTADORES=1 no ambiente são exibidos contadores
+ *     de desempenho por fase (ver contadores.h). As threads do pool só
+ *     terminam em pool_destruir, e é nessa fase que a contagem delas
+ *     aparece; sem pool, ela entra no cálculo, que inclui o join.
+ *     Com ESTATISTICAS_RASTRO=arquivo.json é gravada a linha do tempo
+ *     (rastro.h): criação, execução e join de cada thread e as fases.
+ *     ESTATISTICAS_LATENCIA=1 (ou fifo) liga o modo de latência
+ *     (latencia.h); com -r a distribuição das latências das execuções
+ *     (mínimo, mediana, p99 e máximo) é exibida, não só a média.
+ *
+ * Compilação:
+ *     gcc -O2 -pthread threads.c estatisticas.c simd.c selecao.c esboco.c vetor.c dados.c gerador.c contadores.c rastro.c afinidade.c latencia.c pool_threads.c -o threads -lm
  */
 
 #include <stdio.h>
 #include <stdlib.h>
-#include <math.h>
+#include <unistd.h>
 #include <pthread.h>
 #include <time.h>
-#include <sys/time.h>
+#include "estatisticas.h"
+#include "esboco.h"
+#include "selecao.h"
+#include "vetor.h"
+#include "dados.h"
+#include "gerador.h"
+#include "tempo.h"
+#include "pool_threads.h"
+#include "contadores.h"
+#include "rastro.h"
+#include "afinidade.h"
+#include "latencia.h"
 
 #define N_ENTRADAS 10000
 #define MIN_VALOR 0
@@ -31,163 +90,506 @@ double resultado_media = 0.0;
 double resultado_mediana = 0.0;
 double resultado_desvio = 0.0;
 
-// Vetor global compartilhado entre as threads
-int valores[N_ENTRADAS];
+// Vetor global compartilhado entre as threads, com valores do tipo 'tipo'
+void *valores = NULL;
+TipoElemento tipo = ELEMENTO_INT32;
+size_t n_entradas = N_ENTRADAS;
 
-// Compara dois inteiros (usado pelo qsort)
-int comparar(const void *a, const void *b) {
-    int int_a = *((int*)a);
-    int int_b = *((int*)b);
-    
-    if (int_a < int_b) return -1;
-    if (int_a > int_b) return 1;
-    return 0;
-}
+// Intervalo dos valores (opção -v)
+Dominio dominio = { MIN_VALOR, MAX_VALOR };
+
+// Quantis pedidos (opção -q) e precisão dos esboços (opção -K)
+Quantis quantis = { 0 };
+int precisao_esboco = ESBOCO_K_PADRAO;
+
+// Posicionamento das threads nas CPUs (opção -A)
+Afinidade afinidade = AFINIDADE_NENHUMA;
 
 // Thread que calcula a média
 void* thread_media(void *arg) {
-    long long soma = 0;
+    rastro_nomear("media");
+    rastro_comecar("media");
     
-    for (int i = 0; i < N_ENTRADAS; i++) {
-        soma += valores[i];
-    }
+    // Só os momentos interessam: dispensa o histograma
+    Resumo resumo;
+    resumo_iniciar(&resumo, DOMINIO_ILIMITADO);
+    resumo_acumular_elementos(&resumo, valores, tipo, n_entradas);
     
-    resultado_media = (double)soma / N_ENTRADAS;
+    resultado_media = resumo_media(&resumo);
     
-    pthread_exit(NULL);
+    rastro_terminar("media");
+    return NULL;
 }
 
 // Thread que calcula a mediana
 void* thread_mediana(void *arg) {
-    // Copia o vetor para não alterar o original
-    int *copia = (int*)malloc(N_ENTRADAS * sizeof(int));
-    if (copia == NULL) {
-        fprintf(stderr, "Erro ao alocar memória para cópia do vetor\n");
-        pthread_exit(NULL);
-    }
+    rastro_nomear("mediana");
+    rastro_comecar("mediana");
     
-    for (int i = 0; i < N_ENTRADAS; i++) {
-        copia[i] = valores[i];
+    // Conta os valores no histograma do domínio (sem cópia nem ordenação)
+    Resumo resumo;
+    resumo_iniciar(&resumo, dominio);
+    resumo_acumular_elementos(&resumo, valores, tipo, n_entradas);
+    resultado_mediana = resumo_mediana_elementos(&resumo, valores, tipo, n_entradas);
+    if (quantis.quantidade > 0) {
+        resumo_quantis_elementos(&resumo, valores, tipo, n_entradas, &quantis);
     }
+    resumo_liberar(&resumo);
     
-    // Ordena o vetor
-    qsort(copia, N_ENTRADAS, sizeof(int), comparar);
-    
-    if (N_ENTRADAS % 2 == 0) {
-        // Par: média dos dois do meio
-        resultado_mediana = (copia[N_ENTRADAS/2] + copia[N_ENTRADAS/2 - 1]) / 2.0;
-    } else {
-        // Ímpar: elemento do meio
-        resultado_mediana = copia[N_ENTRADAS/2];
-    }
-    
-    free(copia);
-    pthread_exit(NULL);
+    rastro_terminar("mediana");
+    return NULL;
 }
 
 // Thread que calcula o desvio padrão
 void* thread_desvio(void *arg) {
-    // Calcula a média primeiro (precisa para o desvio)
-    long long soma = 0;
+    rastro_nomear("desvio");
+    rastro_comecar("desvio");
     
-    for (int i = 0; i < N_ENTRADAS; i++) {
-        soma += valores[i];
-    }
+    // Soma e soma dos quadrados na mesma passada (sem recalcular a média)
+    Resumo resumo;
+    resumo_iniciar(&resumo, DOMINIO_ILIMITADO);
+    resumo_acumular_elementos(&resumo, valores, tipo, n_entradas);
     
-    double media_local = (double)soma / N_ENTRADAS;
+    resultado_desvio = resumo_desvio_padrao(&resumo);
     
-    // Soma dos quadrados das diferenças
-    double soma_quadrados = 0.0;
+    rastro_terminar("desvio");
+    return NULL;
+}
+
+// Resumo parcial de uma thread no modo de paralelismo de dados.
+// O alinhamento à linha de cache impede que threads vizinhas
+// disputem a mesma linha ao atualizar seus acumuladores.
+typedef struct {
+    Resumo resumo;
+    size_t inicio;
+    size_t fim;
+} __attribute__((aligned(LINHA_CACHE))) ParcialThread;
+
+// Thread que resume um bloco do vetor
+void* thread_bloco(void *arg) {
+    ParcialThread *parcial = (ParcialThread*)arg;
+    rastro_nomear("bloco");
+    rastro_comecar("bloco");
     
-    for (int i = 0; i < N_ENTRADAS; i++) {
-        double diferenca = valores[i] - media_local;
-        soma_quadrados += diferenca * diferenca;
+    // O histograma é alocado e zerado pela própria thread
+    resumo_iniciar(&parcial->resumo, dominio);
+    if (quantis.quantidade > 0) {
+        resumo_ativar_esboco(&parcial->resumo, precisao_esboco);
     }
+    resumo_acumular_elementos(&parcial->resumo,
+                              (char*)valores + parcial->inicio * elemento_bytes(tipo), tipo,
+                              parcial->fim - parcial->inicio);
     
-    double variancia = soma_quadrados / N_ENTRADAS;
-    resultado_desvio = sqrt(variancia);
-    
-    pthread_exit(NULL);
+    rastro_terminar("bloco");
+    return NULL;
 }
 
-int main() {
-    // Inicializa gerador aleatório
-    srand(time(NULL));
-    
-    // Preenche o vetor com números aleatórios de 0 a 100
-    for (int i = 0; i < N_ENTRADAS; i++) {
-        valores[i] = rand() % (MAX_VALOR - MIN_VALOR + 1) + MIN_VALOR;
+// Executa a função em uma thread nova, na CPU do trabalhador, ou, se
+// houver pool, submete a ele
+int disparar(PoolThreads *pool, pthread_t *thread, FuncaoTarefa funcao, void *arg,
+             int trabalhador) {
+    if (pool != NULL) {
+        rastro_marcar("submetida", -1);
+        return pool_submeter(pool, funcao, arg);
     }
+    rastro_marcar("criada", -1);
     
-    printf("========================================\n");
-    printf("  EXECUÇÃO COM TRÊS THREADS\n");
-    printf("========================================\n\n");
-    
-    // Começa a medir o tempo total
-    struct timeval inicio_total, fim_total;
-    gettimeofday(&inicio_total, NULL);
-    
-    // Começa a medir o tempo de criação
-    struct timeval inicio_criacao, fim_criacao;
-    gettimeofday(&inicio_criacao, NULL);
+    pthread_attr_t atributos;
+    pthread_attr_init(&atributos);
+    afinidade_atributos(&afinidade, trabalhador, &atributos);
+    int ret = pthread_create(thread, &atributos, funcao, arg);
+    pthread_attr_destroy(&atributos);
+    return ret;
+}
+
+int comparar_latencias(const void *a, const void *b) {
+    double da = *((const double*)a);
+    double db = *((const double*)b);
+    return (da > db) - (da < db);
+}
+
+// Distribuição das latências das repetições (ordena o vetor); os
+// percentis são pelo posto mais próximo
+void exibir_latencias(double *latencias, int n) {
+    qsort(latencias, n, sizeof(double), comparar_latencias);
     
+    double mediana = (n % 2 == 0) ? (latencias[n/2 - 1] + latencias[n/2]) / 2.0 : latencias[n/2];
+    int posto_p99 = (99 * n + 99) / 100 - 1;
+    printf("Latência por execução: mín %.3f, mediana %.3f, p99 %.3f, máx %.3f ms\n",
+           latencias[0], mediana, latencias[posto_p99], latencias[n - 1]);
+}
+
+// Espera as n threads criadas ou, se houver pool, todas as tarefas
+void esperar(PoolThreads *pool, pthread_t *threads, int n) {
+    if (pool != NULL) {
+        pool_aguardar(pool);
+        rastro_marcar("aguardadas", n);
+        return;
+    }
+    for (int i = 0; i < n; i++) {
+        pthread_join(threads[i], NULL);
+        rastro_marcar("join", i);
+    }
+}
+
+// Uma thread (ou tarefa do pool) por estatística: média, mediana e desvio padrão
+int executar_tarefas(PoolThreads *pool, struct timespec *fim_criacao) {
     // IDs das threads
-    pthread_t thread1, thread2, thread3;
+    pthread_t threads[3];
     int ret1, ret2, ret3;
     
+    contadores_entrar("criacao");
+    
     // Cria thread da média
-    ret1 = pthread_create(&thread1, NULL, thread_media, NULL);
+    ret1 = disparar(pool, &threads[0], thread_media, NULL, 0);
     if (ret1 != 0) {
         fprintf(stderr, "Erro ao criar thread de média: %d\n", ret1);
-        return EXIT_FAILURE;
+        return -1;
     }
     
     // Cria thread da mediana
-    ret2 = pthread_create(&thread2, NULL, thread_mediana, NULL);
+    ret2 = disparar(pool, &threads[1], thread_mediana, NULL, 1);
     if (ret2 != 0) {
         fprintf(stderr, "Erro ao criar thread de mediana: %d\n", ret2);
-        return EXIT_FAILURE;
+        return -1;
     }
     
     // Cria thread do desvio padrão
-    ret3 = pthread_create(&thread3, NULL, thread_desvio, NULL);
+    ret3 = disparar(pool, &threads[2], thread_desvio, NULL, 2);
     if (ret3 != 0) {
         fprintf(stderr, "Erro ao criar thread de desvio padrão: %d\n", ret3);
-        return EXIT_FAILURE;
+        return -1;
     }
     
     // Para de medir o tempo de criação
-    gettimeofday(&fim_criacao, NULL);
+    marcar_instante(fim_criacao);
+    contadores_entrar("calculo");
     
     // Espera todas as threads terminarem
-    pthread_join(thread1, NULL);
-    pthread_join(thread2, NULL);
-    pthread_join(thread3, NULL);
+    esperar(pool, threads, 3);
+    contadores_sair();
     
-    // Para de medir o tempo total
-    gettimeofday(&fim_total, NULL);
+    return 0;
+}
+
+// Divide o vetor em n_threads blocos e combina os resumos parciais
+int executar_paralelismo_dados(PoolThreads *pool, int n_threads, struct timespec *fim_criacao) {
+    pthread_t *threads = (pthread_t*)malloc(n_threads * sizeof(pthread_t));
+    ParcialThread *parciais = (ParcialThread*)aligned_alloc(LINHA_CACHE,
+                                  n_threads * sizeof(ParcialThread));
+    if (threads == NULL || parciais == NULL) {
+        fprintf(stderr, "Erro ao alocar memória para as threads\n");
+        return -1;
+    }
+    
+    // Cria uma thread por bloco; os blocos diferem em no máximo um valor
+    contadores_entrar("criacao");
+    int criadas = 0;
+    for (int t = 0; t < n_threads; t++) {
+        parciais[t].inicio = (size_t)n_entradas * t / n_threads;
+        parciais[t].fim = (size_t)n_entradas * (t + 1) / n_threads;
+    
+        int ret = disparar(pool, &threads[t], thread_bloco, &parciais[t], t);
+        if (ret != 0) {
+            fprintf(stderr, "Erro ao criar thread do bloco %d: %d\n", t, ret);
+            break;
+        }
+        criadas++;
+    }
     
-    // Calcula tempo de criação (ms)
-    long segundos_criacao = fim_criacao.tv_sec - inicio_criacao.tv_sec;
-    long microsegundos_criacao = fim_criacao.tv_usec - inicio_criacao.tv_usec;
-    double tempo_criacao = (segundos_criacao * 1000.0) + (microsegundos_criacao / 1000.0);
+    // Para de medir o tempo de criação
+    marcar_instante(fim_criacao);
+    contadores_entrar("calculo");
+    
+    // Espera todas as threads terminarem
+    esperar(pool, threads, criadas);
+    contadores_entrar("reducao");
+    
+    if (criadas < n_threads) {
+        for (int t = 0; t < criadas; t++) {
+            resumo_liberar(&parciais[t].resumo);
+        }
+        free(parciais);
+        free(threads);
+        return -1;
+    }
+    
+    // Redução: combina os resumos parciais no da primeira thread
+    Resumo *total = &parciais[0].resumo;
+    for (int t = 1; t < n_threads; t++) {
+        resumo_combinar(total, &parciais[t].resumo);
+        resumo_liberar(&parciais[t].resumo);
+    }
+    
+    resultado_media = resumo_media(total);
+    if (total->histograma != NULL || tipo != ELEMENTO_INT32) {
+        // Com tipo estreito, sem histograma do domínio, conta o do tipo inteiro
+        resultado_mediana = resumo_mediana_elementos(total, valores, tipo, n_entradas);
+    } else {
+        // Sem histograma: seleção radix dividida entre as mesmas threads
+        resultado_mediana = mediana_paralela(valores, n_entradas, n_threads);
+    }
+    resultado_desvio = resumo_desvio_padrao(total);
+    
+    // Quantis pelo histograma ou pelos esboços combinados
+    if (quantis.quantidade > 0) {
+        resumo_quantis(total, NULL, 0, &quantis);
+    }
+    
+    resumo_liberar(total);
+    contadores_sair();
+    free(parciais);
+    free(threads);
+    return 0;
+}
+
+int main(int argc, char *argv[]) {
+    int paralelismo_dados = 0;
+    int usar_pool = 0;
+    int n_threads = 0;
+    int repeticoes = 1;
+    int opcoes_vetor = 0;
+    const char *arquivo = NULL;
+    uint64_t semente = gerador_semente_padrao();
+    int dominio_informado = 0;
+    int armazenamento_largo = 0;
+    
+    // Lê as opções da linha de comando
+    int opcao;
+    while ((opcao = getopt(argc, argv, "n:v:Hf:S:dpt:r:q:K:wA:")) != -1) {
+        switch (opcao) {
+            case 'n':
+                n_entradas = strtoull(optarg, NULL, 10);
+                break;
+            case 'v':
+                if (dominio_ler(optarg, &dominio) != 0) {
+                    fprintf(stderr, "Intervalo inválido: %s (use min:max)\n", optarg);
+                    return EXIT_FAILURE;
+                }
+                dominio_informado = 1;
+                break;
+            case 'H':
+                opcoes_vetor |= VETOR_PAGINAS_ENORMES;
+                break;
+            case 'f':
+                arquivo = optarg;
+                break;
+            case 'S':
+                semente = strtoull(optarg, NULL, 10);
+                break;
+            case 'd':
+                paralelismo_dados = 1;
+                break;
+            case 'p':
+                usar_pool = 1;
+                break;
+            case 't':
+                n_threads = atoi(optarg);
+                break;
+            case 'r':
+                repeticoes = atoi(optarg);
+                break;
+            case 'q':
+                if (quantis_ler(optarg, &quantis) != 0) {
+                    fprintf(stderr, "Lista de quantis inválida: %s (ex.: 0.5,0.9,0.99)\n", optarg);
+                    return EXIT_FAILURE;
+                }
+                break;
+            case 'K':
+                precisao_esboco = atoi(optarg);
+                break;
+            case 'w':
+                armazenamento_largo = 1;
+                break;
+            case 'A':
+                if (afinidade_ler(optarg, &afinidade) != 0) {
+                    fprintf(stderr, "Afinidade inválida: %s (compacto, espalhado ou lista, ex.: 0,2,4-7)\n", optarg);
+                    return EXIT_FAILURE;
+                }
+                break;
+            default:
+                fprintf(stderr, "Uso: %s [-n quantidade] [-v min:max] [-H] [-f arquivo.bin] [-S semente] [-d] [-p] [-t threads] [-r repetições] [-q quantis] [-K precisão] [-w] [-A afinidade]\n", argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+    
+    // Contadores e rastro por fase, se pedidos pelo ambiente
+    // (ESTATISTICAS_CONTADORES e ESTATISTICAS_RASTRO)
+    contadores_abrir();
+    rastro_iniciar();
+    rastro_nomear("principal");
+    
+    // Conjunto preparado com o converter: mapeado sem conversão nem cópia.
+    // Sem -v, o intervalo gravado no cabeçalho define o histograma.
+    Vetor vetor;
+    if (arquivo != NULL) {
+        if (dados_mapear(&vetor, arquivo, dominio_informado ? NULL : &dominio) != 0) {
+            return EXIT_FAILURE;
+        }
+        n_entradas = vetor.tamanho;
+    }
+    
+    if (n_entradas == 0) {
+        fprintf(stderr, "Quantidade de valores inválida\n");
+        return EXIT_FAILURE;
+    }
+    
+    // Aloca memória para o vetor (mmap quando grande), no menor tipo do intervalo
+    tipo = armazenamento_largo ? ELEMENTO_INT32 : dominio_tipo_elemento(dominio);
+    if (arquivo == NULL && vetor_alocar(&vetor, n_entradas, tipo, opcoes_vetor) != 0) {
+        return EXIT_FAILURE;
+    }
+    valores = vetor.valores;
+    tipo = vetor.tipo;
+    
+    // Padrão do modo de dados: uma thread por núcleo disponível
+    if (n_threads <= 0) {
+        long nucleos = sysconf(_SC_NPROCESSORS_ONLN);
+        n_threads = nucleos > 0 ? (int)nucleos : 1;
+    }
+    if ((size_t)n_threads > n_entradas) {
+        n_threads = (int)n_entradas;
+    }
+    if (repeticoes < 1) {
+        repeticoes = 1;
+    }
+    if (precisao_esboco < 8) {
+        fprintf(stderr, "Precisão do esboço inválida: %d (mínimo 8)\n", precisao_esboco);
+        return EXIT_FAILURE;
+    }
+    
+    // Sem arquivo: gera os valores
+    if (arquivo == NULL) {
+        // Preenche em paralelo com valores do intervalo [min, max] (sem viés).
+        // Com afinidade no modo -d, o trecho t é tocado na CPU da thread t.
+        contadores_entrar("geracao");
+        int primeiro_toque = paralelismo_dados && afinidade.n_cpus > 0;
+        if (gerador_preencher(valores, tipo, n_entradas, dominio, semente,
+                              primeiro_toque ? n_threads : 0,
+                              primeiro_toque ? &afinidade : NULL) != 0) {
+            return EXIT_FAILURE;
+        }
+        contadores_sair();
+    }
+    
+    // Modo de latência (ESTATISTICAS_LATENCIA): memória travada antes de
+    // criar as threads; só o modo de tarefas copia o vetor na mediana
+    latencia_iniciar(valores, n_entradas * elemento_bytes(tipo),
+                     !paralelismo_dados && tipo == ELEMENTO_INT32 && !dominio_limitado(dominio)
+                         ? n_entradas : 0);
+    
+    printf("========================================\n");
+    if (paralelismo_dados) {
+        printf("  EXECUÇÃO COM %d THREADS (DADOS)\n", n_threads);
+    } else {
+        printf("  EXECUÇÃO COM TRÊS THREADS\n");
+    }
+    if (usar_pool) {
+        printf("  (pool de threads, %d repetições)\n", repeticoes);
+    }
+    printf("========================================\n\n");
+    printf("Armazenamento: %s, %zu B por valor\n", elemento_nome(tipo), elemento_bytes(tipo));
+    afinidade_exibir(&afinidade);
+    latencia_exibir();
+    printf("\n");
+    
+    // Começa a medir o tempo total
+    struct timespec inicio_total, fim_total;
+    marcar_instante(&inicio_total);
+    
+    // Prepara o pool uma única vez (fora da latência de cada execução)
+    PoolThreads *pool = NULL;
+    double tempo_preparacao = 0.0;
+    if (usar_pool) {
+        struct timespec inicio_preparacao, fim_preparacao;
+        marcar_instante(&inicio_preparacao);
+        contadores_entrar("preparacao");
+    
+        pool = pool_criar(paralelismo_dados ? n_threads : 3, &afinidade);
+        if (pool == NULL) {
+            return EXIT_FAILURE;
+        }
+        contadores_sair();
+    
+        marcar_instante(&fim_preparacao);
+        tempo_preparacao = diferenca_ms(inicio_preparacao, fim_preparacao);
+    }
+    
+    // Repete o cálculo; cada repetição é uma execução independente
+    double tempo_criacao = 0.0;
+    double tempo_execucoes = 0.0;
+    double *latencias = (double*)malloc(repeticoes * sizeof(double));
+    if (latencias == NULL) {
+        fprintf(stderr, "Erro ao alocar memória para as latências\n");
+        return EXIT_FAILURE;
+    }
+    for (int r = 0; r < repeticoes; r++) {
+        // Começa a medir o tempo de criação
+        struct timespec inicio_criacao, fim_criacao, fim_execucao;
+        marcar_instante(&inicio_criacao);
+    
+        int status;
+        if (paralelismo_dados) {
+            status = executar_paralelismo_dados(pool, n_threads, &fim_criacao);
+        } else {
+            status = executar_tarefas(pool, &fim_criacao);
+        }
+        if (status != 0) {
+            return EXIT_FAILURE;
+        }
+    
+        marcar_instante(&fim_execucao);
+        tempo_criacao += diferenca_ms(inicio_criacao, fim_criacao);
+        latencias[r] = diferenca_ms(inicio_criacao, fim_execucao);
+        tempo_execucoes += latencias[r];
+    }
+    
+    if (pool != NULL) {
+        contadores_entrar("encerramento");
+        pool_destruir(pool);
+        contadores_sair();
+    }
+    
+    // Para de medir o tempo total
+    marcar_instante(&fim_total);
     
     // Calcula tempo total (ms)
-    long segundos_total = fim_total.tv_sec - inicio_total.tv_sec;
-    long microsegundos_total = fim_total.tv_usec - inicio_total.tv_usec;
-    double tempo_total = (segundos_total * 1000.0) + (microsegundos_total / 1000.0);
+    double tempo_total = diferenca_ms(inicio_total, fim_total);
     
     // Exibe resultados estatísticos
     printf("--- RESULTADOS ESTATÍSTICOS ---\n");
-    printf("Quantidade de valores processados: %d\n", N_ENTRADAS);
+    printf("Quantidade de valores processados: %zu\n", n_entradas);
+    if (arquivo == NULL) {
+        printf("Semente do gerador: %llu\n", (unsigned long long)semente);
+    }
     printf("Média aritmética: %.6f\n", resultado_media);
     printf("Mediana: %.6f\n", resultado_mediana);
-    printf("Desvio padrão populacional: %.6f\n\n", resultado_desvio);
+    printf("Desvio padrão populacional: %.6f\n", resultado_desvio);
+    quantis_exibir(&quantis);
+    printf("\n");
     
     // Exibe métricas de tempo
     printf("--- MÉTRICAS DE TEMPO ---\n");
     printf("Tempo total de execução: %.3f ms\n", tempo_total);
-    printf("Tempo de criação das threads: %.3f ms\n", tempo_criacao);
+    if (usar_pool) {
+        printf("Tempo de preparação do pool: %.3f ms\n", tempo_preparacao);
+        printf("Tempo de submissão das tarefas (média): %.3f ms\n", tempo_criacao / repeticoes);
+    } else {
+        printf("Tempo de criação das threads%s: %.3f ms\n",
+               repeticoes > 1 ? " (média)" : "", tempo_criacao / repeticoes);
+    }
+    if (repeticoes > 1 || usar_pool) {
+        printf("Latência por execução (média): %.3f ms\n", tempo_execucoes / repeticoes);
+    }
+    if (repeticoes > 1) {
+        exibir_latencias(latencias, repeticoes);
+    }
+    free(latencias);
+    contadores_exibir();
+    contadores_fechar();
+    
+    // Libera memória alocada
+    vetor_liberar(&vetor);
     
     printf("\n========================================\n");
     printf("  Execução finalizada com sucesso\n");
@@ -195,4 +597,3 @@ int main() {
     
     return EXIT_SUCCESS;
 }
-
@@ -0,0 +1,75 @@
+/*
+ * Instituição: Universidade Federal da Paraíba
+ * Disciplina: Sistemas Operacionais I
+ * Unidade 1 - Atividade 2
+ *
+ * Autor: Rodrigo Monteiro Fortes de Oliveira, 20240097664
+ *
+ * Nome do Módulo: vetor.c
+ *
+ * Descrição:
+ *     Implementação das rotinas declaradas em vetor.h.
+ */
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include "vetor.h"
+
+// Tamanho de uma página enorme (2 MiB em x86-64)
+#define PAGINA_ENORME (2UL << 20)
+
+int vetor_alocar(Vetor *vetor, size_t tamanho, TipoElemento tipo, int opcoes) {
+    size_t bytes = tamanho * elemento_bytes(tipo);
+    
+    vetor->tamanho = tamanho;
+    vetor->tipo = tipo;
+    vetor->bytes_mapeados = 0;
+    vetor->deslocamento = 0;
+    
+    // Vetor pequeno e privado: malloc basta
+    if (bytes < VETOR_LIMITE_MMAP && !(opcoes & VETOR_COMPARTILHADO)) {
+        vetor->valores = malloc(bytes > 0 ? bytes : sizeof(int));
+        if (vetor->valores == NULL) {
+            fprintf(stderr, "Erro ao alocar memória para o vetor\n");
+            return -1;
+        }
+        return 0;
+    }
+    
+    // Arredonda para páginas enormes inteiras, para que o THP cubra o fim
+    if (opcoes & VETOR_PAGINAS_ENORMES) {
+        bytes = (bytes + PAGINA_ENORME - 1) / PAGINA_ENORME * PAGINA_ENORME;
+    }
+    
+    int compartilhamento = (opcoes & VETOR_COMPARTILHADO) ? MAP_SHARED : MAP_PRIVATE;
+    void *endereco = mmap(NULL, bytes, PROT_READ | PROT_WRITE,
+                          compartilhamento | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (endereco == MAP_FAILED) {
+        perror("Erro ao mapear memória para o vetor");
+        return -1;
+    }
+    
+    // Apenas um pedido: o núcleo pode recusar sem que isso seja erro
+    if ((opcoes & VETOR_PAGINAS_ENORMES) && madvise(endereco, bytes, MADV_HUGEPAGE) == -1) {
+        perror("Aviso: páginas enormes indisponíveis");
+    }
+    
+    vetor->valores = endereco;
+    vetor->bytes_mapeados = bytes;
+    return 0;
+}
+
+void vetor_liberar(Vetor *vetor) {
+    if (vetor->bytes_mapeados > 0) {
+        munmap((char*)vetor->valores - vetor->deslocamento, vetor->bytes_mapeados);
+    } else {
+        free(vetor->valores);
+    }
+    vetor->valores = NULL;
+    vetor->tamanho = 0;
+    vetor->bytes_mapeados = 0;
+    vetor->deslocamento = 0;
+    vetor->tipo = ELEMENTO_INT32;
+}
@@ -0,0 +1,49 @@
+/*
+ * Instituição: Universidade Federal da Paraíba
+ * Disciplina: Sistemas Operacionais I
+ * Unidade 1 - Atividade 2
+ *
+ * Autor: Rodrigo Monteiro Fortes de Oliveira, 20240097664
+ *
+ * Nome do Módulo: vetor.h
+ *
+ * Descrição:
+ *     Alocação do vetor de valores com tamanho definido em tempo de
+ *     execução. Vetores pequenos usam malloc; a partir de
+ *     VETOR_LIMITE_MMAP bytes a memória vem de mmap anônimo, sem
+ *     reserva antecipada de swap, e pode pedir páginas enormes
+ *     transparentes (THP) para reduzir faltas de página e pressão na TLB.
+ *
+ *     Os valores são guardados no tipo escolhido pelo chamador
+ *     (normalmente dominio_tipo_elemento): com o domínio padrão, 0 a
+ *     100, um byte por valor em vez de quatro.
+ */
+
+#ifndef VETOR_H
+#define VETOR_H
+
+#include <stddef.h>
+#include "estatisticas.h"
+
+// A partir deste tamanho (em bytes) o vetor é alocado com mmap
+#define VETOR_LIMITE_MMAP (1 << 20)
+
+// Opções de alocação (podem ser combinadas com |)
+#define VETOR_PAGINAS_ENORMES 0x1   // madvise(MADV_HUGEPAGE)
+#define VETOR_COMPARTILHADO   0x2   // MAP_SHARED: visível aos filhos após fork
+
+typedef struct {
+    void *valores;           // 'tamanho' elementos do tipo 'tipo'
+    size_t tamanho;
+    size_t bytes_mapeados;   // 0 quando alocado com malloc
+    size_t deslocamento;     // bytes antes de 'valores' no mapeamento (arquivo de dados)
+    TipoElemento tipo;
+} Vetor;
+
+// Aloca espaço para 'tamanho' valores do tipo; retorna 0 em caso de sucesso
+int vetor_alocar(Vetor *vetor, size_t tamanho, TipoElemento tipo, int opcoes);
+
+// Libera o vetor (munmap ou free, conforme a alocação)
+void vetor_liberar(Vetor *vetor);
+
+#endif